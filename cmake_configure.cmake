@@ -77,6 +77,7 @@ target_compile_definitions(rw_interface
         "GLM_ENABLE_EXPERIMENTAL"
         "$<$<BOOL:${RW_VERBOSE_DEBUG_MESSAGES}>:RW_VERBOSE_DEBUG_MESSAGES>"
         "$<$<BOOL:${ENABLE_PROFILING}>:RW_PROFILER>"
+        "RW_LOG_MIN_SEVERITY=${RW_LOG_MIN_SEVERITY}"
     )
 
 if(CMAKE_SYSTEM_NAME STREQUAL "Linux")
@@ -12,6 +12,9 @@ option(TEST_DATA "Enable tests that require game data")
 set(FAILED_CHECK_ACTION "IGNORE" CACHE STRING "What action to perform on a failed RW_CHECK (in debug mode)")
 set_property(CACHE FAILED_CHECK_ACTION PROPERTY STRINGS "IGNORE" "ABORT" "BREAKPOINT")
 
+set(RW_LOG_MIN_SEVERITY "0" CACHE STRING "Least severe log messages to compile in (0 = verbose, 3 = errors only)")
+set_property(CACHE RW_LOG_MIN_SEVERITY PROPERTY STRINGS "0" "1" "2" "3")
+
 set(FILESYSTEM_LIBRARY "BOOST" CACHE STRING "Which filesystem library to use")
 set_property(CACHE FILESYSTEM_LIBRARY PROPERTY STRINGS "CXX17" "CXXTS" "BOOST")
 
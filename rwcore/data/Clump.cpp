@@ -14,6 +14,9 @@ Geometry::~Geometry() {
     if (EBO) {
         glDeleteBuffers(1, &EBO);
     }
+    if (arena.arena) {
+        arena.arena->free(arena);
+    }
 }
 
 ModelFrame::ModelFrame(unsigned int index, glm::mat3 dR, glm::vec3 dT)
@@ -27,19 +30,27 @@ ModelFrame::ModelFrame(unsigned int index, glm::mat3 dR, glm::vec3 dT)
 void ModelFrame::reset() {
     matrix = glm::translate(glm::mat4(1.0f), defaultTranslation) *
              glm::mat4(defaultRotation);
-    updateHierarchyTransform();
+    invalidateWorldTransform();
+}
+
+void ModelFrame::invalidateWorldTransform() {
+    if (worldDirty_) {
+        return;
+    }
+    worldDirty_ = true;
+    for (const auto& child : children_) {
+        child->invalidateWorldTransform();
+    }
 }
 
-void ModelFrame::updateHierarchyTransform() {
-    // Update our own transformation
+void ModelFrame::updateWorldTransform() const {
+    // Parents are cleaned first, so a clean frame never has a dirty parent
     if (parent_) {
         worldtransform_ = parent_->getWorldTransform() * matrix;
     } else {
         worldtransform_ = matrix;
     }
-    for (const auto& child : children_) {
-        child->updateHierarchyTransform();
-    }
+    worldDirty_ = false;
 }
 
 void ModelFrame::addChild(const ModelFramePtr& child) {
@@ -52,7 +63,7 @@ void ModelFrame::addChild(const ModelFramePtr& child) {
     }
     child->parent_ = this;
     children_.push_back(child);
-    child->updateHierarchyTransform();
+    child->invalidateWorldTransform();
 }
 
 ModelFrame* ModelFrame::findDescendant(const std::string& name) const {
@@ -7,6 +7,7 @@
 #include <vector>
 
 #include <gl/DrawBuffer.hpp>
+#include <gl/GeometryArena.hpp>
 #include <gl/GeometryBuffer.hpp>
 #include <gl/TextureData.hpp>
 #include <loaders/RWBinaryStream.hpp>
@@ -21,7 +22,9 @@ class ModelFrame {
     glm::mat3 defaultRotation;
     glm::vec3 defaultTranslation;
     glm::mat4 matrix{1.0f};
-    glm::mat4 worldtransform_{1.0f};
+    mutable glm::mat4 worldtransform_{1.0f};
+    /// World transform needs to be recomputed before it is read
+    mutable bool worldDirty_ = true;
     ModelFrame* parent_;
     std::string name;
     std::vector<ModelFramePtr> children_;
@@ -34,7 +37,7 @@ public:
 
     void setTransform(const glm::mat4& m) {
         matrix = m;
-        updateHierarchyTransform();
+        invalidateWorldTransform();
     }
 
     const glm::mat4& getTransform() const {
@@ -59,25 +62,32 @@ public:
 
     void setTranslation(const glm::vec3& t) {
         matrix[3] = glm::vec4(t, matrix[3][3]);
-        updateHierarchyTransform();
+        invalidateWorldTransform();
     }
 
     void setRotation(const glm::mat3& r) {
         for (unsigned int i = 0; i < 3; i++) {
             matrix[i] = glm::vec4(r[i], matrix[i][3]);
         }
-        updateHierarchyTransform();
+        invalidateWorldTransform();
     }
 
     /**
-     * Updates the cached matrix
+     * Marks the cached world matrix of this frame and its descendants as
+     * out of date. They are recomputed the next time they are read.
      */
-    void updateHierarchyTransform();
+    void updateHierarchyTransform() {
+        invalidateWorldTransform();
+    }
 
     /**
-     * @return the cached world transformation for this Frame
+     * @return the world transformation for this Frame, recomputing it if
+     * this frame or one of its parents has moved since it was last read
      */
     const glm::mat4& getWorldTransform() const {
+        if (worldDirty_) {
+            updateWorldTransform();
+        }
         return worldtransform_;
     }
 
@@ -98,6 +108,15 @@ public:
     ModelFrame* findDescendant(const std::string& name) const;
 
     ModelFramePtr cloneHierarchy() const;
+
+private:
+    /**
+     * Flags this frame and its descendants as dirty. Stops at frames that
+     * are already dirty, as their descendants must be dirty too.
+     */
+    void invalidateWorldTransform();
+
+    void updateWorldTransform() const;
 };
 
 /**
@@ -105,6 +124,7 @@ public:
  */
 
 struct SubGeometry {
+    /// First index in the geometry's index buffer, or in its arena
     size_t start = 0;
     size_t material = 0;
     std::vector<uint32_t> indices;
@@ -172,6 +192,14 @@ struct Geometry {
 
     GLuint EBO;
 
+    /// Shared arena storage, used instead of the buffers above if set
+    ArenaAllocation arena;
+
+    DrawBuffer* getDrawBuffer() {
+        return arena.arena ? arena.arena->getDrawBuffer(dbuff.getFaceType())
+                           : &dbuff;
+    }
+
     RW::BSGeometryBounds geometryBounds;
 
     uint32_t clumpNum;
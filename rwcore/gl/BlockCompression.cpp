@@ -0,0 +1,423 @@
+#include "gl/BlockCompression.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <limits>
+
+namespace BlockCompression {
+
+namespace {
+constexpr int kBlockSize = 4;
+constexpr int kBlockPixels = kBlockSize * kBlockSize;
+
+/// Power iterations used to find the main axis of a block's colours
+constexpr int kAxisIterations = 8;
+
+using Colour = std::array<float, 3>;
+using Block = std::array<std::array<std::uint8_t, 4>, kBlockPixels>;
+
+size_t blockBytes(Format format) {
+    return format == Format::BC1 ? 8 : 16;
+}
+
+int blockCount(int size) {
+    return (size + kBlockSize - 1) / kBlockSize;
+}
+
+Block readBlock(const std::uint8_t* rgba, int width, int height, int bx,
+                int by) {
+    Block block;
+    for (int y = 0; y < kBlockSize; ++y) {
+        const int sy = std::min(by * kBlockSize + y, height - 1);
+        for (int x = 0; x < kBlockSize; ++x) {
+            const int sx = std::min(bx * kBlockSize + x, width - 1);
+            const auto src = rgba + (static_cast<size_t>(sy) * width + sx) * 4;
+            std::copy(src, src + 4, block[y * kBlockSize + x].begin());
+        }
+    }
+    return block;
+}
+
+void writeBlock(const Block& block, std::uint8_t* rgba, int width, int height,
+                int bx, int by) {
+    for (int y = 0; y < kBlockSize; ++y) {
+        const int dy = by * kBlockSize + y;
+        for (int x = 0; x < kBlockSize; ++x) {
+            const int dx = bx * kBlockSize + x;
+            if (dx < width && dy < height) {
+                const auto& p = block[y * kBlockSize + x];
+                std::copy(p.begin(), p.end(),
+                          rgba + (static_cast<size_t>(dy) * width + dx) * 4);
+            }
+        }
+    }
+}
+
+void write16(std::uint8_t* out, std::uint16_t v) {
+    out[0] = static_cast<std::uint8_t>(v & 0xFF);
+    out[1] = static_cast<std::uint8_t>(v >> 8);
+}
+
+std::uint16_t read16(const std::uint8_t* in) {
+    return static_cast<std::uint16_t>(in[0] | (in[1] << 8));
+}
+
+std::uint16_t toRGB565(const Colour& c) {
+    const auto quantize = [](float v, int bits) {
+        const int max = (1 << bits) - 1;
+        const auto q = static_cast<int>(std::lround(v / 255.f * max));
+        return std::clamp(q, 0, max);
+    };
+    return static_cast<std::uint16_t>((quantize(c[0], 5) << 11) |
+                                      (quantize(c[1], 6) << 5) |
+                                      quantize(c[2], 5));
+}
+
+std::array<std::uint8_t, 3> fromRGB565(std::uint16_t v) {
+    const int r = (v >> 11) & 0x1F;
+    const int g = (v >> 5) & 0x3F;
+    const int b = v & 0x1F;
+    return {{static_cast<std::uint8_t>((r << 3) | (r >> 2)),
+             static_cast<std::uint8_t>((g << 2) | (g >> 4)),
+             static_cast<std::uint8_t>((b << 3) | (b >> 2))}};
+}
+
+/// The four colours of a block, the last one is transparent black if the
+/// block uses the three colour mode
+std::array<std::array<std::uint8_t, 4>, 4> colourPalette(std::uint16_t c0,
+                                                         std::uint16_t c1,
+                                                         bool allowAlpha) {
+    const auto a = fromRGB565(c0);
+    const auto b = fromRGB565(c1);
+    std::array<std::array<std::uint8_t, 4>, 4> palette;
+    for (size_t i = 0; i < 3; ++i) {
+        palette[0][i] = a[i];
+        palette[1][i] = b[i];
+        if (c0 > c1 || !allowAlpha) {
+            palette[2][i] = static_cast<std::uint8_t>((2 * a[i] + b[i]) / 3);
+            palette[3][i] = static_cast<std::uint8_t>((a[i] + 2 * b[i]) / 3);
+        } else {
+            palette[2][i] = static_cast<std::uint8_t>((a[i] + b[i]) / 2);
+            palette[3][i] = 0;
+        }
+    }
+    palette[0][3] = palette[1][3] = palette[2][3] = 255;
+    palette[3][3] = (c0 > c1 || !allowAlpha) ? 255 : 0;
+    return palette;
+}
+
+int distance2(const std::array<std::uint8_t, 4>& a,
+              const std::array<std::uint8_t, 4>& b) {
+    int d = 0;
+    for (size_t i = 0; i < 3; ++i) {
+        const int diff = a[i] - b[i];
+        d += diff * diff;
+    }
+    return d;
+}
+
+/// Picks the closest palette entry for every pixel
+std::uint32_t colourIndices(const Block& block, std::uint16_t c0,
+                            std::uint16_t c1, int& error) {
+    const auto palette = colourPalette(c0, c1, false);
+    std::uint32_t indices = 0;
+    error = 0;
+    for (int i = 0; i < kBlockPixels; ++i) {
+        int best = 0;
+        int bestDistance = std::numeric_limits<int>::max();
+        for (int p = 0; p < 4; ++p) {
+            const auto d = distance2(block[i], palette[p]);
+            if (d < bestDistance) {
+                bestDistance = d;
+                best = p;
+            }
+        }
+        error += bestDistance;
+        indices |= static_cast<std::uint32_t>(best) << (i * 2);
+    }
+    return indices;
+}
+
+/// Endpoints along the main axis of the colours
+void principalEndpoints(const Block& block, Colour& start, Colour& end) {
+    Colour mean{};
+    for (const auto& p : block) {
+        for (size_t i = 0; i < 3; ++i) {
+            mean[i] += p[i];
+        }
+    }
+    for (auto& m : mean) {
+        m /= kBlockPixels;
+    }
+
+    std::array<float, 6> cov{};
+    for (const auto& p : block) {
+        const float r = p[0] - mean[0];
+        const float g = p[1] - mean[1];
+        const float b = p[2] - mean[2];
+        cov[0] += r * r;
+        cov[1] += r * g;
+        cov[2] += r * b;
+        cov[3] += g * g;
+        cov[4] += g * b;
+        cov[5] += b * b;
+    }
+
+    Colour axis{1.f, 1.f, 1.f};
+    for (int i = 0; i < kAxisIterations; ++i) {
+        const Colour next{cov[0] * axis[0] + cov[1] * axis[1] + cov[2] * axis[2],
+                          cov[1] * axis[0] + cov[3] * axis[1] + cov[4] * axis[2],
+                          cov[2] * axis[0] + cov[4] * axis[1] + cov[5] * axis[2]};
+        const float length = std::sqrt(next[0] * next[0] + next[1] * next[1] +
+                                       next[2] * next[2]);
+        if (length < 1e-6f) {
+            break;
+        }
+        axis = {next[0] / length, next[1] / length, next[2] / length};
+    }
+
+    float minProjection = std::numeric_limits<float>::max();
+    float maxProjection = std::numeric_limits<float>::lowest();
+    for (const auto& p : block) {
+        const float t = (p[0] - mean[0]) * axis[0] +
+                        (p[1] - mean[1]) * axis[1] +
+                        (p[2] - mean[2]) * axis[2];
+        minProjection = std::min(minProjection, t);
+        maxProjection = std::max(maxProjection, t);
+    }
+    for (size_t i = 0; i < 3; ++i) {
+        start[i] = mean[i] + axis[i] * maxProjection;
+        end[i] = mean[i] + axis[i] * minProjection;
+    }
+}
+
+/// Moves the endpoints to best fit the colours, given their indices
+bool refineEndpoints(const Block& block, std::uint32_t indices, Colour& start,
+                     Colour& end) {
+    constexpr std::array<float, 4> kWeights{{0.f, 1.f, 1.f / 3.f, 2.f / 3.f}};
+    float aa = 0.f, bb = 0.f, ab = 0.f;
+    Colour ax{}, bx{};
+    for (int i = 0; i < kBlockPixels; ++i) {
+        const float t = kWeights[(indices >> (i * 2)) & 3];
+        const float s = 1.f - t;
+        aa += s * s;
+        bb += t * t;
+        ab += s * t;
+        for (size_t c = 0; c < 3; ++c) {
+            ax[c] += s * block[i][c];
+            bx[c] += t * block[i][c];
+        }
+    }
+    const float det = aa * bb - ab * ab;
+    if (std::abs(det) < 1e-6f) {
+        return false;
+    }
+    for (size_t c = 0; c < 3; ++c) {
+        start[c] = std::clamp((ax[c] * bb - bx[c] * ab) / det, 0.f, 255.f);
+        end[c] = std::clamp((bx[c] * aa - ax[c] * ab) / det, 0.f, 255.f);
+    }
+    return true;
+}
+
+void encodeColour(const Block& block, std::uint8_t* out) {
+    Colour start, end;
+    principalEndpoints(block, start, end);
+
+    auto c0 = toRGB565(start);
+    auto c1 = toRGB565(end);
+    int error = 0;
+    auto indices = colourIndices(block, c0, c1, error);
+
+    if (refineEndpoints(block, indices, start, end)) {
+        const auto r0 = toRGB565(start);
+        const auto r1 = toRGB565(end);
+        int refinedError = 0;
+        const auto refined = colourIndices(block, r0, r1, refinedError);
+        if (refinedError < error) {
+            c0 = r0;
+            c1 = r1;
+            indices = refined;
+        }
+    }
+
+    // The four colour mode needs the first endpoint to be larger
+    if (c0 < c1) {
+        std::swap(c0, c1);
+        indices ^= 0x55555555;
+    } else if (c0 == c1) {
+        indices = 0;
+    }
+
+    write16(out, c0);
+    write16(out + 2, c1);
+    for (int i = 0; i < 4; ++i) {
+        out[4 + i] = static_cast<std::uint8_t>((indices >> (i * 8)) & 0xFF);
+    }
+}
+
+void decodeColour(const std::uint8_t* in, Block& block, bool allowAlpha) {
+    const auto palette = colourPalette(read16(in), read16(in + 2), allowAlpha);
+    for (int i = 0; i < kBlockPixels; ++i) {
+        const auto index = (in[4 + i / 4] >> ((i % 4) * 2)) & 3;
+        block[i] = palette[index];
+    }
+}
+
+std::array<std::uint8_t, 8> alphaPalette(std::uint8_t a0, std::uint8_t a1) {
+    std::array<std::uint8_t, 8> palette{{a0, a1}};
+    if (a0 > a1) {
+        for (int i = 1; i < 7; ++i) {
+            palette[i + 1] =
+                static_cast<std::uint8_t>(((7 - i) * a0 + i * a1) / 7);
+        }
+    } else {
+        for (int i = 1; i < 5; ++i) {
+            palette[i + 1] =
+                static_cast<std::uint8_t>(((5 - i) * a0 + i * a1) / 5);
+        }
+        palette[6] = 0;
+        palette[7] = 255;
+    }
+    return palette;
+}
+
+void encodeAlpha(const Block& block, std::uint8_t* out) {
+    std::uint8_t a0 = 0;
+    std::uint8_t a1 = 255;
+    for (const auto& p : block) {
+        a0 = std::max(a0, p[3]);
+        a1 = std::min(a1, p[3]);
+    }
+    out[0] = a0;
+    out[1] = a1;
+
+    std::uint64_t indices = 0;
+    if (a0 != a1) {
+        const auto palette = alphaPalette(a0, a1);
+        for (int i = 0; i < kBlockPixels; ++i) {
+            int best = 0;
+            int bestDistance = std::numeric_limits<int>::max();
+            for (int p = 0; p < 8; ++p) {
+                const auto d = std::abs(block[i][3] - palette[p]);
+                if (d < bestDistance) {
+                    bestDistance = d;
+                    best = p;
+                }
+            }
+            indices |= static_cast<std::uint64_t>(best) << (i * 3);
+        }
+    }
+    for (int i = 0; i < 6; ++i) {
+        out[2 + i] = static_cast<std::uint8_t>((indices >> (i * 8)) & 0xFF);
+    }
+}
+
+void decodeAlpha(const std::uint8_t* in, Block& block) {
+    const auto palette = alphaPalette(in[0], in[1]);
+    std::uint64_t indices = 0;
+    for (int i = 0; i < 6; ++i) {
+        indices |= static_cast<std::uint64_t>(in[2 + i]) << (i * 8);
+    }
+    for (int i = 0; i < kBlockPixels; ++i) {
+        block[i][3] = palette[(indices >> (i * 3)) & 7];
+    }
+}
+}  // namespace
+
+size_t getCompressedSize(Format format, int width, int height) {
+    return static_cast<size_t>(blockCount(width)) *
+           static_cast<size_t>(blockCount(height)) * blockBytes(format);
+}
+
+std::vector<std::uint8_t> encode(Format format, const std::uint8_t* rgba,
+                                 int width, int height) {
+    std::vector<std::uint8_t> out(getCompressedSize(format, width, height));
+    auto dst = out.data();
+    for (int by = 0; by < blockCount(height); ++by) {
+        for (int bx = 0; bx < blockCount(width); ++bx) {
+            const auto block = readBlock(rgba, width, height, bx, by);
+            if (format == Format::BC3) {
+                encodeAlpha(block, dst);
+                dst += 8;
+            }
+            encodeColour(block, dst);
+            dst += 8;
+        }
+    }
+    return out;
+}
+
+std::vector<std::uint8_t> decode(Format format, const std::uint8_t* data,
+                                 int width, int height) {
+    std::vector<std::uint8_t> out(static_cast<size_t>(width) * height * 4);
+    for (int by = 0; by < blockCount(height); ++by) {
+        for (int bx = 0; bx < blockCount(width); ++bx) {
+            Block block;
+            if (format == Format::BC3) {
+                decodeColour(data + 8, block, false);
+                decodeAlpha(data, block);
+            } else {
+                decodeColour(data, block, true);
+            }
+            data += blockBytes(format);
+            writeBlock(block, out.data(), width, height, bx, by);
+        }
+    }
+    return out;
+}
+
+std::vector<std::uint8_t> downsample(const std::uint8_t* rgba, int width,
+                                     int height) {
+    const int outWidth = std::max(width / 2, 1);
+    const int outHeight = std::max(height / 2, 1);
+    std::vector<std::uint8_t> out(static_cast<size_t>(outWidth) * outHeight *
+                                  4);
+    for (int y = 0; y < outHeight; ++y) {
+        const int y0 = std::min(y * 2, height - 1);
+        const int y1 = std::min(y * 2 + 1, height - 1);
+        for (int x = 0; x < outWidth; ++x) {
+            const int x0 = std::min(x * 2, width - 1);
+            const int x1 = std::min(x * 2 + 1, width - 1);
+            for (int c = 0; c < 4; ++c) {
+                const auto at = [&](int sx, int sy) {
+                    return rgba[(static_cast<size_t>(sy) * width + sx) * 4 + c];
+                };
+                const int sum = at(x0, y0) + at(x1, y0) + at(x0, y1) +
+                                at(x1, y1);
+                out[(static_cast<size_t>(y) * outWidth + x) * 4 + c] =
+                    static_cast<std::uint8_t>((sum + 2) / 4);
+            }
+        }
+    }
+    return out;
+}
+
+std::vector<Level> encodeMipChain(Format format, const std::uint8_t* rgba,
+                                  int width, int height) {
+    std::vector<Level> levels;
+    levels.push_back({width, height, encode(format, rgba, width, height)});
+
+    std::vector<std::uint8_t> current;
+    while (width > 1 || height > 1) {
+        current = downsample(current.empty() ? rgba : current.data(), width,
+                             height);
+        width = std::max(width / 2, 1);
+        height = std::max(height / 2, 1);
+        levels.push_back(
+            {width, height, encode(format, current.data(), width, height)});
+    }
+    return levels;
+}
+
+Format chooseFormat(const std::uint8_t* rgba, int width, int height) {
+    const auto count = static_cast<size_t>(width) * height;
+    for (size_t i = 0; i < count; ++i) {
+        if (rgba[i * 4 + 3] != 255) {
+            return Format::BC3;
+        }
+    }
+    return Format::BC1;
+}
+
+}  // namespace BlockCompression
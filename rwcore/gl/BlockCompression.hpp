@@ -0,0 +1,57 @@
+#ifndef _LIBRW_BLOCKCOMPRESSION_HPP_
+#define _LIBRW_BLOCKCOMPRESSION_HPP_
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * CPU encoder and decoder for the BC1 (DXT1) and BC3 (DXT5) texture formats
+ *
+ * Images are 8 bit RGBA, rows tightly packed. Sizes that aren't a multiple
+ * of 4 are padded by repeating the last row and column, as GL expects for
+ * small mip levels.
+ */
+namespace BlockCompression {
+
+enum class Format : std::uint8_t {
+    /// Colour only, 8 bytes per 4x4 block
+    BC1 = 1,
+    /// Colour and interpolated alpha, 16 bytes per 4x4 block
+    BC3 = 3,
+};
+
+struct Level {
+    int width;
+    int height;
+    std::vector<std::uint8_t> data;
+};
+
+size_t getCompressedSize(Format format, int width, int height);
+
+std::vector<std::uint8_t> encode(Format format, const std::uint8_t* rgba,
+                                 int width, int height);
+
+std::vector<std::uint8_t> decode(Format format, const std::uint8_t* data,
+                                 int width, int height);
+
+/**
+ * Halves the image with a box filter, down to 1 pixel on each side
+ */
+std::vector<std::uint8_t> downsample(const std::uint8_t* rgba, int width,
+                                     int height);
+
+/**
+ * Compresses the image and every mip level below it
+ */
+std::vector<Level> encodeMipChain(Format format, const std::uint8_t* rgba,
+                                  int width, int height);
+
+/**
+ * @return BC1 if every pixel is opaque, BC3 otherwise
+ */
+Format chooseFormat(const std::uint8_t* rgba, int width, int height);
+
+}  // namespace BlockCompression
+
+#endif
@@ -0,0 +1,160 @@
+#include "gl/GeometryArena.hpp"
+
+#include <iterator>
+#include <vector>
+
+ArenaAllocator::ArenaAllocator(size_t capacity) : capacity(capacity) {
+    if (capacity > 0) {
+        freeRanges.emplace(0, capacity);
+    }
+}
+
+size_t ArenaAllocator::allocate(size_t size) {
+    if (size == 0) {
+        return npos;
+    }
+
+    // First fit, geometry sizes vary too much for anything smarter to pay off
+    for (auto it = freeRanges.begin(); it != freeRanges.end(); ++it) {
+        if (it->second < size) {
+            continue;
+        }
+        const auto offset = it->first;
+        const auto remaining = it->second - size;
+        freeRanges.erase(it);
+        if (remaining > 0) {
+            freeRanges.emplace(offset + size, remaining);
+        }
+        used += size;
+        return offset;
+    }
+
+    return npos;
+}
+
+void ArenaAllocator::free(size_t offset, size_t size) {
+    if (size == 0) {
+        return;
+    }
+    used -= size;
+
+    auto next = freeRanges.lower_bound(offset);
+    if (next != freeRanges.end() && offset + size == next->first) {
+        size += next->second;
+        next = freeRanges.erase(next);
+    }
+
+    if (next != freeRanges.begin()) {
+        auto prev = std::prev(next);
+        if (prev->first + prev->second == offset) {
+            prev->second += size;
+            return;
+        }
+    }
+
+    freeRanges.emplace_hint(next, offset, size);
+}
+
+GeometryArena::GeometryArena(GLsizei vertexSize,
+                             const AttributeList& attributes,
+                             size_t vertexCapacity, size_t indexCapacity)
+    : vertexSize(vertexSize)
+    , vertices(vertexCapacity)
+    , indices(indexCapacity) {
+    gbuff.uploadVertices(static_cast<GLsizei>(vertexCapacity),
+                         static_cast<GLsizeiptr>(vertexCapacity * vertexSize),
+                         nullptr);
+    gbuff.getDataAttributes() = attributes;
+
+    glGenBuffers(1, &EBO);
+
+    for (auto draw : {&triangleDraw, &stripDraw}) {
+        draw->addGeometry(&gbuff);
+        // addGeometry leaves the VAO bound, attach the indices to it
+        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, EBO);
+    }
+    glBufferData(GL_ELEMENT_ARRAY_BUFFER,
+                 static_cast<GLsizeiptr>(indexCapacity * sizeof(std::uint32_t)),
+                 nullptr, GL_STATIC_DRAW);
+
+    triangleDraw.setFaceType(GL_TRIANGLES);
+    stripDraw.setFaceType(GL_TRIANGLE_STRIP);
+}
+
+GeometryArena::~GeometryArena() {
+    if (EBO) {
+        glDeleteBuffers(1, &EBO);
+    }
+}
+
+bool GeometryArena::allocate(size_t numVertices, size_t numIndices,
+                             ArenaAllocation& out) {
+    const auto baseVertex = vertices.allocate(numVertices);
+    if (baseVertex == ArenaAllocator::npos) {
+        return false;
+    }
+    const auto firstIndex = indices.allocate(numIndices);
+    if (firstIndex == ArenaAllocator::npos) {
+        vertices.free(baseVertex, numVertices);
+        return false;
+    }
+
+    out.baseVertex = baseVertex;
+    out.numVertices = numVertices;
+    out.firstIndex = firstIndex;
+    out.numIndices = numIndices;
+    return true;
+}
+
+void GeometryArena::free(const ArenaAllocation& allocation) {
+    vertices.free(allocation.baseVertex, allocation.numVertices);
+    indices.free(allocation.firstIndex, allocation.numIndices);
+}
+
+void GeometryArena::upload(const ArenaAllocation& allocation,
+                           const void* vertexData,
+                           const std::uint32_t* indexData) {
+    // Use the copy target so the bound VAO's index buffer isn't touched
+    glBindBuffer(GL_COPY_WRITE_BUFFER, gbuff.getVBOName());
+    glBufferSubData(GL_COPY_WRITE_BUFFER,
+                    static_cast<GLintptr>(allocation.baseVertex * vertexSize),
+                    static_cast<GLsizeiptr>(allocation.numVertices * vertexSize),
+                    vertexData);
+
+    std::vector<std::uint32_t> rebased(indexData,
+                                       indexData + allocation.numIndices);
+    for (auto& index : rebased) {
+        index += static_cast<std::uint32_t>(allocation.baseVertex);
+    }
+
+    glBindBuffer(GL_COPY_WRITE_BUFFER, EBO);
+    glBufferSubData(
+        GL_COPY_WRITE_BUFFER,
+        static_cast<GLintptr>(allocation.firstIndex * sizeof(std::uint32_t)),
+        static_cast<GLsizeiptr>(rebased.size() * sizeof(std::uint32_t)),
+        rebased.data());
+}
+
+bool GeometryArenaPool::allocate(size_t numVertices, size_t numIndices,
+                                 ArenaAllocation& out) {
+    if (numVertices == 0 || numIndices == 0 || numVertices > vertexCapacity ||
+        numIndices > indexCapacity) {
+        return false;
+    }
+
+    for (const auto& arena : arenas) {
+        if (arena->allocate(numVertices, numIndices, out)) {
+            out.arena = arena;
+            return true;
+        }
+    }
+
+    auto arena = std::make_shared<GeometryArena>(vertexSize, attributes,
+                                                 vertexCapacity, indexCapacity);
+    if (!arena->allocate(numVertices, numIndices, out)) {
+        return false;
+    }
+    arenas.push_back(arena);
+    out.arena = arena;
+    return true;
+}
@@ -0,0 +1,147 @@
+#ifndef _LIBRW_GEOMETRYARENA_HPP_
+#define _LIBRW_GEOMETRYARENA_HPP_
+
+#include <gl/DrawBuffer.hpp>
+#include <gl/GeometryBuffer.hpp>
+#include <gl/gl_core_3_3.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <map>
+#include <memory>
+#include <vector>
+
+/**
+ * ArenaAllocator hands out ranges of a fixed capacity using a free list
+ *
+ * Free ranges are merged with their neighbours when released, so space
+ * from unloaded models can be reused by larger ones later.
+ */
+class ArenaAllocator {
+public:
+    static constexpr size_t npos = std::numeric_limits<size_t>::max();
+
+    explicit ArenaAllocator(size_t capacity);
+
+    /**
+     * @return the offset of the new range, or npos if there is no space
+     */
+    size_t allocate(size_t size);
+
+    void free(size_t offset, size_t size);
+
+    size_t getCapacity() const {
+        return capacity;
+    }
+
+    size_t getUsed() const {
+        return used;
+    }
+
+    size_t getFreeRangeCount() const {
+        return freeRanges.size();
+    }
+
+private:
+    size_t capacity;
+    size_t used = 0;
+    /// Free ranges, offset -> size
+    std::map<size_t, size_t> freeRanges;
+};
+
+class GeometryArena;
+
+/**
+ * The part of an arena used by a single geometry
+ */
+struct ArenaAllocation {
+    std::shared_ptr<GeometryArena> arena;
+    size_t baseVertex = 0;
+    size_t numVertices = 0;
+    size_t firstIndex = 0;
+    size_t numIndices = 0;
+};
+
+/**
+ * GeometryArena stores the vertices and indices of many geometries in one
+ * pair of buffers, so they can all be drawn without switching VAOs.
+ *
+ * Indices are rebased on upload, so draws only need the index offset.
+ */
+class GeometryArena {
+public:
+    GeometryArena(GLsizei vertexSize, const AttributeList& attributes,
+                  size_t vertexCapacity, size_t indexCapacity);
+    ~GeometryArena();
+
+    bool allocate(size_t numVertices, size_t numIndices, ArenaAllocation& out);
+
+    void free(const ArenaAllocation& allocation);
+
+    /**
+     * Uploads the vertices and indices for an allocation
+     */
+    void upload(const ArenaAllocation& allocation, const void* vertices,
+                const std::uint32_t* indices);
+
+    /**
+     * @return The draw buffer to use for the given face type
+     */
+    DrawBuffer* getDrawBuffer(GLenum faceType) {
+        return faceType == GL_TRIANGLE_STRIP ? &stripDraw : &triangleDraw;
+    }
+
+    const ArenaAllocator& getVertexAllocator() const {
+        return vertices;
+    }
+
+    const ArenaAllocator& getIndexAllocator() const {
+        return indices;
+    }
+
+private:
+    GLsizei vertexSize;
+    ArenaAllocator vertices;
+    ArenaAllocator indices;
+
+    GeometryBuffer gbuff;
+    GLuint EBO = 0;
+
+    // Face type is part of DrawBuffer, so keep one for each
+    DrawBuffer triangleDraw;
+    DrawBuffer stripDraw;
+};
+
+/**
+ * Owns the arenas for a single vertex format, creating more as they fill
+ */
+class GeometryArenaPool {
+public:
+    GeometryArenaPool(GLsizei vertexSize, const AttributeList& attributes,
+                      size_t vertexCapacity, size_t indexCapacity)
+        : vertexSize(vertexSize)
+        , attributes(attributes)
+        , vertexCapacity(vertexCapacity)
+        , indexCapacity(indexCapacity) {
+    }
+
+    /**
+     * Finds space for a geometry
+     * @return false if the geometry doesn't fit in an arena
+     */
+    bool allocate(size_t numVertices, size_t numIndices, ArenaAllocation& out);
+
+    const std::vector<std::shared_ptr<GeometryArena>>& getArenas() const {
+        return arenas;
+    }
+
+private:
+    GLsizei vertexSize;
+    AttributeList attributes;
+    size_t vertexCapacity;
+    size_t indexCapacity;
+    std::vector<std::shared_ptr<GeometryArena>> arenas;
+};
+
+#endif
@@ -11,6 +11,7 @@
 #include <glm/glm.hpp>
 
 #include "data/Clump.hpp"
+#include "gl/GeometryArena.hpp"
 #include "gl/gl_core_3_3.h"
 #include "loaders/RWBinaryStream.hpp"
 #include "platform/FileHandle.hpp"
@@ -115,7 +116,8 @@ LoaderDFF::FrameList LoaderDFF::readFrameList(const RWBStream &stream) {
     return framelist;
 }
 
-LoaderDFF::GeometryList LoaderDFF::readGeometryList(const RWBStream &stream) {
+LoaderDFF::GeometryList LoaderDFF::readGeometryList(const RWBStream &stream,
+                                                    GeometryArenaPool *arenas) {
     auto listStream = stream.getInnerStream();
 
     auto listStructID = listStream.getNextChunk();
@@ -135,7 +137,7 @@ LoaderDFF::GeometryList LoaderDFF::readGeometryList(const RWBStream &stream) {
          chunkID = listStream.getNextChunk()) {
         switch (chunkID) {
             case CHUNK_GEOMETRY: {
-                geometrylist.push_back(readGeometry(listStream));
+                geometrylist.push_back(readGeometry(listStream, arenas));
             } break;
             default:
                 break;
@@ -145,7 +147,8 @@ LoaderDFF::GeometryList LoaderDFF::readGeometryList(const RWBStream &stream) {
     return geometrylist;
 }
 
-GeometryPtr LoaderDFF::readGeometry(const RWBStream &stream) {
+GeometryPtr LoaderDFF::readGeometry(const RWBStream &stream,
+                                    GeometryArenaPool *arenas) {
     auto geomStream = stream.getInnerStream();
 
     auto geomStructID = geomStream.getNextChunk();
@@ -252,15 +255,28 @@ GeometryPtr LoaderDFF::readGeometry(const RWBStream &stream) {
     geom->dbuff.setFaceType(geom->facetype == Geometry::Triangles
                                 ? GL_TRIANGLES
                                 : GL_TRIANGLE_STRIP);
+
+    size_t icount = std::accumulate(
+        geom->subgeom.begin(), geom->subgeom.end(), size_t{0u},
+        [](size_t a, const SubGeometry &b) { return a + b.numIndices; });
+
+    if (arenas && arenas->allocate(verts.size(), icount, geom->arena)) {
+        std::vector<uint32_t> indices;
+        indices.reserve(icount);
+        for (auto &sg : geom->subgeom) {
+            indices.insert(indices.end(), sg.indices.begin(), sg.indices.end());
+            sg.start += geom->arena.firstIndex;
+        }
+        geom->arena.arena->upload(geom->arena, verts.data(), indices.data());
+        return geom;
+    }
+
     geom->gbuff.uploadVertices(verts);
     geom->dbuff.addGeometry(&geom->gbuff);
 
     glGenBuffers(1, &geom->EBO);
     glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, geom->EBO);
 
-    size_t icount = std::accumulate(
-        geom->subgeom.begin(), geom->subgeom.end(), size_t{0u},
-        [](size_t a, const SubGeometry &b) { return a + b.numIndices; });
     glBufferData(GL_ELEMENT_ARRAY_BUFFER, sizeof(uint32_t) * icount, nullptr,
                  GL_STATIC_DRAW);
     for (auto &sg : geom->subgeom) {
@@ -454,7 +470,8 @@ AtomicPtr LoaderDFF::readAtomic(FrameList &framelist,
     return atomic;
 }
 
-ClumpPtr LoaderDFF::loadFromMemory(const FileContentsInfo& file) {
+ClumpPtr LoaderDFF::loadFromMemory(const FileContentsInfo& file,
+                                   GeometryArenaPool* arenas) {
     auto model = std::make_shared<Clump>();
 
     RWBStream rootStream(file.data.get(), file.length);
@@ -486,7 +503,7 @@ ClumpPtr LoaderDFF::loadFromMemory(const FileContentsInfo& file) {
                 framelist = readFrameList(modelStream);
                 break;
             case CHUNK_GEOMETRYLIST:
-                geometrylist = readGeometryList(modelStream);
+                geometrylist = readGeometryList(modelStream, arenas);
                 break;
             case CHUNK_ATOMIC: {
                 auto atomic = readAtomic(framelist, geometrylist, modelStream);
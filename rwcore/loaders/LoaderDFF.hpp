@@ -8,6 +8,7 @@
 #include <string>
 #include <vector>
 
+class GeometryArenaPool;
 class RWBStream;
 
 class DFFLoaderException {
@@ -30,7 +31,13 @@ public:
     using GeometryList = std::vector<GeometryPtr>;
     using FrameList = std::vector<ModelFramePtr>;
 
-    ClumpPtr loadFromMemory(const FileContentsInfo& file);
+    /**
+     * Loads a clump from a DFF file
+     *
+     * If arenas is set, geometry is stored in the shared arenas where it fits
+     */
+    ClumpPtr loadFromMemory(const FileContentsInfo& file,
+                            GeometryArenaPool* arenas = nullptr);
 
     void setTextureLookupCallback(const TextureLookupCallback& tlc) {
         textureLookup = tlc;
@@ -41,9 +48,10 @@ private:
 
     FrameList readFrameList(const RWBStream& stream);
 
-    GeometryList readGeometryList(const RWBStream& stream);
+    GeometryList readGeometryList(const RWBStream& stream,
+                                  GeometryArenaPool* arenas);
 
-    GeometryPtr readGeometry(const RWBStream& stream);
+    GeometryPtr readGeometry(const RWBStream& stream, GeometryArenaPool* arenas);
 
     void readMaterialList(const GeometryPtr& geom, const RWBStream& stream);
 
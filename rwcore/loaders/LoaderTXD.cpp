@@ -4,6 +4,7 @@
 #include <cctype>
 #include <cstddef>
 #include <cstdint>
+#include <cstring>
 #include <string>
 #include <vector>
 
@@ -53,6 +54,33 @@ void processPalette(uint32_t* fullColor, RW::BinaryStreamSection& rootSection) {
     }
 }
 
+static GLenum getMagFilter(const RW::BSTextureNative& texNative) {
+    switch (texNative.filterflags & 0xFF) {
+        default:
+        case RW::BSTextureNative::FILTER_LINEAR:
+            return GL_LINEAR;
+        case RW::BSTextureNative::FILTER_NEAREST:
+            return GL_NEAREST;
+    }
+}
+
+static GLenum getWrap(uint8_t wrap) {
+    switch (wrap) {
+        default:
+        case RW::BSTextureNative::WRAP_WRAP:
+            return GL_REPEAT;
+        case RW::BSTextureNative::WRAP_CLAMP:
+            return GL_CLAMP_TO_EDGE;
+        case RW::BSTextureNative::WRAP_MIRROR:
+            return GL_MIRRORED_REPEAT;
+    }
+}
+
+static bool isTransparent(const RW::BSTextureNative& texNative) {
+    return !((texNative.rasterformat & RW::BSTextureNative::FORMAT_888) ==
+             RW::BSTextureNative::FORMAT_888);
+}
+
 static std::unique_ptr<TextureData> createTexture(
     RW::BSTextureNative& texNative, RW::BinaryStreamSection& rootSection) {
     // TODO: Exception handling.
@@ -69,9 +97,7 @@ static std::unique_ptr<TextureData> createTexture(
                   texNative.rasterformat == RW::BSTextureNative::FORMAT_8888 ||
                   texNative.rasterformat == RW::BSTextureNative::FORMAT_888;
     // Export this value
-    bool transparent =
-        !((texNative.rasterformat & RW::BSTextureNative::FORMAT_888) ==
-          RW::BSTextureNative::FORMAT_888);
+    bool transparent = isTransparent(texNative);
 
     if (!(isPal8 || isFulc)) {
         RW_ERROR("Unsupported raster format " << std::dec
@@ -123,58 +149,161 @@ static std::unique_ptr<TextureData> createTexture(
         return getErrorTexture();
     }
 
-    GLenum texFilter = GL_LINEAR;
-    switch (texNative.filterflags & 0xFF) {
-        default:
-        case RW::BSTextureNative::FILTER_LINEAR:
-            texFilter = GL_LINEAR;
-            break;
-        case RW::BSTextureNative::FILTER_NEAREST:
-            texFilter = GL_NEAREST;
-            break;
-    }
-
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER,
                     GL_LINEAR_MIPMAP_LINEAR);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, texFilter);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER,
+                    getMagFilter(texNative));
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, getWrap(texNative.wrapU));
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, getWrap(texNative.wrapV));
+
+    glGenerateMipmap(GL_TEXTURE_2D);
 
-    GLenum texwrap = GL_REPEAT;
-    switch (texNative.wrapU) {
+    return TextureData::create(textureName, {texNative.width, texNative.height},
+                               transparent);
+}
+
+/**
+ * @return true if decodeRaster handles the raster's format
+ */
+static bool isDecodable(const RW::BSTextureNative& texNative) {
+    if (texNative.platform != 8) {
+        return false;
+    }
+    if ((texNative.rasterformat & RW::BSTextureNative::FORMAT_EXT_PAL8) ==
+        RW::BSTextureNative::FORMAT_EXT_PAL8) {
+        return true;
+    }
+    switch (texNative.rasterformat) {
+        case RW::BSTextureNative::FORMAT_1555:
+        case RW::BSTextureNative::FORMAT_8888:
+        case RW::BSTextureNative::FORMAT_888:
+            return true;
         default:
-        case RW::BSTextureNative::WRAP_WRAP:
-            texwrap = GL_REPEAT;
-            break;
-        case RW::BSTextureNative::WRAP_CLAMP:
-            texwrap = GL_CLAMP_TO_EDGE;
-            break;
-        case RW::BSTextureNative::WRAP_MIRROR:
-            texwrap = GL_MIRRORED_REPEAT;
-            break;
+            return false;
+    }
+}
+
+/**
+ * Converts the raster to 8 bit RGBA, as createTexture would upload it
+ */
+static bool decodeRaster(const RW::BSTextureNative& texNative,
+                         RW::BinaryStreamSection& rootSection,
+                         std::vector<uint8_t>& rgba) {
+    if (!isDecodable(texNative)) {
+        return false;
+    }
+    const size_t pixels =
+        static_cast<size_t>(texNative.width) * texNative.height;
+    rgba.resize(pixels * 4);
+
+    if ((texNative.rasterformat & RW::BSTextureNative::FORMAT_EXT_PAL8) ==
+        RW::BSTextureNative::FORMAT_EXT_PAL8) {
+        std::vector<uint32_t> fullColor(pixels);
+        processPalette(fullColor.data(), rootSection);
+        std::memcpy(rgba.data(), fullColor.data(), rgba.size());
+        return true;
     }
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, texwrap);
 
-    switch (texNative.wrapV) {
+    auto coldata = rootSection.raw() + sizeof(RW::BSTextureNative);
+    coldata += sizeof(uint32_t);
+
+    switch (texNative.rasterformat) {
+        case RW::BSTextureNative::FORMAT_1555:
+            // Matches GL_UNSIGNED_SHORT_1_5_5_5_REV, red in the low bits
+            for (size_t i = 0; i < pixels; ++i) {
+                uint16_t v;
+                std::memcpy(&v, coldata + i * sizeof(v), sizeof(v));
+                const auto expand = [](int c) {
+                    return static_cast<uint8_t>((c << 3) | (c >> 2));
+                };
+                rgba[i * 4 + 0] = expand(v & 0x1F);
+                rgba[i * 4 + 1] = expand((v >> 5) & 0x1F);
+                rgba[i * 4 + 2] = expand((v >> 10) & 0x1F);
+                rgba[i * 4 + 3] = (v & 0x8000) ? 255 : 0;
+            }
+            return true;
+        case RW::BSTextureNative::FORMAT_8888:
+            coldata += 8;
+            [[fallthrough]];
+        case RW::BSTextureNative::FORMAT_888:
+            for (size_t i = 0; i < pixels; ++i) {
+                const auto bgra =
+                    reinterpret_cast<const uint8_t*>(coldata) + i * 4;
+                rgba[i * 4 + 0] = bgra[2];
+                rgba[i * 4 + 1] = bgra[1];
+                rgba[i * 4 + 2] = bgra[0];
+                rgba[i * 4 + 3] = bgra[3];
+            }
+            return true;
         default:
-        case RW::BSTextureNative::WRAP_WRAP:
-            texwrap = GL_REPEAT;
-            break;
-        case RW::BSTextureNative::WRAP_CLAMP:
-            texwrap = GL_CLAMP_TO_EDGE;
-            break;
-        case RW::BSTextureNative::WRAP_MIRROR:
-            texwrap = GL_MIRRORED_REPEAT;
-            break;
+            return false;
     }
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, texwrap);
+}
 
-    glGenerateMipmap(GL_TEXTURE_2D);
+static bool compressTexture(const RW::BSTextureNative& texNative,
+                            RW::BinaryStreamSection& rootSection,
+                            TextureCache::Texture& texture) {
+    std::vector<uint8_t> rgba;
+    if (!decodeRaster(texNative, rootSection, rgba)) {
+        return false;
+    }
 
-    return TextureData::create(textureName, {texNative.width, texNative.height},
-                               transparent);
+    texture.transparent = isTransparent(texNative);
+    if (texture.transparent) {
+        texture.format = BlockCompression::chooseFormat(
+            rgba.data(), texNative.width, texNative.height);
+    } else {
+        // The alpha of opaque rasters is padding, don't let it pick BC3
+        texture.format = BlockCompression::Format::BC1;
+        for (size_t i = 3; i < rgba.size(); i += 4) {
+            rgba[i] = 255;
+        }
+    }
+    texture.magFilter = getMagFilter(texNative);
+    texture.wrapS = getWrap(texNative.wrapU);
+    texture.wrapT = getWrap(texNative.wrapV);
+    texture.levels = BlockCompression::encodeMipChain(
+        texture.format, rgba.data(), texNative.width, texNative.height);
+    return true;
 }
 
-bool TextureLoader::loadFromMemory(const FileContentsInfo& file,
-                                   TextureArchive& inTextures) {
+static std::unique_ptr<TextureData> createCompressedTexture(
+    const TextureCache::Texture& texture) {
+    const GLenum internalFormat =
+        texture.format == BlockCompression::Format::BC1
+            ? GL_COMPRESSED_RGBA_S3TC_DXT1_EXT
+            : GL_COMPRESSED_RGBA_S3TC_DXT5_EXT;
+
+    GLuint textureName = 0;
+    glGenTextures(1, &textureName);
+    glBindTexture(GL_TEXTURE_2D, textureName);
+    for (size_t i = 0; i < texture.levels.size(); ++i) {
+        const auto& level = texture.levels[i];
+        glCompressedTexImage2D(GL_TEXTURE_2D, static_cast<GLint>(i),
+                               internalFormat, level.width, level.height, 0,
+                               static_cast<GLsizei>(level.data.size()),
+                               level.data.data());
+    }
+
+    // The mip chain is complete, so there is nothing left to generate
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL,
+                    static_cast<GLint>(texture.levels.size() - 1));
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER,
+                    GL_LINEAR_MIPMAP_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER,
+                    static_cast<GLint>(texture.magFilter));
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S,
+                    static_cast<GLint>(texture.wrapS));
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T,
+                    static_cast<GLint>(texture.wrapT));
+
+    const auto& base = texture.levels.front();
+    return TextureData::create(textureName, {base.width, base.height},
+                               texture.transparent);
+}
+
+template <class Callback>
+static void forEachTexture(const FileContentsInfo& file, Callback callback) {
     auto data = file.data.get();
     RW::BinaryStreamSection root(data);
     /*auto texDict =*/root.readStructure<RW::BSTextureDictionary>();
@@ -192,8 +321,64 @@ bool TextureLoader::loadFromMemory(const FileContentsInfo& file,
         std::transform(name.begin(), name.end(), name.begin(), ::tolower);
         std::transform(alpha.begin(), alpha.end(), alpha.begin(), ::tolower);
 
-        inTextures[name] = createTexture(texNative, rootSection);
+        callback(name, texNative, rootSection);
+    }
+}
+
+/**
+ * @return false if any texture can't be compressed
+ */
+static bool compressArchive(const FileContentsInfo& file,
+                            TextureCache::Archive& archive) {
+    // Checked up front, so archives that can't be cached aren't partly
+    // encoded again on every load
+    bool supported = true;
+    forEachTexture(file, [&](const std::string&,
+                             const RW::BSTextureNative& texNative,
+                             RW::BinaryStreamSection&) {
+        supported = supported && isDecodable(texNative);
+    });
+    if (!supported) {
+        return false;
     }
 
+    forEachTexture(file, [&](const std::string& name,
+                             const RW::BSTextureNative& texNative,
+                             RW::BinaryStreamSection& rootSection) {
+        TextureCache::Texture texture;
+        texture.name = name;
+        supported = compressTexture(texNative, rootSection, texture) &&
+                    supported;
+        archive.push_back(std::move(texture));
+    });
+    return supported;
+}
+
+bool TextureLoader::loadFromMemory(const FileContentsInfo& file,
+                                   TextureArchive& inTextures,
+                                   const std::string& name) {
+    if (cache && !name.empty() && ogl_ext_EXT_texture_compression_s3tc) {
+        const auto hash = TextureCache::hash(file.data.get(), file.length);
+        TextureCache::Archive archive;
+        bool cached = cache->load(name, hash, archive);
+        if (!cached && compressArchive(file, archive)) {
+            cache->store(name, hash, archive);
+            cached = true;
+        }
+        if (cached) {
+            for (const auto& texture : archive) {
+                inTextures[texture.name] = createCompressedTexture(texture);
+            }
+            return true;
+        }
+        // Formats the encoder doesn't handle are uploaded as they are
+    }
+
+    forEachTexture(file, [&](const std::string& name,
+                             RW::BSTextureNative& texNative,
+                             RW::BinaryStreamSection& rootSection) {
+        inTextures[name] = createTexture(texNative, rootSection);
+    });
+
     return true;
 }
@@ -2,11 +2,38 @@
 #define _LIBRW_TEXTURELOADER_HPP_
 
 #include <gl/TextureData.hpp>
+#include <loaders/TextureCache.hpp>
 #include <rw/forward.hpp>
 
+#include <memory>
+#include <string>
+
 class TextureLoader {
 public:
-    bool loadFromMemory(const FileContentsInfo& file, TextureArchive& inTextures);
+    /**
+     * Keeps block compressed copies of the archives in the cache, archives
+     * are compressed the first time they are loaded and read back from the
+     * cache after that.
+     *
+     * Only used if the driver supports S3TC, otherwise textures are uploaded
+     * uncompressed.
+     */
+    void setCache(std::unique_ptr<TextureCache> textureCache) {
+        cache = std::move(textureCache);
+    }
+
+    TextureCache* getCache() const {
+        return cache.get();
+    }
+
+    /**
+     * @param name Archive name to cache under, nothing is cached if empty
+     */
+    bool loadFromMemory(const FileContentsInfo& file, TextureArchive& inTextures,
+                        const std::string& name = {});
+
+private:
+    std::unique_ptr<TextureCache> cache;
 };
 
 #endif
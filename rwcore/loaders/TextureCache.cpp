@@ -0,0 +1,208 @@
+#include "loaders/TextureCache.hpp"
+
+#include <array>
+#include <cctype>
+#include <cstdio>
+#include <fstream>
+#include <utility>
+
+namespace {
+constexpr std::array<char, 4> kMagic{{'R', 'W', 'T', 'C'}};
+constexpr std::uint32_t kVersion = 1;
+constexpr const char* kExtension = ".rwtc";
+
+/// Guards against reading huge sizes from damaged files
+constexpr std::uint32_t kMaxTextures = 1 << 16;
+constexpr std::uint32_t kMaxLevels = 32;
+constexpr std::uint32_t kMaxNameLength = 256;
+constexpr int kMaxDimension = 1 << 14;
+
+template <class T>
+void write(std::ostream& out, const T& value) {
+    out.write(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+template <class T>
+bool read(std::istream& in, T& value) {
+    in.read(reinterpret_cast<char*>(&value), sizeof(T));
+    return in.good();
+}
+
+/// Archive names become part of the file name
+std::string sanitize(const std::string& name) {
+    std::string safe = name;
+    for (auto& c : safe) {
+        const auto u = static_cast<unsigned char>(c);
+        c = std::isalnum(u) ? static_cast<char>(std::tolower(u)) : '_';
+    }
+    return safe;
+}
+
+bool readTexture(std::istream& in, TextureCache::Texture& texture) {
+    std::uint32_t nameLength = 0;
+    if (!read(in, nameLength) || nameLength > kMaxNameLength) {
+        return false;
+    }
+    texture.name.resize(nameLength);
+    in.read(&texture.name[0], nameLength);
+
+    std::uint8_t format = 0;
+    std::uint8_t transparent = 0;
+    std::uint32_t levelCount = 0;
+    if (!read(in, format) || !read(in, transparent) ||
+        !read(in, texture.magFilter) || !read(in, texture.wrapS) ||
+        !read(in, texture.wrapT) || !read(in, levelCount)) {
+        return false;
+    }
+    if (format != static_cast<std::uint8_t>(BlockCompression::Format::BC1) &&
+        format != static_cast<std::uint8_t>(BlockCompression::Format::BC3)) {
+        return false;
+    }
+    if (levelCount == 0 || levelCount > kMaxLevels) {
+        return false;
+    }
+    texture.format = static_cast<BlockCompression::Format>(format);
+    texture.transparent = transparent != 0;
+
+    texture.levels.resize(levelCount);
+    for (auto& level : texture.levels) {
+        std::uint32_t size = 0;
+        if (!read(in, level.width) || !read(in, level.height) ||
+            !read(in, size)) {
+            return false;
+        }
+        if (level.width <= 0 || level.height <= 0 ||
+            level.width > kMaxDimension || level.height > kMaxDimension ||
+            size != BlockCompression::getCompressedSize(
+                        texture.format, level.width, level.height)) {
+            return false;
+        }
+        level.data.resize(size);
+        in.read(reinterpret_cast<char*>(level.data.data()), size);
+        if (!in.good()) {
+            return false;
+        }
+    }
+    return true;
+}
+}  // namespace
+
+TextureCache::TextureCache(rwfs::path directory)
+    : directory(std::move(directory)) {
+}
+
+std::uint64_t TextureCache::hash(const char* data, size_t length) {
+    std::uint64_t h = 14695981039346656037ull;
+    for (size_t i = 0; i < length; ++i) {
+        h ^= static_cast<std::uint8_t>(data[i]);
+        h *= 1099511628211ull;
+    }
+    return h;
+}
+
+rwfs::path TextureCache::getPath(const std::string& name,
+                                 std::uint64_t contentHash) const {
+    char hex[17];
+    std::snprintf(hex, sizeof(hex), "%016llx",
+                  static_cast<unsigned long long>(contentHash));
+    return directory / (sanitize(name) + "-" + hex + kExtension);
+}
+
+bool TextureCache::load(const std::string& name, std::uint64_t contentHash,
+                        Archive& archive) const {
+    std::ifstream in(getPath(name, contentHash).string(), std::ios::binary);
+    if (!in.is_open()) {
+        return false;
+    }
+
+    std::array<char, 4> magic{};
+    std::uint32_t version = 0;
+    std::uint64_t storedHash = 0;
+    std::uint32_t count = 0;
+    in.read(magic.data(), magic.size());
+    if (!in.good() || magic != kMagic || !read(in, version) ||
+        version != kVersion || !read(in, storedHash) ||
+        storedHash != contentHash || !read(in, count) ||
+        count > kMaxTextures) {
+        return false;
+    }
+
+    Archive textures(count);
+    for (auto& texture : textures) {
+        if (!readTexture(in, texture)) {
+            return false;
+        }
+    }
+    archive = std::move(textures);
+    return true;
+}
+
+bool TextureCache::store(const std::string& name, std::uint64_t contentHash,
+                         const Archive& archive) const {
+    rwfs::error_code ec;
+    rwfs::create_directories(directory, ec);
+    if (ec) {
+        return false;
+    }
+
+    // Written next to the final file and renamed, so a crash can't leave a
+    // partial file behind that looks complete
+    const auto path = getPath(name, contentHash);
+    auto temporary = path;
+    temporary += ".tmp";
+    {
+        std::ofstream out(temporary.string(), std::ios::binary);
+        if (!out.is_open()) {
+            return false;
+        }
+        out.write(kMagic.data(), kMagic.size());
+        write(out, kVersion);
+        write(out, contentHash);
+        write(out, static_cast<std::uint32_t>(archive.size()));
+        for (const auto& texture : archive) {
+            write(out, static_cast<std::uint32_t>(texture.name.size()));
+            out.write(texture.name.data(),
+                      static_cast<std::streamsize>(texture.name.size()));
+            write(out, static_cast<std::uint8_t>(texture.format));
+            write(out, static_cast<std::uint8_t>(texture.transparent));
+            write(out, texture.magFilter);
+            write(out, texture.wrapS);
+            write(out, texture.wrapT);
+            write(out, static_cast<std::uint32_t>(texture.levels.size()));
+            for (const auto& level : texture.levels) {
+                write(out, level.width);
+                write(out, level.height);
+                write(out, static_cast<std::uint32_t>(level.data.size()));
+                out.write(reinterpret_cast<const char*>(level.data.data()),
+                          static_cast<std::streamsize>(level.data.size()));
+            }
+        }
+        if (!out.good()) {
+            out.close();
+            rwfs::remove(temporary, ec);
+            return false;
+        }
+    }
+    rwfs::rename(temporary, path, ec);
+    if (ec) {
+        rwfs::remove(temporary, ec);
+        return false;
+    }
+
+    // Versions of the archive with other contents won't be read again
+    const auto fileName = path.filename().string();
+    const auto prefix = sanitize(name) + "-";
+    std::vector<rwfs::path> stale;
+    for (const auto& entry : rwfs::directory_iterator(directory, ec)) {
+        const auto other = entry.path().filename().string();
+        if (other != fileName && other.size() == fileName.size() &&
+            other.compare(0, prefix.size(), prefix) == 0 &&
+            entry.path().extension() == kExtension) {
+            stale.push_back(entry.path());
+        }
+    }
+    for (const auto& file : stale) {
+        rwfs::remove(file, ec);
+    }
+    return true;
+}
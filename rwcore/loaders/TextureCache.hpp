@@ -0,0 +1,66 @@
+#ifndef _LIBRW_TEXTURECACHE_HPP_
+#define _LIBRW_TEXTURECACHE_HPP_
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include <gl/BlockCompression.hpp>
+#include <rw/filesystem.hpp>
+
+/**
+ * Block compressed copies of texture archives, stored on disk
+ *
+ * Each archive is converted once and written to the cache directory, keyed by
+ * its name and a hash of the original file. Later loads read the compressed
+ * mip chains back and skip decoding and compressing. Files that don't match
+ * the hash or are damaged are ignored and rewritten.
+ */
+class TextureCache {
+public:
+    struct Texture {
+        std::string name;
+        BlockCompression::Format format = BlockCompression::Format::BC1;
+        bool transparent = false;
+        /// GL sampler parameters
+        std::uint32_t magFilter = 0;
+        std::uint32_t wrapS = 0;
+        std::uint32_t wrapT = 0;
+        std::vector<BlockCompression::Level> levels;
+    };
+    using Archive = std::vector<Texture>;
+
+    explicit TextureCache(rwfs::path directory);
+
+    /**
+     * @return FNV-1a hash of the data, used to detect changed archives
+     */
+    static std::uint64_t hash(const char* data, size_t length);
+
+    /**
+     * Reads the cached archive
+     * @return false if it isn't in the cache or doesn't match contentHash
+     */
+    bool load(const std::string& name, std::uint64_t contentHash,
+              Archive& archive) const;
+
+    /**
+     * Writes the archive to the cache, replacing older versions
+     * @return false if the file couldn't be written
+     */
+    bool store(const std::string& name, std::uint64_t contentHash,
+               const Archive& archive) const;
+
+    rwfs::path getPath(const std::string& name,
+                       std::uint64_t contentHash) const;
+
+    const rwfs::path& getDirectory() const {
+        return directory;
+    }
+
+private:
+    rwfs::path directory;
+};
+
+#endif
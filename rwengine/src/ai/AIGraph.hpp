@@ -8,6 +8,8 @@
 #include <array>
 #include <vector>
 
+#include "core/FrameArena.hpp"
+
 struct PathData;
 
 namespace ai {
@@ -37,7 +39,7 @@ public:
                          PathData& path);
 
     void gatherExternalNodesNear(const glm::vec3& center, const float radius,
-                                 std::vector<AIGraphNode*>& nodes, NodeType type);
+                                 FrameVector<AIGraphNode*>& nodes, NodeType type);
 };
 
 } // ai
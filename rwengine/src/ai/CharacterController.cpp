@@ -23,6 +23,7 @@
 
 #include "ai/CharacterController.hpp"
 #include "ai/AIGraphNode.hpp"
+#include "core/FrameArena.hpp"
 #include "data/WeaponData.hpp"
 #include "engine/Animator.hpp"
 #include "engine/GameData.hpp"
@@ -238,7 +239,8 @@ bool Activities::DriveTo::update(CharacterObject *character,
     glm::vec3 roadTarget;
 
     // A list of nodes we can choose from
-    std::vector<AIGraphNode*> potentialNodes = targetNode->connections;
+    FrameVector<AIGraphNode*> potentialNodes(targetNode->connections.begin(),
+                                             targetNode->connections.end());
 
     // Make sure that we have a lastTargetNode
     if (lastTargetNode == nullptr) {
@@ -322,6 +324,12 @@ bool Activities::DriveTo::update(CharacterObject *character,
         currentSpeed = intersectionSpeed;
     }
 
+    // Far away traffic follows the road without physics or obstacle checks
+    if (vehicle->isKinematic()) {
+        vehicle->setKinematicTarget(roadTarget, currentSpeed);
+        return false;
+    }
+
     // Check whether a pedestrian or vehicle is in our way
     if (controller->checkForObstacles()) {
         currentSpeed = 0.f;
@@ -72,6 +72,11 @@ bool PlayerController::isMissionRestartRequired() const {
     return missionRestartRequired;
 }
 
+void PlayerController::cancelRestart() {
+    missionRestartRequired = false;
+    restartState = Alive;
+}
+
 bool PlayerController::isWasted() const {
     return character->isDead();
 }
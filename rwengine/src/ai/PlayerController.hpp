@@ -62,6 +62,11 @@ public:
 
     bool isMissionRestartRequired() const;
 
+    /**
+     * Stops a restart after being wasted, busted or failing a mission
+     */
+    void cancelRestart();
+
     bool isWasted() const;
     // @todo not implemented yet
     bool isBusted() const;
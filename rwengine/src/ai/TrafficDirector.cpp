@@ -31,9 +31,9 @@ TrafficDirector::TrafficDirector(AIGraph* g, GameWorld* w)
     , world(w) {
 }
 
-std::vector<ai::AIGraphNode*> TrafficDirector::findAvailableNodes(
+FrameVector<ai::AIGraphNode*> TrafficDirector::findAvailableNodes(
     ai::NodeType type, const ViewCamera& camera, float radius) {
-    std::vector<ai::AIGraphNode*> available;
+    FrameVector<ai::AIGraphNode*> available;
     available.reserve(20);
 
     graph->gatherExternalNodesNear(camera.position, radius, available, type);
@@ -132,7 +132,7 @@ std::vector<GameObject*> TrafficDirector::populateNearby(
     }
 
     // Hardcoded cop Pedestrian
-    std::vector<uint16_t> peds = {1};
+    FrameVector<uint16_t> peds = {1};
 
     // Determine which zone the viewpoint is in
     auto zone = world->data->findZoneAt(camera.position);
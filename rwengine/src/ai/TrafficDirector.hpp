@@ -3,6 +3,8 @@
 
 #include <vector>
 
+#include "core/FrameArena.hpp"
+
 class GameWorld;
 class GameObject;
 class ViewCamera;
@@ -17,7 +19,7 @@ class TrafficDirector {
 public:
     TrafficDirector(AIGraph* graph, GameWorld* world);
 
-    std::vector<AIGraphNode*> findAvailableNodes(NodeType type,
+    FrameVector<AIGraphNode*> findAvailableNodes(NodeType type,
                                                  const ViewCamera& camera,
                                                  float radius);
 
@@ -0,0 +1,92 @@
+#include "core/FrameArena.hpp"
+
+#include <algorithm>
+
+#include <rw/debug.hpp>
+
+FrameArena::FrameArena(size_t blockSize) : blockSize(blockSize) {
+}
+
+FrameArena& FrameArena::forThread() {
+    static thread_local FrameArena arena;
+    return arena;
+}
+
+void* FrameArena::allocate(size_t size, size_t alignment) {
+    RW_ASSERT(alignment > 0 && (alignment & (alignment - 1)) == 0);
+    size = std::max(size, size_t{1});
+
+    for (;;) {
+        if (current < blocks.size()) {
+            auto& block = blocks[current];
+            const auto address =
+                reinterpret_cast<std::uintptr_t>(block.data.get()) + offset;
+            const auto padding = (alignment - address % alignment) % alignment;
+            if (offset + padding + size <= block.size) {
+                offset += padding + size;
+                live++;
+                allocations++;
+                return block.data.get() + offset - size;
+            }
+            if (current + 1 < blocks.size()) {
+                current++;
+                offset = 0;
+                continue;
+            }
+        }
+        // Large requests get a block of their own
+        addBlock(std::max(blockSize, size + alignment));
+        current = blocks.size() - 1;
+        offset = 0;
+    }
+}
+
+void FrameArena::deallocate(void* p, size_t size) {
+    RW_UNUSED(p);
+    RW_UNUSED(size);
+    RW_CHECK(live > 0, "Freed more than was allocated");
+    if (live == 0) {
+        return;
+    }
+    if (--live == 0) {
+        rewind();
+    }
+}
+
+void FrameArena::reset() {
+    RW_CHECK(live == 0, "Frame allocations outlived the frame");
+    allocations = 0;
+    heapAllocations = 0;
+}
+
+size_t FrameArena::getBytesUsed() const {
+    size_t used = offset;
+    for (size_t i = 0; i < current && i < blocks.size(); ++i) {
+        used += blocks[i].size;
+    }
+    return used;
+}
+
+size_t FrameArena::getCapacity() const {
+    size_t capacity = 0;
+    for (const auto& block : blocks) {
+        capacity += block.size;
+    }
+    return capacity;
+}
+
+void FrameArena::addBlock(size_t size) {
+    blocks.push_back({std::make_unique<std::byte[]>(size), size});
+    heapAllocations++;
+}
+
+void FrameArena::rewind() {
+    // Merge the blocks, so the next frame fits into one
+    if (blocks.size() > 1) {
+        const auto capacity = getCapacity();
+        blocks.clear();
+        addBlock(capacity);
+    }
+    current = 0;
+    offset = 0;
+}
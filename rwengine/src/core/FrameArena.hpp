@@ -0,0 +1,138 @@
+#ifndef _RWENGINE_FRAMEARENA_HPP_
+#define _RWENGINE_FRAMEARENA_HPP_
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <type_traits>
+#include <vector>
+
+/**
+ * Linear allocator for data that doesn't outlive the frame
+ *
+ * Allocating bumps a pointer through large blocks, and freeing only counts
+ * down the live allocations. Once everything has been freed the arena starts
+ * again from the beginning, so a frame that builds and drops the same
+ * containers reuses the same memory without touching the heap. When a block
+ * fills up another is added, and the blocks are merged into one the next
+ * time the arena is empty, so after a few frames the arena is big enough for
+ * everything a frame needs.
+ *
+ * Each thread has its own arena, see forThread(). Memory must be freed on
+ * the thread that allocated it.
+ */
+class FrameArena {
+public:
+    static constexpr size_t kDefaultBlockSize = 1024 * 1024;
+
+    explicit FrameArena(size_t blockSize = kDefaultBlockSize);
+
+    FrameArena(const FrameArena&) = delete;
+    FrameArena& operator=(const FrameArena&) = delete;
+
+    /**
+     * @return The arena of the calling thread
+     */
+    static FrameArena& forThread();
+
+    void* allocate(size_t size, size_t alignment);
+    void deallocate(void* p, size_t size);
+
+    /**
+     * Starts counting the allocations of a new frame. Everything from the
+     * previous frame must have been freed
+     */
+    void reset();
+
+    /// Allocations served since the last reset
+    size_t getAllocationCount() const {
+        return allocations;
+    }
+
+    /// Blocks taken from the heap since the last reset
+    size_t getHeapAllocationCount() const {
+        return heapAllocations;
+    }
+
+    /// Allocations that haven't been freed yet
+    size_t getLiveCount() const {
+        return live;
+    }
+
+    size_t getBytesUsed() const;
+    size_t getCapacity() const;
+
+private:
+    struct Block {
+        std::unique_ptr<std::byte[]> data;
+        size_t size;
+    };
+
+    void addBlock(size_t size);
+    void rewind();
+
+    size_t blockSize;
+    std::vector<Block> blocks;
+    /// The block being allocated from, and the offset into it
+    size_t current = 0;
+    size_t offset = 0;
+
+    size_t live = 0;
+    size_t allocations = 0;
+    size_t heapAllocations = 0;
+};
+
+/**
+ * Standard allocator that takes memory from a FrameArena
+ *
+ * Containers use the arena of the thread that creates them, unless given
+ * one.
+ */
+template <class T>
+class FrameAllocator {
+public:
+    using value_type = T;
+    using propagate_on_container_move_assignment = std::true_type;
+    using propagate_on_container_swap = std::true_type;
+
+    FrameAllocator() noexcept : arena(&FrameArena::forThread()) {
+    }
+
+    explicit FrameAllocator(FrameArena& arena) noexcept : arena(&arena) {
+    }
+
+    template <class U>
+    FrameAllocator(const FrameAllocator<U>& other) noexcept
+        : arena(other.getArena()) {
+    }
+
+    T* allocate(size_t n) {
+        return static_cast<T*>(arena->allocate(n * sizeof(T), alignof(T)));
+    }
+
+    void deallocate(T* p, size_t n) noexcept {
+        arena->deallocate(p, n * sizeof(T));
+    }
+
+    FrameArena* getArena() const {
+        return arena;
+    }
+
+private:
+    FrameArena* arena;
+};
+
+template <class T, class U>
+bool operator==(const FrameAllocator<T>& a, const FrameAllocator<U>& b) {
+    return a.getArena() == b.getArena();
+}
+
+template <class T, class U>
+bool operator!=(const FrameAllocator<T>& a, const FrameAllocator<U>& b) {
+    return !(a == b);
+}
+
+template <class T>
+using FrameVector = std::vector<T, FrameAllocator<T>>;
+
+#endif
@@ -0,0 +1,25 @@
+#ifndef _RWENGINE_HEAPCOUNTER_HPP_
+#define _RWENGINE_HEAPCOUNTER_HPP_
+
+#include <cstddef>
+
+/**
+ * Counts heap allocations made through the global operator new
+ *
+ * Linking HeapCounter.cpp replaces operator new and delete with versions
+ * that count the calls and forward to malloc and free. Aligned allocations
+ * aren't counted.
+ *
+ * The count costs an atomic add per allocation, so HeapCounter.cpp isn't
+ * part of rwengine. Only rwgame and rwtests link it.
+ */
+class HeapCounter {
+public:
+    /**
+     * @return The number of allocations since the program started, from
+     * every thread
+     */
+    static size_t getAllocationCount();
+};
+
+#endif
@@ -1,41 +1,196 @@
 #include <core/Logger.hpp>
 
 #include <algorithm>
+#include <charconv>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
 #include <iostream>
-#include <map>
 
-void Logger::log(const std::string& component, Logger::MessageSeverity severity,
-                 const std::string& message) {
-    LogMessage m{component, severity, message};
+namespace {
+static_assert((Logger::kQueueCapacity & (Logger::kQueueCapacity - 1)) == 0,
+              "The queue capacity must be a power of two");
+constexpr size_t kQueueMask = Logger::kQueueCapacity - 1;
 
-    for (MessageReceiver* r : receivers) {
-        r->messageReceived(m);
+/// In case a wake up is missed, the background thread checks this often
+constexpr auto kMaxSleep = std::chrono::milliseconds(100);
+
+std::ptrdiff_t difference(size_t a, size_t b) {
+    return static_cast<std::ptrdiff_t>(a - b);
+}
+}  // namespace
+
+template <size_t Capacity>
+void Logger::Text<Capacity>::append(std::string_view s) {
+    const auto count = std::min(s.size(), Capacity - length);
+    std::memcpy(data.data() + length, s.data(), count);
+    length += count;
+    if (count < s.size() && Capacity > 3) {
+        std::memcpy(data.data() + Capacity - 3, "...", 3);
     }
 }
 
-void Logger::addReceiver(Logger::MessageReceiver* out) {
-    receivers.push_back(out);
+template <size_t Capacity>
+void Logger::Text<Capacity>::append(long long value) {
+    std::array<char, 24> buffer;
+    const auto result =
+        std::to_chars(buffer.data(), buffer.data() + buffer.size(), value);
+    append(std::string_view(buffer.data(),
+                            static_cast<size_t>(result.ptr - buffer.data())));
 }
 
-void Logger::removeReceiver(Logger::MessageReceiver* out) {
-    receivers.erase(std::remove(receivers.begin(), receivers.end(), out),
-                    receivers.end());
+template <size_t Capacity>
+void Logger::Text<Capacity>::append(unsigned long long value) {
+    std::array<char, 24> buffer;
+    const auto result =
+        std::to_chars(buffer.data(), buffer.data() + buffer.size(), value);
+    append(std::string_view(buffer.data(),
+                            static_cast<size_t>(result.ptr - buffer.data())));
+}
+
+template <size_t Capacity>
+void Logger::Text<Capacity>::append(double value) {
+    std::array<char, 32> buffer;
+    const auto written =
+        std::snprintf(buffer.data(), buffer.size(), "%g", value);
+    if (written > 0) {
+        append(std::string_view(
+            buffer.data(),
+            std::min(static_cast<size_t>(written), buffer.size() - 1)));
+    }
 }
 
-void Logger::error(const std::string& component, const std::string& message) {
-    log(component, Logger::Error, message);
+template struct Logger::Text<Logger::kMaxComponentLength>;
+template struct Logger::Text<Logger::kMaxMessageLength>;
+
+Logger::Logger(std::initializer_list<MessageReceiver*> initial)
+    : slots(std::make_unique<Slot[]>(kQueueCapacity)), receivers(initial) {
+    for (size_t i = 0; i < kQueueCapacity; ++i) {
+        slots[i].sequence.store(i, std::memory_order_relaxed);
+    }
+    thread = std::thread(&Logger::run, this);
 }
 
-void Logger::info(const std::string& component, const std::string& message) {
-    log(component, Logger::Info, message);
+Logger::~Logger() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    wakeCondition.notify_one();
+    thread.join();
 }
 
-void Logger::warning(const std::string& component, const std::string& message) {
-    log(component, Logger::Warning, message);
+void Logger::push(const Message& message) {
+    // A bounded queue where writers claim a position, then publish the slot
+    // by advancing its sequence
+    auto position = writePosition.load(std::memory_order_relaxed);
+    Slot* slot = nullptr;
+    for (;;) {
+        slot = &slots[position & kQueueMask];
+        const auto sequence = slot->sequence.load(std::memory_order_acquire);
+        const auto diff = difference(sequence, position);
+        if (diff == 0) {
+            if (writePosition.compare_exchange_weak(
+                    position, position + 1, std::memory_order_relaxed)) {
+                break;
+            }
+        } else if (diff < 0) {
+            // Full, wait for the background thread to catch up
+            wake();
+            std::this_thread::yield();
+            position = writePosition.load(std::memory_order_relaxed);
+        } else {
+            position = writePosition.load(std::memory_order_relaxed);
+        }
+    }
+
+    slot->message = message;
+    slot->sequence.store(position + 1, std::memory_order_release);
+
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (waiting.load(std::memory_order_relaxed)) {
+        wake();
+    }
 }
 
-void Logger::verbose(const std::string& component, const std::string& message) {
-    log(component, Logger::Verbose, message);
+bool Logger::pop(Message& message) {
+    auto& slot = slots[readPosition & kQueueMask];
+    const auto sequence = slot.sequence.load(std::memory_order_acquire);
+    if (difference(sequence, readPosition + 1) < 0) {
+        return false;
+    }
+    message = slot.message;
+    slot.sequence.store(readPosition + kQueueCapacity,
+                        std::memory_order_release);
+    readPosition++;
+    return true;
+}
+
+bool Logger::hasMessages() const {
+    const auto& slot = slots[readPosition & kQueueMask];
+    return difference(slot.sequence.load(std::memory_order_acquire),
+                      readPosition + 1) >= 0;
+}
+
+void Logger::wake() {
+    std::lock_guard<std::mutex> lock(mutex);
+    wakeCondition.notify_one();
+}
+
+void Logger::run() {
+    Message message;
+    for (;;) {
+        size_t count = 0;
+        {
+            std::lock_guard<std::mutex> lock(receiversMutex);
+            while (pop(message)) {
+                // Strings are only built here, off the logging thread
+                const LogMessage m{std::string(message.component.view()),
+                                   message.severity,
+                                   std::string(message.text.view())};
+                for (MessageReceiver* r : receivers) {
+                    r->messageReceived(m);
+                }
+                count++;
+            }
+        }
+
+        std::unique_lock<std::mutex> lock(mutex);
+        if (count > 0) {
+            delivered.fetch_add(count, std::memory_order_release);
+            flushCondition.notify_all();
+        }
+
+        waiting.store(true, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (!hasMessages()) {
+            if (stopping) {
+                break;
+            }
+            wakeCondition.wait_for(lock, kMaxSleep);
+        }
+        waiting.store(false, std::memory_order_relaxed);
+    }
+}
+
+void Logger::flush() {
+    const auto target = writePosition.load(std::memory_order_acquire);
+    wake();
+    std::unique_lock<std::mutex> lock(mutex);
+    flushCondition.wait(lock, [&] {
+        return delivered.load(std::memory_order_acquire) >= target;
+    });
+}
+
+void Logger::addReceiver(Logger::MessageReceiver* out) {
+    std::lock_guard<std::mutex> lock(receiversMutex);
+    receivers.push_back(out);
+}
+
+void Logger::removeReceiver(Logger::MessageReceiver* out) {
+    std::lock_guard<std::mutex> lock(receiversMutex);
+    receivers.erase(std::remove(receivers.begin(), receivers.end(), out),
+                    receivers.end());
 }
 
 void StdOutReceiver::messageReceived(const Logger::LogMessage& message) {
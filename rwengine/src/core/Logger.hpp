@@ -2,21 +2,57 @@
 #define _RWENGINE_LOGGER_HPP_
 
 #include <array>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
 #include <initializer_list>
+#include <memory>
+#include <mutex>
 #include <string>
+#include <string_view>
+#include <thread>
+#include <type_traits>
 #include <utility>
 #include <vector>
 
+/**
+ * Messages less severe than this aren't compiled in, see Logger::kMinSeverity
+ */
+#ifndef RW_LOG_MIN_SEVERITY
+#define RW_LOG_MIN_SEVERITY 0
+#endif
+
 /**
  * Handles and stores messages from different components
  *
- * Dispatches received messages to logger outputs.
+ * Messages are formatted into a fixed size ring buffer by the thread that
+ * logs them, and a background thread dispatches them to the logger outputs.
+ * The arguments of a message are only formatted if its severity is enabled,
+ * so pass them separately instead of concatenating them:
+ *
+ *     logger->error("Data", "Failed to load model ", id, " [", name, "]");
+ *
+ * Any thread can log. Receivers are called on the background thread, and
+ * must not log themselves.
  */
 class Logger {
 public:
     enum MessageSeverity { Verbose = 0, Info, Warning, Error};
     static constexpr std::array<char, 4> messageSeverityName{{'V', 'I', 'W', 'E'}};
 
+    /// Messages below this severity compile to nothing
+    static constexpr MessageSeverity kMinSeverity =
+        static_cast<MessageSeverity>(RW_LOG_MIN_SEVERITY);
+
+    /// Messages that can be waiting for the background thread. Logging
+    /// waits for space when the buffer is full
+    static constexpr size_t kQueueCapacity = 512;
+
+    /// Longer components and messages are truncated
+    static constexpr size_t kMaxComponentLength = 31;
+    static constexpr size_t kMaxMessageLength = 479;
+
     struct LogMessage {
         /// The component that produced the message
         std::string component;
@@ -43,23 +79,138 @@ public:
         virtual void messageReceived(const LogMessage&) = 0;
     };
 
-    Logger(std::initializer_list<MessageReceiver*> initial = {})
-        : receivers(initial) {
-    }
+    Logger(std::initializer_list<MessageReceiver*> initial = {});
+
+    /**
+     * Delivers the remaining messages before returning
+     */
+    ~Logger();
+
+    Logger(const Logger&) = delete;
+    Logger& operator=(const Logger&) = delete;
 
     void addReceiver(MessageReceiver* out);
     void removeReceiver(MessageReceiver* out);
 
-    void log(const std::string& component, Logger::MessageSeverity severity,
-             const std::string& message);
+    template <class... Args>
+    void log(std::string_view component, MessageSeverity severity,
+             const Args&... args) {
+        if (severity < kMinSeverity) {
+            return;
+        }
+        Message message;
+        message.severity = severity;
+        message.component.append(component);
+        (appendArg(message.text, args), ...);
+        push(message);
+    }
+
+    template <class... Args>
+    void verbose(std::string_view component, const Args&... args) {
+        if constexpr (Verbose >= kMinSeverity) {
+            log(component, Verbose, args...);
+        }
+    }
+
+    template <class... Args>
+    void info(std::string_view component, const Args&... args) {
+        if constexpr (Info >= kMinSeverity) {
+            log(component, Info, args...);
+        }
+    }
+
+    template <class... Args>
+    void warning(std::string_view component, const Args&... args) {
+        if constexpr (Warning >= kMinSeverity) {
+            log(component, Warning, args...);
+        }
+    }
+
+    template <class... Args>
+    void error(std::string_view component, const Args&... args) {
+        if constexpr (Error >= kMinSeverity) {
+            log(component, Error, args...);
+        }
+    }
 
-    void verbose(const std::string& component, const std::string& message);
-    void info(const std::string& component, const std::string& message);
-    void warning(const std::string& component, const std::string& message);
-    void error(const std::string& component, const std::string& message);
+    /**
+     * Waits until every message logged so far has been delivered
+     */
+    void flush();
 
 private:
+    /**
+     * Fixed size text that truncates when full
+     */
+    template <size_t Capacity>
+    struct Text {
+        std::array<char, Capacity> data;
+        size_t length = 0;
+
+        void append(std::string_view s);
+        void append(long long value);
+        void append(unsigned long long value);
+        void append(double value);
+
+        std::string_view view() const {
+            return {data.data(), length};
+        }
+    };
+
+    struct Message {
+        MessageSeverity severity;
+        Text<kMaxComponentLength> component;
+        Text<kMaxMessageLength> text;
+    };
+
+    template <class T>
+    static void appendArg(Text<kMaxMessageLength>& text, const T& arg) {
+        if constexpr (std::is_convertible_v<const T&, std::string_view>) {
+            text.append(std::string_view(arg));
+        } else if constexpr (std::is_same_v<T, char>) {
+            text.append(std::string_view(&arg, 1));
+        } else if constexpr (std::is_same_v<T, bool>) {
+            text.append(arg ? "true" : "false");
+        } else if constexpr (std::is_integral_v<T> && std::is_signed_v<T>) {
+            text.append(static_cast<long long>(arg));
+        } else if constexpr (std::is_integral_v<T>) {
+            text.append(static_cast<unsigned long long>(arg));
+        } else if constexpr (std::is_floating_point_v<T>) {
+            text.append(static_cast<double>(arg));
+        } else {
+            static_assert(std::is_arithmetic_v<T>,
+                          "Convert the argument to a string before logging");
+        }
+    }
+
+    struct Slot {
+        /// Equal to the position it's written at when free, and one past it
+        /// once the message can be read
+        std::atomic<size_t> sequence;
+        Message message;
+    };
+
+    void push(const Message& message);
+    bool pop(Message& message);
+    bool hasMessages() const;
+    void wake();
+    void run();
+
+    std::unique_ptr<Slot[]> slots;
+    std::atomic<size_t> writePosition{0};
+    /// Only used by the background thread
+    size_t readPosition = 0;
+    std::atomic<size_t> delivered{0};
+
+    std::mutex receiversMutex;
     std::vector<MessageReceiver*> receivers;
+
+    std::mutex mutex;
+    std::condition_variable wakeCondition;
+    std::condition_variable flushCondition;
+    std::atomic<bool> waiting{false};
+    bool stopping = false;
+    std::thread thread;
 };
 
 class StdOutReceiver final : public Logger::MessageReceiver {
@@ -0,0 +1,122 @@
+#include "core/Telemetry.hpp"
+
+#include <iomanip>
+
+Telemetry Telemetry::instance;
+
+namespace {
+constexpr std::array<const char*, Telemetry::ScopeCount> kScopeNames{
+    {"Physics", "Script", "AI", "RenderList", "Draw", "Audio"}};
+constexpr std::array<const char*, Telemetry::CounterCount> kCounterNames{
+    {"Objects", "Draws", "Instances", "Culled", "Occluded",
+     "FrameAllocations", "HeapAllocations"}};
+
+double toMilliseconds(std::int64_t ns) {
+    return static_cast<double>(ns) / 1000000.0;
+}
+
+double toMicroseconds(std::int64_t ns) {
+    return static_cast<double>(ns) / 1000.0;
+}
+}  // namespace
+
+Telemetry::Telemetry() : epoch(Clock::now()) {
+}
+
+const char* Telemetry::getScopeName(Scope scope) {
+    return kScopeNames[scope];
+}
+
+const char* Telemetry::getCounterName(Counter counter) {
+    return kCounterNames[counter];
+}
+
+void Telemetry::beginFrame() {
+    const auto now = toNanoseconds(Clock::now());
+    if (started) {
+        frames[head].duration = now - frames[head].start;
+        head = (head + 1) % kFrameCapacity;
+        // One slot is always the frame being recorded
+        if (completed < kFrameCapacity - 1) {
+            completed++;
+        }
+    }
+    frames[head] = Frame{};
+    frames[head].start = now;
+    started = true;
+}
+
+void Telemetry::addSample(Scope scope, Clock::time_point start,
+                          Clock::time_point end) {
+    auto& frame = frames[head];
+    if (frame.scopeTime[scope] == 0) {
+        frame.scopeStart[scope] = toNanoseconds(start);
+    }
+    frame.scopeTime[scope] +=
+        std::chrono::duration_cast<std::chrono::nanoseconds>(end - start)
+            .count();
+}
+
+void Telemetry::clear() {
+    frames[head] = Frame{};
+    completed = 0;
+    started = false;
+}
+
+void Telemetry::writeCSV(std::ostream& out) const {
+    out << "frame,start_ms,frame_ms";
+    for (const auto name : kScopeNames) {
+        out << ',' << name << "_ms";
+    }
+    for (const auto name : kCounterNames) {
+        out << ',' << name;
+    }
+    out << '\n';
+
+    out << std::fixed << std::setprecision(3);
+    for (size_t i = 0; i < completed; ++i) {
+        const auto& frame = getFrame(completed - 1 - i);
+        out << i << ',' << toMilliseconds(frame.start) << ','
+            << toMilliseconds(frame.duration);
+        for (const auto time : frame.scopeTime) {
+            out << ',' << toMilliseconds(time);
+        }
+        for (const auto value : frame.counters) {
+            out << ',' << value;
+        }
+        out << '\n';
+    }
+}
+
+void Telemetry::writeChromeTrace(std::ostream& out) const {
+    // Scopes are written as one event spanning all of their samples in a
+    // frame, starting at the first one
+    const auto event = [&](const char* name, std::int64_t start,
+                           std::int64_t duration) {
+        out << ",\n{\"name\":\"" << name
+            << "\",\"ph\":\"X\",\"pid\":0,\"tid\":0,\"ts\":"
+            << toMicroseconds(start) << ",\"dur\":" << toMicroseconds(duration)
+            << '}';
+    };
+
+    out << std::fixed << std::setprecision(3);
+    out << "{\"traceEvents\":[\n"
+        << "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":0,"
+           "\"args\":{\"name\":\"rwgame\"}}";
+    for (size_t i = 0; i < completed; ++i) {
+        const auto& frame = getFrame(completed - 1 - i);
+        event("Frame", frame.start, frame.duration);
+        for (size_t s = 0; s < ScopeCount; ++s) {
+            if (frame.scopeTime[s] > 0) {
+                event(kScopeNames[s], frame.scopeStart[s], frame.scopeTime[s]);
+            }
+        }
+        for (size_t c = 0; c < CounterCount; ++c) {
+            out << ",\n{\"name\":\"" << kCounterNames[c]
+                << "\",\"ph\":\"C\",\"pid\":0,\"ts\":"
+                << toMicroseconds(frame.start) << ",\"args\":{\"value\":"
+                << frame.counters[c] << "}}";
+        }
+    }
+    out << "\n]}\n";
+}
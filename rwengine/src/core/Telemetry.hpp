@@ -0,0 +1,143 @@
+#ifndef _RWENGINE_TELEMETRY_HPP_
+#define _RWENGINE_TELEMETRY_HPP_
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+
+/**
+ * Frame timings that are always built in, unlike the profiler
+ *
+ * Scope timings and counters for the last kFrameCapacity frames are kept in
+ * a fixed size ring buffer, so recording is a clock read and an addition.
+ * The buffer can be shown in the debug overlay, or written out as CSV or as
+ * a Chrome trace to look into a hitch after the fact.
+ *
+ * Only the main thread records samples.
+ */
+class Telemetry {
+public:
+    enum Scope { Physics, Script, AI, RenderList, Draw, Audio, ScopeCount };
+    enum Counter {
+        Objects,
+        Draws,
+        Instances,
+        Culled,
+        Occluded,
+        FrameAllocations,
+        HeapAllocations,
+        CounterCount
+    };
+
+    /// Ten seconds at 60 frames per second
+    static constexpr size_t kFrameCapacity = 600;
+
+    using Clock = std::chrono::steady_clock;
+
+    struct Frame {
+        /// Start of the frame, in nanoseconds since the telemetry started
+        std::int64_t start = 0;
+        std::int64_t duration = 0;
+        /// Start of the first sample of each scope
+        std::array<std::int64_t, ScopeCount> scopeStart{};
+        /// Total time spent in each scope, nested scopes are included
+        std::array<std::int64_t, ScopeCount> scopeTime{};
+        std::array<std::int64_t, CounterCount> counters{};
+    };
+
+    /**
+     * Adds the time until it goes out of scope to a scope of the frame
+     */
+    class ScopeTimer {
+    public:
+        explicit ScopeTimer(Scope scope) : scope(scope), start(Clock::now()) {
+        }
+
+        ~ScopeTimer() {
+            Telemetry::get().addSample(scope, start, Clock::now());
+        }
+
+        ScopeTimer(const ScopeTimer&) = delete;
+        ScopeTimer& operator=(const ScopeTimer&) = delete;
+
+    private:
+        Scope scope;
+        Clock::time_point start;
+    };
+
+    Telemetry();
+
+    static Telemetry& get() {
+        return instance;
+    }
+
+    static const char* getScopeName(Scope scope);
+    static const char* getCounterName(Counter counter);
+
+    /**
+     * Completes the current frame and starts recording the next one
+     */
+    void beginFrame();
+
+    void addSample(Scope scope, Clock::time_point start,
+                   Clock::time_point end);
+
+    void setCounter(Counter counter, std::int64_t value) {
+        frames[head].counters[counter] = value;
+    }
+
+    /**
+     * @return The number of completed frames that are stored
+     */
+    size_t getFrameCount() const {
+        return completed;
+    }
+
+    /**
+     * @param age 0 for the last completed frame, 1 for the one before it...
+     */
+    const Frame& getFrame(size_t age) const {
+        return frames[(head + kFrameCapacity - 1 - age) % kFrameCapacity];
+    }
+
+    /**
+     * Forgets all recorded frames
+     */
+    void clear();
+
+    /**
+     * Writes one row per completed frame, oldest first, with times in ms
+     */
+    void writeCSV(std::ostream& out) const;
+
+    /**
+     * Writes the completed frames in the Chrome trace event format, which
+     * chrome://tracing and Perfetto can open
+     */
+    void writeChromeTrace(std::ostream& out) const;
+
+private:
+    static Telemetry instance;
+
+    std::int64_t toNanoseconds(Clock::time_point t) const {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(t - epoch)
+            .count();
+    }
+
+    Clock::time_point epoch;
+    std::array<Frame, kFrameCapacity> frames{};
+    /// The frame being recorded
+    size_t head = 0;
+    size_t completed = 0;
+    bool started = false;
+};
+
+#define RW_TELEMETRY_SCOPE(scope) \
+    const Telemetry::ScopeTimer rwTelemetryScope(Telemetry::scope)
+#define RW_TELEMETRY_COUNTER_SET(counter, value) \
+    Telemetry::get().setCounter(Telemetry::counter, \
+                                static_cast<std::int64_t>(value))
+
+#endif
@@ -0,0 +1,103 @@
+#include "data/ZoneGrid.hpp"
+
+#include <glm/common.hpp>
+
+#include <algorithm>
+#include <cmath>
+
+#include "data/ZoneData.hpp"
+
+namespace {
+void appendPostOrder(ZoneData& zone, std::vector<ZoneData*>& out) {
+    for (ZoneData* child : zone.children_) {
+        appendPostOrder(*child, out);
+    }
+    out.push_back(&zone);
+}
+}  // namespace
+
+int ZoneGrid::cellCoord(float p, int axis) const {
+    const auto cell =
+        static_cast<int>(std::floor((p - origin[axis]) / cellSize[axis]));
+    return glm::clamp(cell, 0, kCellsPerAxis - 1);
+}
+
+void ZoneGrid::build(ZoneData& hierarchy) {
+    root = &hierarchy;
+    origin = glm::vec2(root->min);
+    cellSize = glm::max(glm::vec2(root->max) - origin, glm::vec2(1.f)) /
+               static_cast<float>(kCellsPerAxis);
+    cells.assign(kCellsPerAxis * kCellsPerAxis, {});
+
+    update(glm::vec2(root->min), glm::vec2(root->max));
+}
+
+void ZoneGrid::update(const glm::vec2& min, const glm::vec2& max) {
+    if (!root) {
+        return;
+    }
+
+    // Inserting a zone can reorder its siblings, so the order is rebuilt.
+    // Only zones inside the new one move, and those are all in its cells
+    order.clear();
+    appendPostOrder(*root, order);
+
+    fillCells(cellCoord(min.x, 0), cellCoord(min.y, 1), cellCoord(max.x, 0),
+              cellCoord(max.y, 1));
+}
+
+void ZoneGrid::fillCells(int minX, int minY, int maxX, int maxY) {
+    for (int y = minY; y <= maxY; ++y) {
+        for (int x = minX; x <= maxX; ++x) {
+            cells[static_cast<size_t>(y * kCellsPerAxis + x)].clear();
+        }
+    }
+
+    // Zones are listed in each cell they could contain a point of, using the
+    // same rounding as lookups
+    for (ZoneData* zone : order) {
+        const auto zoneMinX = std::max(cellCoord(zone->min.x, 0), minX);
+        const auto zoneMinY = std::max(cellCoord(zone->min.y, 1), minY);
+        const auto zoneMaxX = std::min(cellCoord(zone->max.x, 0), maxX);
+        const auto zoneMaxY = std::min(cellCoord(zone->max.y, 1), maxY);
+        for (int y = zoneMinY; y <= zoneMaxY; ++y) {
+            for (int x = zoneMinX; x <= zoneMaxX; ++x) {
+                cells[static_cast<size_t>(y * kCellsPerAxis + x)].push_back(
+                    zone);
+            }
+        }
+    }
+}
+
+void ZoneGrid::clear() {
+    root = nullptr;
+    order.clear();
+    cells.clear();
+}
+
+const std::vector<ZoneData*>* ZoneGrid::cellAt(const glm::vec3& point) const {
+    // Nothing outside of the root can contain the point
+    if (!root || !root->containsPoint(point)) {
+        return nullptr;
+    }
+    return &cells[static_cast<size_t>(cellCoord(point.y, 1) * kCellsPerAxis +
+                                      cellCoord(point.x, 0))];
+}
+
+ZoneData* ZoneGrid::findLeafAtPoint(const glm::vec3& point) const {
+    const auto cell = cellAt(point);
+    if (!cell) {
+        return nullptr;
+    }
+    for (ZoneData* zone : *cell) {
+        if (zone->containsPoint(point)) {
+            return zone;
+        }
+    }
+    return nullptr;
+}
+
+size_t ZoneGrid::getCandidateCount(const glm::vec3& point) const {
+    const auto cell = cellAt(point);
+    return cell ? cell->size() : 0;
+}
@@ -0,0 +1,64 @@
+#ifndef _RWENGINE_ZONEGRID_HPP_
+#define _RWENGINE_ZONEGRID_HPP_
+
+#include <glm/vec2.hpp>
+#include <glm/vec3.hpp>
+
+#include <cstddef>
+#include <vector>
+
+struct ZoneData;
+
+/**
+ * Finds the same zone as ZoneData::findLeafAtPoint without walking the tree
+ *
+ * The root zone is split into a grid of cells on the XY plane. Each cell
+ * lists the zones that overlap it in the order the tree walk would test
+ * them, children before their parents, so a lookup returns the first zone
+ * in its cell's list that contains the point.
+ */
+class ZoneGrid {
+public:
+    static constexpr int kCellsPerAxis = 64;
+
+    /**
+     * Rebuilds every cell from the zones in a hierarchy
+     */
+    void build(ZoneData& hierarchy);
+
+    /**
+     * Rebuilds the cells overlapping an area, after zones inside it have been
+     * inserted into the hierarchy. The zones must not have moved in memory
+     */
+    void update(const glm::vec2& min, const glm::vec2& max);
+
+    void clear();
+
+    /**
+     * @return The zone hierarchy the grid was built from
+     */
+    const ZoneData* getRoot() const {
+        return root;
+    }
+
+    ZoneData* findLeafAtPoint(const glm::vec3& point) const;
+
+    /**
+     * @return The number of zones listed by the cell containing point
+     */
+    size_t getCandidateCount(const glm::vec3& point) const;
+
+private:
+    int cellCoord(float p, int axis) const;
+    void fillCells(int minX, int minY, int maxX, int maxY);
+    const std::vector<ZoneData*>* cellAt(const glm::vec3& point) const;
+
+    ZoneData* root = nullptr;
+    glm::vec2 origin{};
+    glm::vec2 cellSize{};
+    /// Every zone in the hierarchy, children before their parents
+    std::vector<ZoneData*> order;
+    std::vector<std::vector<ZoneData*>> cells;
+};
+
+#endif
@@ -0,0 +1,166 @@
+#include "dynamics/AreaDamage.hpp"
+
+#ifdef _MSC_VER
+#pragma warning(disable : 4305 5033)
+#endif
+#include <btBulletDynamicsCommon.h>
+#ifdef _MSC_VER
+#pragma warning(default : 4305 5033)
+#endif
+
+#include <glm/common.hpp>
+#include <glm/geometric.hpp>
+
+#include <algorithm>
+
+#include "core/Profiler.hpp"
+
+namespace {
+/**
+ * Collects the game objects with a proxy overlapping the query box
+ */
+struct AreaQueryCallback final : btBroadphaseAabbCallback {
+    std::vector<AreaDamage::Candidate>& found;
+
+    explicit AreaQueryCallback(std::vector<AreaDamage::Candidate>& found)
+        : found(found) {
+    }
+
+    bool process(const btBroadphaseProxy* proxy) override {
+        auto body = static_cast<btCollisionObject*>(proxy->m_clientObject);
+        if (auto object = static_cast<GameObject*>(body->getUserPointer())) {
+            found.push_back({object, body});
+        }
+        return true;
+    }
+};
+
+/**
+ * Records whether the bodies are touching, ignoring the contact margin
+ */
+struct TouchingCallback final : btCollisionWorld::ContactResultCallback {
+    bool touching = false;
+
+    btScalar addSingleResult(btManifoldPoint& point,
+                             const btCollisionObjectWrapper*, int, int,
+                             const btCollisionObjectWrapper*, int,
+                             int) override {
+        touching |= point.getDistance() <= 0.f;
+        return 0.f;
+    }
+};
+
+bool isDamageable(const GameObject* object) {
+    switch (object->type()) {
+        case GameObject::Instance:
+        case GameObject::Vehicle:
+            return true;
+        default:
+            // Characters are found without the broadphase
+            return false;
+    }
+}
+
+btVector3 toBullet(const glm::vec3& v) {
+    return {v.x, v.y, v.z};
+}
+}  // namespace
+
+size_t AreaDamage::apply(btDiscreteDynamicsWorld& world,
+                         const std::vector<GameObject*>& characters) {
+    RW_PROFILE_SCOPE(__func__);
+    if (requests.empty()) {
+        return 0;
+    }
+
+    // Damage can queue more requests, e.g. a car exploding
+    applying.clear();
+    std::swap(applying, requests);
+
+    auto broadphase = world.getBroadphase();
+    hits.clear();
+    for (size_t r = 0; r < applying.size(); ++r) {
+        const auto& request = applying[r];
+        const glm::vec3 extent(request.radius);
+
+        candidates.clear();
+        AreaQueryCallback callback(candidates);
+        broadphase->aabbTest(toBullet(request.center - extent),
+                             toBullet(request.center + extent), callback);
+
+        candidates.erase(
+            std::remove_if(candidates.begin(), candidates.end(),
+                           [&](const Candidate& candidate) {
+                               return candidate.object == request.source ||
+                                      !isDamageable(candidate.object);
+                           }),
+            candidates.end());
+
+        // Objects with more than one body are only damaged once. IDs are only
+        // unique within a type, sorting by both keeps the order the same from
+        // run to run
+        std::sort(candidates.begin(), candidates.end(),
+                  [](const Candidate& a, const Candidate& b) {
+                      if (a.object->type() != b.object->type()) {
+                          return a.object->type() < b.object->type();
+                      }
+                      return a.object->getGameObjectID() <
+                             b.object->getGameObjectID();
+                  });
+
+        // The query box is larger than the sphere, the sphere is tested
+        // against the collision of each body found
+        btSphereShape sphere(request.radius);
+        btCollisionObject query;
+        query.setCollisionShape(&sphere);
+        btTransform transform;
+        transform.setIdentity();
+        transform.setOrigin(toBullet(request.center));
+        query.setWorldTransform(transform);
+
+        for (auto first = candidates.begin(); first != candidates.end();) {
+            const auto object = first->object;
+            const auto last = std::find_if(
+                first, candidates.end(),
+                [&](const Candidate& c) { return c.object != object; });
+            bool inside;
+            if (request.falloff) {
+                inside = glm::distance(request.center, object->getPosition()) <=
+                         request.radius;
+            } else {
+                inside = std::any_of(first, last, [&](const Candidate& c) {
+                    TouchingCallback touching;
+                    world.contactPairTest(&query, c.body, touching);
+                    return touching.touching;
+                });
+            }
+            if (inside) {
+                hits.push_back({r, object});
+            }
+            first = last;
+        }
+
+        for (auto character : characters) {
+            if (character != request.source &&
+                glm::distance(request.center, character->getPosition()) <=
+                    request.radius) {
+                hits.push_back({r, character});
+            }
+        }
+    }
+
+    // Hits are in request order, so damage is applied in the order queued
+    for (const auto& hit : hits) {
+        const auto& request = applying[hit.request];
+        auto damage = request.damage;
+        if (request.falloff) {
+            const auto d =
+                glm::distance(request.center, hit.object->getPosition());
+            damage /= glm::max(d, 1.f);
+        }
+        hit.object->takeDamage(
+            {request.type, request.center, request.center, damage});
+    }
+
+    return hits.size();
+}
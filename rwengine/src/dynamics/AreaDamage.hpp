@@ -0,0 +1,84 @@
+#ifndef _RWENGINE_AREADAMAGE_HPP_
+#define _RWENGINE_AREADAMAGE_HPP_
+
+#include <cstddef>
+#include <vector>
+
+#include <glm/vec3.hpp>
+
+#include <objects/GameObject.hpp>
+
+class btCollisionObject;
+class btDiscreteDynamicsWorld;
+
+/**
+ * Collects damage that affects everything in a radius, e.g. explosions and
+ * melee swings, and applies it all at once.
+ *
+ * Each request is a single AABB query against the broadphase, instead of
+ * looking at every object or adding a ghost object to the world. The boxes
+ * found are then tested against the sphere itself. Characters are checked
+ * by distance instead, since they don't always have a body, e.g. while in a
+ * vehicle.
+ */
+class AreaDamage {
+public:
+    struct Request {
+        GameObject::DamageInfo::DamageType type;
+        glm::vec3 center{};
+        float radius;
+        float damage;
+
+        /// Never damaged by this request. Only compared, so it may have
+        /// been destroyed by the time the request is applied
+        GameObject* source = nullptr;
+
+        /// Only damage objects whose origin is inside the radius, scaling
+        /// the damage down with distance. Otherwise objects are damaged if
+        /// any of their collision touches the sphere
+        bool falloff = false;
+    };
+
+    void queue(const Request& request) {
+        requests.push_back(request);
+    }
+
+    size_t getQueuedCount() const {
+        return requests.size();
+    }
+
+    /**
+     * Applies all queued requests. Requests queued while applying damage are
+     * kept for the next call
+     *
+     * @param characters Every character in the world
+     * @return The number of objects damaged
+     */
+    size_t apply(btDiscreteDynamicsWorld& world,
+                 const std::vector<GameObject*>& characters);
+
+    void clear() {
+        requests.clear();
+    }
+
+    /// A body found by the broadphase query
+    struct Candidate {
+        GameObject* object;
+        btCollisionObject* body;
+    };
+
+private:
+    struct Hit {
+        size_t request;
+        GameObject* object;
+    };
+
+    std::vector<Request> requests;
+
+    // Kept between calls to avoid allocating each frame
+    std::vector<Request> applying;
+    std::vector<Candidate> candidates;
+    std::vector<Hit> hits;
+};
+
+#endif
@@ -7,6 +7,8 @@
 #include <vector>
 #include <memory>
 
+#include "core/FrameArena.hpp"
+
 class btDiscreteDynamicsWorld;
 class btCollisionObject;
 class GameObject;
@@ -20,7 +22,7 @@ public:
         btCollisionObject* body;
         GameObject* object;
     };
-    using TestResult = std::vector<Hit>;
+    using TestResult = FrameVector<Hit>;
 
     explicit HitTest(btDiscreteDynamicsWorld& world)
         : _world(world)
@@ -28,12 +28,13 @@ void Animator::tick(float dt) {
         if (state.animation == nullptr) continue;
 
         if (state.boneInstances.empty()) {
+            state.boneInstances.reserve(state.animation->bones.size());
             for (auto& [name, bone] : state.animation->bones) {
                 auto frame = model->findFrame(name);
-                if (!frame) {
+                if (!frame || bone.frames.empty()) {
                     continue;
                 }
-                state.boneInstances.emplace(&bone, frame);
+                state.boneInstances.push_back({&bone, frame, 0});
             }
         }
 
@@ -46,9 +47,8 @@ void Animator::tick(float dt) {
             animTime = std::fmod(animTime, state.animation->duration);
         }
 
-        for (auto& [bonePtr, frame] : state.boneInstances) {
-            if (bonePtr->frames.empty()) continue;
-            auto kf = bonePtr->getInterpolatedKeyframe(animTime);
+        for (auto& [bonePtr, frame, cursor] : state.boneInstances) {
+            auto kf = bonePtr->getInterpolatedKeyframe(animTime, cursor);
 
             BoneTransform xform;
             xform.rotation = kf.rotation;
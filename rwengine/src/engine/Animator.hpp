@@ -4,7 +4,6 @@
 #include <rw/debug.hpp>
 #include <rw/forward.hpp>
 
-#include <map>
 #include <vector>
 
 struct AnimationBone;
@@ -21,6 +20,16 @@ class ModelFrame;
  * The Animator will blend all active animations together.
  */
 class Animator {
+    /**
+     * @brief Links an animation bone to the frame it moves
+     */
+    struct BoneBinding {
+        AnimationBone* bone;
+        ModelFrame* frame;
+        /// Keyframe found by the last lookup, where the next one starts
+        size_t cursor;
+    };
+
     /**
      * @brief The AnimationState struct stores information about playing
      * animations
@@ -33,7 +42,8 @@ class Animator {
         float speed;
         /// Automatically restart
         bool repeat;
-        std::map<AnimationBone*, ModelFrame*> boneInstances;
+        /// Resolved on the first tick, so frame names are only looked up once
+        std::vector<BoneBinding> boneInstances;
     };
 
     /**
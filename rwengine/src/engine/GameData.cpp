@@ -2,6 +2,7 @@
 
 #include <algorithm>
 #include <cctype>
+#include <chrono>
 #include <cmath>
 #include <cstdlib>
 #include <fstream>
@@ -33,8 +34,18 @@
 #include "loaders/LoaderGXT.hpp"
 #include "platform/FileIndex.hpp"
 
+namespace {
+// Sized so the static world fits in a handful of arenas
+constexpr size_t kArenaVertices = 512 * 1024;
+constexpr size_t kArenaIndices = 3 * kArenaVertices;
+}  // namespace
+
 GameData::GameData(Logger* log, const rwfs::path& path)
-    : datpath(path), logger(log) {
+    : datpath(path)
+    , logger(log)
+    , geometryArenas(sizeof(GeometryVertex),
+                     GeometryVertex::vertex_attributes(), kArenaVertices,
+                     kArenaIndices) {
     dffLoader.setTextureLookupCallback(
         [&](const std::string& texture, const std::string&) {
             return findSlotTexture(currenttextureslot, texture);
@@ -72,6 +83,7 @@ void GameData::load() {
     // Clear existing zones
     gamezones = ZoneDataList{
         {"CITYZON", 0, {-4000.f, -4000.f, -500.f}, {4000.f, 4000.f, 500.f}, 0, 0, 0}};
+    zoneGrid.build(gamezones[0]);
 
     loadLevelFile("data/default.dat");
     loadLevelFile("data/gta3.dat");
@@ -85,7 +97,7 @@ void GameData::loadLevelFile(const std::string& path) {
     std::ifstream datfile(datpath.string());
 
     if (!datfile.is_open()) {
-        logger->error("Data", "Failed to open game file " + path);
+        logger->error("Data", "Failed to open game file ", path);
         return;
     }
 
@@ -143,7 +155,7 @@ void GameData::loadIDE(const std::string& path) {
         std::move(idel.objects.begin(), idel.objects.end(),
                   std::inserter(modelinfo, modelinfo.end()));
     } else {
-        logger->error("Data", "Failed to load IDE " + path);
+        logger->error("Data", "Failed to load IDE ", path);
     }
 }
 
@@ -181,7 +193,7 @@ void GameData::loadCOL(const size_t zone, const std::string& name) {
             auto id = findModelObject(c->name);
             auto model = modelinfo.find(id);
             if (model == modelinfo.end()) {
-                logger->error("Data", "no model for collsion " + c->name);
+                logger->error("Data", "no model for collsion ", c->name);
                 continue;
             }
             model->second->setCollisionModel(c);
@@ -203,10 +215,17 @@ bool GameData::loadZone(const std::string& path) {
 
     // Load the zones
     if (!ipll.load(path)) {
-        logger->error("Data", "Failed to load zones from " + path);
+        logger->error("Data", "Failed to load zones from ", path);
         return false;
     }
 
+    if (ipll.zones.empty()) {
+        return true;
+    }
+
+    // The grid can only be updated in place if the zones don't move
+    const auto first = gamezones.size();
+    const bool moved = gamezones.capacity() < first + ipll.zones.size();
     gamezones.insert(gamezones.end(), ipll.zones.begin(), ipll.zones.end());
 
     // Build zone hierarchy
@@ -218,9 +237,40 @@ bool GameData::loadZone(const std::string& path) {
         gamezones[0].insertZone(zone);
     }
 
+    if (moved || first == 0 || zoneGrid.getRoot() != &gamezones[0]) {
+        zoneGrid.build(gamezones[0]);
+    } else {
+        // Only the cells covered by the new zones change
+        glm::vec2 min(gamezones[first].min);
+        glm::vec2 max(gamezones[first].max);
+        for (auto i = first; i < gamezones.size(); ++i) {
+            min = glm::min(min, glm::vec2(gamezones[i].min));
+            max = glm::max(max, glm::vec2(gamezones[i].max));
+        }
+        zoneGrid.update(min, max);
+    }
+
     return true;
 }
 
+void GameData::buildZoneHierarchy() {
+    for (ZoneData& zone : gamezones) {
+        zone.children_.clear();
+        zone.parent_ = nullptr;
+    }
+    if (gamezones.empty()) {
+        zoneGrid.clear();
+        return;
+    }
+    for (ZoneData& zone : gamezones) {
+        if (&zone == &gamezones.front()) {
+            continue;
+        }
+        gamezones[0].insertZone(zone);
+    }
+    zoneGrid.build(gamezones[0]);
+}
+
 enum ColSection {
     Unknown,
     COL,
@@ -372,17 +422,16 @@ void GameData::loadTXD(const std::string& name) {
 TextureArchive GameData::loadTextureArchive(const std::string& name) {
     RW_PROFILE_COUNTER_ADD("loadTextureArchive", 1);
     /// @todo refactor loadTXD to use correct file locations
-    auto file = index.openFile(name);
+    auto file = openFile(name);
     if (!file.data) {
-        logger->error("Data", "Failed to open txd: " + name);
+        logger->error("Data", "Failed to open txd: ", name);
         return {};
     }
 
     TextureArchive textures;
 
-    TextureLoader l;
-    if (!l.loadFromMemory(file, textures)) {
-        logger->error("Data", "Error loading txd: " + name);
+    if (!textureLoader.loadFromMemory(file, textures, name)) {
+        logger->error("Data", "Error loading txd: ", name);
         return {};
     }
 
@@ -395,12 +444,11 @@ void GameData::loadToTextureArchive(const std::string& name,
     /// @todo refactor loadTXD to use correct file locations
     auto file = index.openFile(name);
     if (!file.data) {
-        logger->error("Data", "Failed to open txd: " + name);
+        logger->error("Data", "Failed to open txd: ", name);
     }
 
-    TextureLoader l;
-    if (!l.loadFromMemory(file, archive)) {
-        logger->error("Data", "Error loading txd: " + name);
+    if (!textureLoader.loadFromMemory(file, archive, name)) {
+        logger->error("Data", "Error loading txd: ", name);
     }
 }
 
@@ -415,12 +463,12 @@ void GameData::getNameAndLod(std::string& name, int& lod) {
 ClumpPtr GameData::loadClump(const std::string& name) {
     auto file = index.openFile(name);
     if (!file.data) {
-        logger->error("Data", "Failed to load model " + name);
+        logger->error("Data", "Failed to load model ", name);
         return nullptr;
     }
     auto m = dffLoader.loadFromMemory(file);
     if (!m) {
-        logger->error("Data", "Error loading model file " + name);
+        logger->error("Data", "Error loading model file ", name);
         return nullptr;
     }
     return m;
@@ -438,12 +486,12 @@ ClumpPtr GameData::loadClump(const std::string& name, const std::string& texture
 void GameData::loadModelFile(const std::string& name) {
     auto file = index.openFileRaw(name);
     if (!file.data) {
-        logger->log("Data", Logger::Error, "Failed to load model file " + name);
+        logger->log("Data", Logger::Error, "Failed to load model file ", name);
         return;
     }
-    auto m = dffLoader.loadFromMemory(file);
+    auto m = dffLoader.loadFromMemory(file, &geometryArenas);
     if (!m) {
-        logger->log("Data", Logger::Error, "Error loading model file " + name);
+        logger->log("Data", Logger::Error, "Error loading model file ", name);
         return;
     }
 
@@ -502,20 +550,21 @@ bool GameData::loadModel(ModelID model) {
     /// @todo remove this from here
     loadTXD(slotname + ".txd");
 
-    auto file = index.openFile(name + ".dff");
+    auto file = openFile(name + ".dff");
     if (!file.data) {
-        logger->error("Data", "Failed to load model for " +
-                                  std::to_string(model) + " [" + name + "]");
+        logger->error("Data", "Failed to load model for ", model, " [", name,
+                      "]");
         return false;
     }
-    auto m = dffLoader.loadFromMemory(file);
+    /// @todo handle timeinfo models correctly.
+    auto isSimple = info->type() == ModelDataType::SimpleInfo;
+    auto m = dffLoader.loadFromMemory(file,
+                                      isSimple ? &geometryArenas : nullptr);
     if (!m) {
         logger->error("Data",
                       "Error loading model file for " + std::to_string(model));
         return false;
     }
-    /// @todo handle timeinfo models correctly.
-    auto isSimple = info->type() == ModelDataType::SimpleInfo;
     if (isSimple) {
         auto simple = static_cast<SimpleModelInfo*>(info);
         // Associate atomics
@@ -538,7 +587,7 @@ bool GameData::loadModel(ModelID model) {
 }
 
 void GameData::loadIFP(const std::string& name, bool cutsceneAnimation) {
-    auto f = index.openFile(name);
+    auto f = openFile(name);
 
     if (f.data) {
         if (LoaderIFP loader{}; loader.loadFromMemory(f.data.get())) {
@@ -659,7 +708,7 @@ void GameData::loadPedGroups(const std::string& path) {
             }
             auto model = findModelObject(line);
             if (int16_t(model) == -1) {
-                logger->error("Data", "Invalid model in ped group " + line);
+                logger->error("Data", "Invalid model in ped group ", line);
                 continue;
             }
             group.push_back(model);
@@ -670,6 +719,38 @@ void GameData::loadPedGroups(const std::string& path) {
     }
 }
 
+void GameData::prefetchFile(const std::string& name) {
+    auto key = FileIndex::normalizeFilePath(name);
+    if (prefetchedFiles.count(key) > 0) {
+        return;
+    }
+    // The index isn't changed after startup, so it can be read from here
+    prefetchedFiles.emplace(
+        key, std::async(std::launch::async,
+                        [this, key] { return index.openFile(key); }));
+}
+
+bool GameData::isFileReady(const std::string& name) const {
+    auto it = prefetchedFiles.find(FileIndex::normalizeFilePath(name));
+    return it == prefetchedFiles.end() ||
+           it->second.wait_for(std::chrono::seconds(0)) ==
+               std::future_status::ready;
+}
+
+FileContentsInfo GameData::openFile(const std::string& name) {
+    auto it = prefetchedFiles.find(FileIndex::normalizeFilePath(name));
+    if (it == prefetchedFiles.end()) {
+        return index.openFile(name);
+    }
+    auto future = std::move(it->second);
+    prefetchedFiles.erase(it);
+    return future.get();
+}
+
+void GameData::clearPrefetchedFiles() {
+    prefetchedFiles.clear();
+}
+
 bool GameData::loadAudioStream(const std::string& name) {
     auto systempath = index.findFilePath("audio/" + name).string();
 
@@ -697,7 +778,7 @@ bool GameData::loadAudioClip(const std::string& name,
     bool loaded = engine->sound.loadSound(name, systempath);
 
     if (!loaded) {
-        logger->error("Data", "Error loading audio clip " + systempath);
+        logger->error("Data", "Error loading audio clip ", systempath);
         return false;
     }
 
@@ -736,8 +817,11 @@ ZoneData *GameData::findZone(const std::string &name) {
 
 ZoneData *GameData::findZoneAt(const glm::vec3 &pos) {
     RW_CHECK(!gamezones.empty(), "No game zones loaded");
-    ZoneData* zone = gamezones[0].findLeafAtPoint(pos);
-    return zone;
+    RW_CHECK(zoneGrid.getRoot() == &gamezones[0], "Zone grid is out of date");
+    if (zoneGrid.getRoot() != &gamezones[0]) {
+        return gamezones[0].findLeafAtPoint(pos);
+    }
+    return zoneGrid.findLeafAtPoint(pos);
 }
 
 int GameData::getWaterIndexAt(const glm::vec3& ws) const {
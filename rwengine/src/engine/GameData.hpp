@@ -5,12 +5,14 @@
 #include <algorithm>
 #include <cstddef>
 #include <cstdint>
+#include <future>
 #include <map>
 #include <memory>
 #include <string>
 #include <unordered_map>
 #include <vector>
 
+#include <platform/FileHandle.hpp>
 #include <platform/FileIndex.hpp>
 #include <rw/debug.hpp>
 #include <rw/forward.hpp>
@@ -21,6 +23,7 @@
 #include <data/WeaponData.hpp>
 #include <data/Weather.hpp>
 #include <data/ZoneData.hpp>
+#include <data/ZoneGrid.hpp>
 #include <fonts/GameTexts.hpp>
 #include <loaders/LoaderDFF.hpp>
 #include <loaders/LoaderIMG.hpp>
@@ -50,6 +53,9 @@ private:
     Logger* logger;
     LoaderDFF dffLoader;
 
+    /// Shared vertex and index storage for static world geometry
+    GeometryArenaPool geometryArenas;
+
 public:
     /**
      * ctor
@@ -200,6 +206,33 @@ public:
 
     FileIndex index;
 
+    /**
+     * Starts reading a file on a worker thread, for openFile to use later
+     */
+    void prefetchFile(const std::string& name);
+
+    /**
+     * @return false while a prefetch of the file is still reading it
+     */
+    bool isFileReady(const std::string& name) const;
+
+    /**
+     * Opens a file from the index, using the prefetched contents if the file
+     * was prefetched. Waits for the prefetch if it's still reading
+     */
+    FileContentsInfo openFile(const std::string& name);
+
+    /**
+     * Forgets prefetched files that were never opened
+     */
+    void clearPrefetchedFiles();
+
+    /**
+     * Files being read by prefetchFile, by normalized name
+     */
+    std::unordered_map<std::string, std::future<FileContentsInfo>>
+        prefetchedFiles;
+
     /**
      * Files that have been loaded previously
      */
@@ -219,6 +252,16 @@ public:
 
     ZoneDataList mapzones;
 
+    /**
+     * Lookup grid for gamezones, rebuilt whenever the zone hierarchy is
+     */
+    ZoneGrid zoneGrid;
+
+    /**
+     * Rebuilds the zone hierarchy and zoneGrid after gamezones changed
+     */
+    void buildZoneHierarchy();
+
     ZoneData* findZone(const std::string& name);
 
     ZoneData* findZoneAt(const glm::vec3& pos);
@@ -253,7 +296,7 @@ public:
     std::unordered_map<std::string, VehicleInfo> vehicleInfos;
 
     /**
-     * Texture Loader
+     * Texture Loader, holds the compressed texture cache if enabled
      */
     TextureLoader textureLoader;
 
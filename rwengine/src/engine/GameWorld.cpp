@@ -3,7 +3,10 @@
 #ifdef _MSC_VER
 #pragma warning(disable : 4305)
 #endif
+#include <BulletCollision/CollisionDispatch/btCollisionDispatcherMt.h>
 #include <BulletCollision/CollisionDispatch/btGhostObject.h>
+#include <BulletDynamics/Dynamics/btDiscreteDynamicsWorldMt.h>
+#include <LinearMath/btThreads.h>
 #include <btBulletDynamicsCommon.h>
 #ifdef _MSC_VER
 #pragma warning(default : 4305)
@@ -11,9 +14,15 @@
 
 #include <glm/gtx/norm.hpp>
 
+#include <algorithm>
+#include <chrono>
+#include <thread>
+#include <tuple>
+
 #include <data/Clump.hpp>
 
 #include "core/Profiler.hpp"
+#include "core/Telemetry.hpp"
 #include "core/Logger.hpp"
 
 #include "engine/GameData.hpp"
@@ -25,8 +34,6 @@
 #include "ai/PlayerController.hpp"
 #include "ai/TrafficDirector.hpp"
 
-#include "dynamics/HitTest.hpp"
-
 #include "data/CutsceneData.hpp"
 #include "data/InstanceData.hpp"
 
@@ -40,6 +47,7 @@
 #include "objects/CutsceneObject.hpp"
 #include "objects/InstanceObject.hpp"
 #include "objects/PickupObject.hpp"
+#include "objects/ProjectileObject.hpp"
 #include "objects/VehicleObject.hpp"
 
 #include "platform/FileHandle.hpp"
@@ -53,18 +61,10 @@
 // Behaviour Tuning
 constexpr float kMaxTrafficSpawnRadius = 100.f;
 constexpr float kMaxTrafficCleanupRadius = kMaxTrafficSpawnRadius * 1.25f;
-
-namespace {
-template <typename T>
-bool shouldEffectBeRemoved(const T& effect, float gameTime) {
-    if (effect->getType() != Particle) {
-        return false;
-    }
-    auto particle = static_cast<ParticleFX*>(effect.get());
-    return particle->lifetime >= 0.f &&
-           gameTime >= particle->starttime + particle->lifetime;
-}
-}  // namespace
+// Traffic this close keeps full physics even when out of view
+constexpr float kMinKinematicDistance = 30.f;
+// Kinematic traffic has to come this much closer to switch back
+constexpr float kSimulationLODMargin = 10.f;
 
 class WorldCollisionDispatcher : public btCollisionDispatcher {
 public:
@@ -78,18 +78,66 @@ public:
     }
 };
 
-GameWorld::GameWorld(Logger* log, GameData* dat)
+namespace {
+/**
+ * Bullet's task scheduler is global, so it is shared by every world
+ * @return the scheduler, or nullptr if Bullet was built without threading
+ */
+btITaskScheduler* getPhysicsTaskScheduler() {
+    static btITaskScheduler* scheduler = [] {
+        auto ts = btCreateDefaultTaskScheduler();
+        if (ts) {
+            const auto hwThreads =
+                static_cast<int>(std::thread::hardware_concurrency());
+            ts->setNumThreads(
+                std::clamp(hwThreads, 1, ts->getMaxNumThreads()));
+            btSetTaskScheduler(ts);
+        }
+        return ts;
+    }();
+    return scheduler;
+}
+}  // namespace
+
+GameWorld::GameWorld(Logger* log, GameData* dat, bool threadedPhysics)
     : logger(log), data(dat), sound(this) {
     data->engine = this;
 
+    if (threadedPhysics && !getPhysicsTaskScheduler()) {
+        logger->warning("World",
+                        "Bullet was built without threading support, "
+                        "using single threaded physics");
+        threadedPhysics = false;
+    }
+    threaded = threadedPhysics;
+
     collisionConfig = std::make_unique<btDefaultCollisionConfiguration>();
-    collisionDispatcher =
-        std::make_unique<WorldCollisionDispatcher>(collisionConfig.get());
     broadphase = std::make_unique<btDbvtBroadphase>();
-    solver = std::make_unique<btSequentialImpulseConstraintSolver>();
-    dynamicsWorld = std::make_unique<btDiscreteDynamicsWorld>(
-        collisionDispatcher.get(), broadphase.get(), solver.get(),
-        collisionConfig.get());
+    if (threadedPhysics) {
+        auto numThreads = getPhysicsTaskScheduler()->getNumThreads();
+        logger->info("World", "Using ", numThreads, " physics threads");
+        collisionDispatcher =
+            std::make_unique<btCollisionDispatcherMt>(collisionConfig.get());
+        auto solverPool =
+            std::make_unique<btConstraintSolverPoolMt>(numThreads);
+#if BT_BULLET_VERSION >= 288
+        dynamicsWorld = std::make_unique<btDiscreteDynamicsWorldMt>(
+            collisionDispatcher.get(), broadphase.get(), solverPool.get(),
+            nullptr, collisionConfig.get());
+#else
+        dynamicsWorld = std::make_unique<btDiscreteDynamicsWorldMt>(
+            collisionDispatcher.get(), broadphase.get(), solverPool.get(),
+            collisionConfig.get());
+#endif
+        solver = std::move(solverPool);
+    } else {
+        collisionDispatcher =
+            std::make_unique<WorldCollisionDispatcher>(collisionConfig.get());
+        solver = std::make_unique<btSequentialImpulseConstraintSolver>();
+        dynamicsWorld = std::make_unique<btDiscreteDynamicsWorld>(
+            collisionDispatcher.get(), broadphase.get(), solver.get(),
+            collisionConfig.get());
+    }
 
     dynamicsWorld->setGravity(btVector3(0.f, 0.f, -9.81f));
     _overlappingPairCallback = std::make_unique<btGhostPairCallback>();
@@ -103,6 +151,7 @@ GameWorld::GameWorld(Logger* log, GameData* dat)
 GameWorld::~GameWorld() {
     // Bullet requires to remove each object before all physic world
     pedestrianPool.clear();
+    modelInstances.clear();
     instancePool.clear();
     vehiclePool.clear();
     pickupPool.clear();
@@ -117,15 +166,14 @@ bool GameWorld::placeItems(const std::string& name) {
         // Find the object.
         for (const auto& inst : ipll.m_instances) {
             if (!createInstance(inst.id, inst.pos, inst.rot)) {
-                logger->error("World", "No object data for instance " +
-                                           std::to_string(inst.id) + " in " +
-                                           name);
+                logger->error("World", "No object data for instance ",
+                              inst.id, " in ", name);
             }
         }
 
         return true;
     } else {
-        logger->error("Data", "Failed to load IPL " + name);
+        logger->error("Data", "Failed to load IPL ", name);
         return false;
     }
 
@@ -134,7 +182,8 @@ bool GameWorld::placeItems(const std::string& name) {
 
 InstanceObject* GameWorld::createInstance(const uint16_t id,
                                           const glm::vec3& pos,
-                                          const glm::quat& rot) {
+                                          const glm::quat& rot,
+                                          GameObjectID gid) {
     auto oi = data->findModelInfo<SimpleModelInfo>(id);
     if (oi) {
         // Request loading of the model if it isn't loaded already.
@@ -161,11 +210,12 @@ InstanceObject* GameWorld::createInstance(const uint16_t id,
             std::make_unique<InstanceObject>(this, pos, rot, glm::vec3(1.f), oi, dydata);
 
         auto ptr = instance.get();
+        instance->setGameObjectID(gid);
 
         instancePool.insert(std::move(instance));
         allObjects.push_back(ptr);
 
-        modelInstances.emplace(oi->name, ptr);
+        modelInstances.insert(ptr);
 
         return ptr;
     }
@@ -208,6 +258,127 @@ void GameWorld::cleanupTraffic(const ViewCamera& focus) {
     destroyQueuedObjects();
 }
 
+namespace {
+template <class T>
+void tickPool(GameWorld::ObjectPool& pool, float dt) {
+    auto& list = pool.updateList;
+    // Objects created while ticking are appended, and ticked as well
+    for (size_t i = 0; i < list.size(); ++i) {
+        // Skips the dispatch through GameObject; final types call directly
+        static_cast<T*>(list[i])->tick(dt);
+    }
+}
+
+/// Characters given to each worker at a time
+constexpr int kCharacterGrainSize = 16;
+
+struct CharacterAnimationBody : btIParallelForBody {
+    std::vector<GameObject*>& characters;
+    float dt;
+
+    CharacterAnimationBody(std::vector<GameObject*>& characters, float dt)
+        : characters(characters), dt(dt) {
+    }
+
+    void forLoop(int begin, int end) const override {
+        for (int i = begin; i < end; ++i) {
+            static_cast<CharacterObject*>(characters[static_cast<size_t>(i)])
+                ->tickAnimation(dt);
+        }
+    }
+};
+}  // namespace
+
+void GameWorld::tickCharacters(float dt) {
+    RW_PROFILE_SCOPE(__func__);
+    auto& list = pedestrianPool.updateList;
+    RW_PROFILE_COUNTER_SET("tickObjects/pedestrians", list.size());
+
+    // Controllers share the random number generator and change other
+    // objects, so they always run in order
+    {
+        RW_TELEMETRY_SCOPE(AI);
+        for (size_t i = 0; i < list.size(); ++i) {
+            static_cast<CharacterObject*>(list[i])->tickController(dt);
+        }
+    }
+
+    // Characters spawned by the controllers are included from here on
+    if (threaded) {
+        CharacterAnimationBody body(list, dt);
+        btParallelFor(0, static_cast<int>(list.size()), kCharacterGrainSize,
+                      body);
+    } else {
+        for (auto object : list) {
+            static_cast<CharacterObject*>(object)->tickAnimation(dt);
+        }
+    }
+
+    // Warps and resets are applied in pool order, whatever thread the
+    // animation ran on
+    for (size_t i = 0; i < list.size(); ++i) {
+        static_cast<CharacterObject*>(list[i])->applyTick();
+    }
+}
+
+void GameWorld::tickObjects(float dt) {
+    tickCharacters(dt);
+    tickPool<PickupObject>(pickupPool, dt);
+    tickPool<ProjectileObject>(projectilePool, dt);
+    tickPool<CutsceneObject>(cutscenePool, dt);
+}
+
+void GameWorld::updateSimulationLOD(const ViewCamera& focus) {
+    RW_PROFILE_SCOPE(__func__);
+    auto wantsKinematic = [&](const glm::vec3& position, float radius,
+                              bool kinematic) {
+        const auto margin = kinematic ? kSimulationLODMargin : 0.f;
+        const auto distance = glm::distance(focus.position, position);
+        if (distance > simulationLODDistance - margin) {
+            return true;
+        }
+        return distance > kMinKinematicDistance - margin &&
+               !focus.frustum.intersects(position, radius);
+    };
+
+    int kinematicVehicles = 0;
+    for (auto& p : vehiclePool.objects) {
+        auto vehicle = static_cast<VehicleObject*>(p.second.get());
+        bool kinematic = false;
+        if (vehicle->getLifetime() == GameObject::TrafficLifetime &&
+            vehicle->getVehicle()->vehicletype_ == VehicleModelInfo::CAR) {
+            auto driver = vehicle->getDriver();
+            kinematic = !(driver && driver->isPlayer()) &&
+                        wantsKinematic(vehicle->getPosition(), 5.f,
+                                       vehicle->isKinematic());
+        }
+        vehicle->setKinematic(kinematic);
+        kinematicVehicles += kinematic ? 1 : 0;
+    }
+
+    int kinematicPeds = 0;
+    for (auto& p : pedestrianPool.objects) {
+        auto ped = static_cast<CharacterObject*>(p.second.get());
+        bool kinematic = false;
+        if (ped->getLifetime() == GameObject::TrafficLifetime &&
+            !ped->isPlayer()) {
+            if (auto vehicle = ped->getCurrentVehicle()) {
+                kinematic = vehicle->isKinematic();
+            } else {
+                kinematic = wantsKinematic(ped->getPosition(), 1.f,
+                                           ped->isKinematic());
+            }
+        }
+        ped->setKinematic(kinematic);
+        kinematicPeds += kinematic ? 1 : 0;
+    }
+
+    RW_PROFILE_COUNTER_SET("simulationLOD/kinematicVehicles", kinematicVehicles);
+    RW_PROFILE_COUNTER_SET("simulationLOD/kinematicPeds", kinematicPeds);
+    RW_UNUSED(kinematicVehicles);
+    RW_UNUSED(kinematicPeds);
+}
+
 CutsceneObject* GameWorld::createCutsceneObject(const uint16_t id,
                                                 const glm::vec3& pos,
                                                 const glm::quat& rot) {
@@ -247,8 +418,8 @@ VehicleObject* GameWorld::createVehicle(const uint16_t id, const glm::vec3& pos,
     if (!vti) {
         return nullptr;
     }
-    logger->info("World", "Creating Vehicle ID " + std::to_string(id) + " (" +
-                              vti->vehiclename_ + ")");
+    logger->info("World", "Creating Vehicle ID ", id, " (", vti->vehiclename_,
+                 ")");
 
     if (!vti->isLoaded()) {
         data->loadModel(id);
@@ -262,7 +433,7 @@ VehicleObject* GameWorld::createVehicle(const uint16_t id, const glm::vec3& pos,
         prim = data->vehicleColours[palit->second[set].first];
         sec = data->vehicleColours[palit->second[set].second];
     } else {
-        logger->warning("World", "No colour palette for vehicle " + vti->name);
+        logger->warning("World", "No colour palette for vehicle ", vti->name);
     }
 
     auto addSeats = [](std::vector<SeatInfo>& seats, glm::vec3&& offset) {
@@ -377,7 +548,8 @@ CharacterObject* GameWorld::createPlayer(const glm::vec3& pos,
     return ptr;
 }
 
-PickupObject* GameWorld::createPickup(const glm::vec3& pos, int id, int type) {
+PickupObject* GameWorld::createPickup(const glm::vec3& pos, int id, int type,
+                                      GameObjectID gid) {
     auto modelInfo = data->modelinfo[id].get();
 
     RW_CHECK(modelInfo != nullptr, "Pickup Object Data is not found");
@@ -423,6 +595,7 @@ PickupObject* GameWorld::createPickup(const glm::vec3& pos, int id, int type) {
     }
 
     auto ptr = pickup.get();
+    pickup->setGameObjectID(gid);
 
     pickupPool.insert(std::move(pickup));
     allObjects.push_back(ptr);
@@ -453,6 +626,9 @@ void GameWorld::ObjectPool::insert(std::unique_ptr<GameObject> object) {
 
         object->setGameObjectID(availID);
     }
+    if (ticked) {
+        updateList.push_back(object.get());
+    }
     objects[object->getGameObjectID()] = std::move(object);
 }
 
@@ -463,6 +639,9 @@ GameObject* GameWorld::ObjectPool::find(GameObjectID id) const {
 
 void GameWorld::ObjectPool::remove(GameObject* object) {
     if (object) {
+        updateList.erase(
+            std::remove(updateList.begin(), updateList.end(), object),
+            updateList.end());
         auto it = objects.find(object->getGameObjectID());
         if (it != objects.end()) {
             it = objects.erase(it);
@@ -471,6 +650,7 @@ void GameWorld::ObjectPool::remove(GameObject* object) {
 }
 
 void GameWorld::ObjectPool::clear() {
+    updateList.clear();
     objects.clear();
 }
 
@@ -510,6 +690,10 @@ GameObject* GameWorld::getBlipTarget(const BlipData& blip) const {
 }
 
 void GameWorld::destroyObject(GameObject* object) {
+    if (object->type() == GameObject::Instance) {
+        modelInstances.remove(static_cast<InstanceObject*>(object));
+    }
+
     auto& pool = getTypeObjectPool(object);
     pool.remove(object);
 
@@ -546,10 +730,7 @@ LightFX& GameWorld::createLightEffect() {
 }
 
 ParticleFX& GameWorld::createParticleEffect() {
-    auto effect = std::make_unique<ParticleFX>();
-    auto& ref = *effect;
-    effects.push_back(std::move(effect));
-    return ref;
+    return particles.create();
 }
 
 TrailFX& GameWorld::createTrailEffect() {
@@ -560,6 +741,11 @@ TrailFX& GameWorld::createTrailEffect() {
 }
 
 void GameWorld::destroyEffect(VisualFX& effect) {
+    if (effect.getType() == Particle) {
+        particles.destroy(static_cast<ParticleFX&>(effect));
+        return;
+    }
+
     auto found =
         std::find_if(effects.begin(), effects.end(),
                      [&effect](auto& ef) { return ef.get() == &effect; });
@@ -571,21 +757,9 @@ void GameWorld::destroyEffect(VisualFX& effect) {
 
 void GameWorld::doWeaponScan(const WeaponScan& scan) {
     if (scan.type == ScanType::Radius) {
-        HitTest test {*dynamicsWorld};
-        const auto& result = test.sphereTest(scan.center, scan.radius);
-
-        for(const auto& target : result) {
-            if (!scan.doesDamage(target.object)) {
-                continue;
-            }
-
-            target.object->takeDamage(
-                {
-                    GameObject::DamageInfo::DamageType::Melee,
-                    {}, scan.center, scan.damage
-                });
-        }
-
+        areaDamage.queue({GameObject::DamageInfo::DamageType::Melee,
+                          scan.center, scan.radius, scan.damage,
+                          scan.source});
     } else if (scan.type == ScanType::HitScan) {
         btVector3 from(scan.center.x, scan.center.y, scan.center.z),
             to(scan.end.x, scan.end.y, scan.end.z);
@@ -608,6 +782,10 @@ void GameWorld::doWeaponScan(const WeaponScan& scan) {
     }
 }
 
+void GameWorld::applyAreaDamage() {
+    areaDamage.apply(*dynamicsWorld, pedestrianPool.updateList);
+}
+
 int GameWorld::getHour() {
     return state->basic.gameHour;
 }
@@ -671,13 +849,11 @@ void handleVehicleResponse(GameObject* object, btManifoldPoint& mp, bool isA) {
         dmg = mp.getPositionWorldOnB();
     }
 
-    object->takeDamage({
-                           GameObject::DamageInfo::DamageType::Physics,
-                           {dmg.x(), dmg.y(), dmg.z()},
-                           {src.x(), src.y(), src.z()},
-                           0.f,
-                           mp.getAppliedImpulse()
-                       });
+    object->engine->queueContactDamage({object,
+                                        {dmg.x(), dmg.y(), dmg.z()},
+                                        {src.x(), src.y(), src.z()},
+                                        0.f,
+                                        mp.getAppliedImpulse()});
 }
 
 void handleInstanceResponse(InstanceObject* instance, const btManifoldPoint& mp,
@@ -696,13 +872,11 @@ void handleInstanceResponse(InstanceObject* instance, const btManifoldPoint& mp,
     ///@ todo Correctness: object damage calculation
     constexpr auto kMinimumDamageImpulse = 500.f;
     const auto hp = std::max(0.f, impulse - kMinimumDamageImpulse);
-    instance->takeDamage({
-                             GameObject::DamageInfo::DamageType::Physics,
-                             {dmg.x(), dmg.y(), dmg.z()},
-                             {dmg.x(), dmg.y(), dmg.z()},
-                             hp,
-                             impulse
-                         });
+    instance->engine->queueContactDamage({instance,
+                                          {dmg.x(), dmg.y(), dmg.z()},
+                                          {dmg.x(), dmg.y(), dmg.z()},
+                                          hp,
+                                          impulse});
 }
 }  // namespace
 
@@ -743,11 +917,33 @@ bool GameWorld::ContactProcessedCallback(btManifoldPoint& mp, void* body0,
     return true;
 }
 
+void GameWorld::queueContactDamage(const ContactDamage& damage) {
+    std::lock_guard<std::mutex> lock(contactDamageMutex);
+    contactDamage.push_back(damage);
+}
+
 void GameWorld::PhysicsTickCallback(btDynamicsWorld* physWorld,
                                     btScalar timeStep) {
     RW_PROFILE_SCOPEC(__func__, MP_CYAN);
     GameWorld* world = static_cast<GameWorld*>(physWorld->getWorldUserInfo());
 
+    // The workers are idle between substeps, so no lock is needed here.
+    // They may have queued contacts in any order, sort for determinism.
+    auto& damage = world->contactDamage;
+    auto key = [](const ContactDamage& c) {
+        return std::make_tuple(c.object->type(), c.object->getGameObjectID(),
+                               c.impulse, c.hitpoints);
+    };
+    std::sort(damage.begin(), damage.end(),
+              [&](const ContactDamage& a, const ContactDamage& b) {
+                  return key(a) < key(b);
+              });
+    for (const auto& c : damage) {
+        c.object->takeDamage({GameObject::DamageInfo::DamageType::Physics,
+                              c.position, c.source, c.hitpoints, c.impulse});
+    }
+    damage.clear();
+
     RW_PROFILE_COUNTER_SET("physicsTick/vehiclePool", world->vehiclePool.objects.size());
     for (auto& p : world->vehiclePool.objects) {
         RW_PROFILE_SCOPEC("VehicleObject", MP_THISTLE1);
@@ -762,24 +958,117 @@ void GameWorld::PhysicsTickCallback(btDynamicsWorld* physWorld,
         object->tickPhysics(timeStep);
     }
 
+    auto& active = world->physicsInstances;
     RW_PROFILE_COUNTER_SET("physicsTick/instancePool", world->instancePool.objects.size());
-    for (auto& p : world->instancePool.objects) {
-        auto object = static_cast<InstanceObject*>(p.second.get());
+    RW_PROFILE_COUNTER_SET("physicsTick/activeInstances", active.size());
+    for (size_t i = 0; i < active.size();) {
+        auto object = active[i];
         object->tickPhysics(timeStep);
+        if (object->needsPhysicsTick()) {
+            ++i;
+            continue;
+        }
+        // Swap in an object that hasn't been ticked yet
+        object->setPhysicsActive(false);
+        active[i] = active.back();
+        active.pop_back();
     }
 }
 
+void GameWorld::activatePhysics(InstanceObject* object) {
+    if (object->isPhysicsActive()) {
+        return;
+    }
+    object->setPhysicsActive(true);
+    physicsInstances.push_back(object);
+}
+
+void GameWorld::deactivatePhysics(InstanceObject* object) {
+    if (!object->isPhysicsActive()) {
+        return;
+    }
+    object->setPhysicsActive(false);
+    auto it = std::find(physicsInstances.begin(), physicsInstances.end(),
+                        object);
+    if (it != physicsInstances.end()) {
+        *it = physicsInstances.back();
+        physicsInstances.pop_back();
+    }
+}
+
+void GameWorld::prefetchCutscene(const std::string& name) {
+    if (cutscenePrefetch.valid() && prefetchedCutscene == name) {
+        return;
+    }
+    abandonedPrefetches.erase(
+        std::remove_if(abandonedPrefetches.begin(), abandonedPrefetches.end(),
+                       [](const std::future<CutsceneFiles>& f) {
+                           // Deferred ones never run, so they're done too
+                           return f.wait_for(std::chrono::seconds(0)) !=
+                                  std::future_status::timeout;
+                       }),
+        abandonedPrefetches.end());
+    if (cutscenePrefetch.valid()) {
+        abandonedPrefetches.push_back(std::move(cutscenePrefetch));
+    }
+    // Only the file index is used from the worker, which doesn't change
+    // after startup
+    auto& index = data->index;
+    prefetchedCutscene = name;
+    cutscenePrefetch = std::async(cutscenePrefetchLaunch, [&index, name] {
+        CutsceneFiles files;
+
+        auto datfile = index.openFile(name + ".dat");
+        if (datfile.data) {
+            LoaderCutsceneDAT loaderdat;
+            loaderdat.load(files.tracks, datfile);
+        }
+
+        auto ifpfile = index.openFile(name + ".ifp");
+        if (ifpfile.data) {
+            if (LoaderIFP loader{}; loader.loadFromMemory(ifpfile.data.get())) {
+                files.animations = std::move(loader.animations);
+            }
+        }
+
+        return files;
+    });
+}
+
+bool GameWorld::isCutsceneReady(const std::string& name) const {
+    return cutscenePrefetch.valid() && prefetchedCutscene == name &&
+           cutscenePrefetch.wait_for(std::chrono::seconds(0)) ==
+               std::future_status::ready;
+}
+
 void GameWorld::loadCutscene(const std::string& name) {
-    auto datfile = data->index.openFile(name + ".dat");
+    prefetchCutscene(name);
 
     state->currentCutscene = CutsceneData();
+    state->currentCutscene->meta.name = name;
+    cutsceneLoading = true;
+    pendingCutsceneAnimations.clear();
+}
 
-    if (datfile.data) {
-        LoaderCutsceneDAT loaderdat;
-        loaderdat.load(state->currentCutscene->tracks, datfile);
+bool GameWorld::finishLoadingCutscene(bool wait) {
+    if (!cutsceneLoading || !state->currentCutscene) {
+        return true;
     }
+    const auto name = state->currentCutscene->meta.name;
+    if (!wait && !isCutsceneReady(name)) {
+        return false;
+    }
+
+    // Reads the files again if another prefetch replaced them meanwhile
+    prefetchCutscene(name);
+    auto files = cutscenePrefetch.get();
+    prefetchedCutscene.clear();
+    cutsceneLoading = false;
+
+    state->currentCutscene->tracks = std::move(files.tracks);
+    data->animationsCutscene.insert(files.animations.begin(),
+                                    files.animations.end());
 
-    data->loadIFP(name + ".ifp", true);
     cutsceneAudioLoaded = data->loadAudioStream(name + ".mp3");
 
     if (!cutsceneAudioLoaded) {
@@ -787,14 +1076,39 @@ void GameWorld::loadCutscene(const std::string& name) {
     }
 
     if (!cutsceneAudioLoaded) {
-        logger->warning("Data", "Failed to load cutscene audio: " + name);
+        logger->warning("Data", "Failed to load cutscene audio: ", name);
     }
 
-    state->currentCutscene->meta.name = name;
-    logger->info("World", "Loaded cutscene: " + name);
+    for (const auto& [id, animation] : pendingCutsceneAnimations) {
+        if (auto object = static_cast<CutsceneObject*>(cutscenePool.find(id))) {
+            setCutsceneAnimation(object, animation);
+        }
+    }
+    pendingCutsceneAnimations.clear();
+
+    logger->info("World", "Loaded cutscene: ", name);
+    return true;
+}
+
+void GameWorld::setCutsceneAnimation(CutsceneObject* object,
+                                     const std::string& name) {
+    if (cutsceneLoading) {
+        pendingCutsceneAnimations.emplace_back(object->getGameObjectID(), name);
+        return;
+    }
+
+    auto it = data->animationsCutscene.find(name);
+    if (it != data->animationsCutscene.end() && it->second) {
+        object->animator->playAnimation(AnimIndexMovement, it->second, 1.f,
+                                        false);
+    } else {
+        logger->error("SCM", "Failed to load cutscene anim: " + name);
+    }
 }
 
 void GameWorld::startCutscene() {
+    finishLoadingCutscene(true);
+
     state->cutsceneStartTime = getGameTime();
     state->skipCutscene = false;
 
@@ -809,7 +1123,15 @@ void GameWorld::clearCutscene() {
     eraseCutsceneSound();
     eraseCutsceneAnimations();
 
+    // Files that are still being read for it aren't needed any more
+    if (cutsceneLoading && cutscenePrefetch.valid()) {
+        abandonedPrefetches.push_back(std::move(cutscenePrefetch));
+        prefetchedCutscene.clear();
+    }
+
     state->currentCutscene = std::nullopt;
+    cutsceneLoading = false;
+    pendingCutsceneAnimations.clear();
     state->isCinematic = false;
     state->cutsceneStartTime = -1.f;
 }
@@ -830,10 +1152,16 @@ void GameWorld::eraseCutsceneSound() {
 }
 
 void GameWorld::eraseCutsceneAnimations() {
-    data->animationsCutscene.clear();
+    // Swap the set out, so its memory is released as well
+    AnimationSet().swap(data->animationsCutscene);
+    // Special characters and models that were never used
+    data->clearPrefetchedFiles();
 }
 
 bool GameWorld::isCutsceneDone() {
+    if (cutsceneLoading) {
+        return false;
+    }
     if (state->currentCutscene) {
         float time = getGameTime() - state->cutsceneStartTime;
         if (state->skipCutscene) {
@@ -847,8 +1175,7 @@ bool GameWorld::isCutsceneDone() {
 void GameWorld::loadSpecialCharacter(const unsigned short index,
                                      const std::string& name) {
     constexpr uint16_t kFirstSpecialActor = 26;
-    logger->info("Data", "Loading special actor " + name + " to " +
-                             std::to_string(index));
+    logger->info("Data", "Loading special actor ", name, " to ", index);
     auto modelid = kFirstSpecialActor + index - 1;
     auto model = data->findModelInfo<PedModelInfo>(modelid);
     if (model && model->isLoaded()) {
@@ -858,12 +1185,15 @@ void GameWorld::loadSpecialCharacter(const unsigned short index,
     std::transform(lowerName.begin(), lowerName.end(), lowerName.begin(),
                    ::tolower);
     state->specialCharacters[index] = lowerName;
+
+    // Read the files now, they're loaded once the character is used
+    data->prefetchFile(lowerName + ".dff");
+    data->prefetchFile(lowerName + ".txd");
 }
 
 void GameWorld::loadSpecialModel(const unsigned short index,
                                  const std::string& name) {
-    logger->info("Data", "Loading cutscene object " + name + " to " +
-                             std::to_string(index));
+    logger->info("Data", "Loading cutscene object ", name, " to ", index);
     // Tell the HIER model to discard the currently loaded model
     auto model = data->findModelInfo<ClumpModelInfo>(index);
     if (model && model->isLoaded()) {
@@ -873,6 +1203,9 @@ void GameWorld::loadSpecialModel(const unsigned short index,
     std::transform(lowerName.begin(), lowerName.end(), lowerName.begin(),
                    ::tolower);
     state->specialModels[index] = lowerName;
+
+    data->prefetchFile(lowerName + ".dff");
+    data->prefetchFile(lowerName + ".txd");
 }
 
 void GameWorld::disableAIPaths(ai::NodeType type, const glm::vec3& min,
@@ -925,12 +1258,10 @@ bool GameWorld::isPaused() const {
 }
 
 void GameWorld::updateEffects() {
-    effects.erase(std::remove_if(effects.begin(), effects.end(),
-                                 [gameTime = getGameTime()](auto& effect) {
-                                     return shouldEffectBeRemoved(effect,
-                                                                  gameTime);
-                                 }),
-                  effects.end());
+    RW_PROFILE_SCOPE(__func__);
+    const auto removed = particles.removeExpired(getGameTime());
+    RW_PROFILE_COUNTER_SET("updateEffects/expired", removed);
+    RW_UNUSED(removed);
 }
 
 VehicleObject* GameWorld::tryToSpawnVehicle(VehicleGenerator& gen) {
@@ -2,11 +2,14 @@
 #define _RWENGINE_GAMEWORLD_HPP_
 
 #include <cstdint>
+#include <future>
 #include <map>
 #include <memory>
+#include <mutex>
 #include <random>
 #include <set>
 #include <string>
+#include <utility>
 #include <vector>
 
 #ifdef _MSC_VER
@@ -20,8 +23,12 @@
 #include <ai/AIGraph.hpp>
 #include <audio/SoundManager.hpp>
 #include <data/Chase.hpp>
+#include <data/CutsceneData.hpp>
+#include <dynamics/AreaDamage.hpp>
 #include <engine/Garage.hpp>
+#include <engine/ModelInstanceIndex.hpp>
 #include <objects/ObjectTypes.hpp>
+#include <render/VisualFX.hpp>
 
 class btCollisionDispatcher;
 class btDefaultCollisionConfiguration;
@@ -29,7 +36,7 @@ class btDiscreteDynamicsWorld;
 class btDynamicsWorld;
 class btManifoldPoint;
 class btOverlappingPairCallback;
-class btSequentialImpulseConstraintSolver;
+class btConstraintSolver;
 struct btDbvtBroadphase;
 
 class GameState;
@@ -57,11 +64,6 @@ struct BlipData;
 struct WeaponScan;
 struct VehicleGenerator;
 
-struct LightFX;
-struct ParticleFX;
-struct TrailFX;
-struct VisualFX;
-
 /**
  * Information about "Goal" locations so they can be rendered
  * (this doesn't really belong here).
@@ -80,7 +82,11 @@ struct AreaIndicatorInfo {
  */
 class GameWorld {
 public:
-    GameWorld(Logger* log, GameData* dat);
+    /**
+     * @param threadedPhysics Step the dynamics world and update characters
+     * on a pool of worker threads, if Bullet was built with threading support
+     */
+    GameWorld(Logger* log, GameData* dat, bool threadedPhysics = false);
 
     ~GameWorld();
 
@@ -109,12 +115,41 @@ public:
      */
     void cleanupTraffic(const ViewCamera& viewCamera);
 
+    /**
+     * Ticks every object that needs a per-frame update, one type at a time
+     *
+     * Character animation runs on the physics worker pool when the world
+     * is threaded; the result doesn't depend on the number of threads.
+     */
+    void tickObjects(float dt);
+
+    /**
+     * @return true if the world was created with threading enabled
+     */
+    bool isThreaded() const {
+        return threaded;
+    }
+
+    /**
+     * @brief updateSimulationLOD switches traffic to kinematic movement
+     * when it is far from the camera, or nearby but out of view, and back
+     * to full physics as it comes closer.
+     * @param viewCamera
+     */
+    void updateSimulationLOD(const ViewCamera& viewCamera);
+
+    /**
+     * Distance beyond which traffic stops using full physics
+     */
+    float simulationLODDistance = 80.f;
+
     /**
      * Creates an instance
      */
     InstanceObject* createInstance(const uint16_t id, const glm::vec3& pos,
                                    const glm::quat& rot = glm::quat{
-                                       1.0f, 0.0f, 0.0f, 0.0f});
+                                       1.0f, 0.0f, 0.0f, 0.0f},
+                                   GameObjectID gid = 0);
 
     /**
      * @brief Creates an InstanceObject for use in the current Cutscene.
@@ -151,7 +186,8 @@ public:
     /**
      * Creates a pickup
      */
-    PickupObject* createPickup(const glm::vec3& pos, int id, int type);
+    PickupObject* createPickup(const glm::vec3& pos, int id, int type,
+                               GameObjectID gid = 0);
 
     /**
      * Creates a garage
@@ -180,10 +216,16 @@ public:
     void destroyQueuedObjects();
 
     /**
-     * Performs a weapon scan against things in the world
+     * Performs a weapon scan against things in the world. Radius scans are
+     * queued in areaDamage, hitscans are applied immediately
      */
     void doWeaponScan(const WeaponScan& scan);
 
+    /**
+     * Applies the area damage queued since the last call
+     */
+    void applyAreaDamage();
+
     /**
      * Allocates a new Light Effect
      */
@@ -252,8 +294,23 @@ public:
      * the individual pools.
      */
     struct ObjectPool {
+        /**
+         * @param ticked Whether the objects in this pool need a tick every
+         * frame
+         */
+        explicit ObjectPool(bool ticked = true) : ticked(ticked) {
+        }
+
         std::map<GameObjectID, std::unique_ptr<GameObject>> objects;
 
+        /**
+         * Objects to tick each frame, in insertion order. Kept as a flat
+         * array so the update loop doesn't have to walk the map.
+         */
+        std::vector<GameObject*> updateList;
+
+        bool ticked;
+
         /**
          * Allocates the game object a GameObjectID and inserts it into
          * the pool
@@ -282,14 +339,30 @@ public:
     std::vector<GameObject*> allObjects;
 
     ObjectPool pedestrianPool;
-    ObjectPool instancePool;
-    ObjectPool vehiclePool;
+    // Instances and vehicles do all of their work in tickPhysics
+    ObjectPool instancePool{false};
+    ObjectPool vehiclePool{false};
     ObjectPool pickupPool;
     ObjectPool cutscenePool;
     ObjectPool projectilePool;
 
     ObjectPool& getTypeObjectPool(GameObject* object);
 
+    /**
+     * Instances that need to be ticked each physics step. Most instances
+     * are static scenery, so only these are visited by
+     * PhysicsTickCallback.
+     */
+    std::vector<InstanceObject*> physicsInstances;
+
+    /**
+     * Adds an instance to physicsInstances if it isn't there already.
+     * It is removed again once it no longer needs to be ticked.
+     */
+    void activatePhysics(InstanceObject* object);
+
+    void deactivatePhysics(InstanceObject* object);
+
     std::vector<ai::PlayerController*> players;
 
     std::vector<std::unique_ptr<Garage>> garages;
@@ -304,9 +377,14 @@ public:
     GameObject* getBlipTarget(const BlipData& blip) const;
 
     /**
-     * Map of Model Names to Instances
+     * Explosions and other radius damage waiting to be applied
      */
-    std::map<std::string, InstanceObject*> modelInstances;
+    AreaDamage areaDamage;
+
+    /**
+     * Instances of each model, for searching by model
+     */
+    ModelInstanceIndex modelInstances;
 
     /**
      * AI Graph
@@ -314,29 +392,58 @@ public:
     ai::AIGraph aigraph;
 
     /**
-     * Visual Effects
-     * @todo Consider using lighter handing mechanism
+     * Visual Effects other than particles
      */
     std::vector<std::unique_ptr<VisualFX>> effects;
 
+    /**
+     * Particle Effects, expired ones are removed by updateEffects
+     */
+    ParticlePool particles;
+
     /**
      * Bullet
      */
     std::unique_ptr<btDefaultCollisionConfiguration> collisionConfig;
     std::unique_ptr<btCollisionDispatcher> collisionDispatcher;
     std::unique_ptr<btDbvtBroadphase> broadphase;
-    std::unique_ptr<btSequentialImpulseConstraintSolver> solver;
+    std::unique_ptr<btConstraintSolver> solver;
     std::unique_ptr<btDiscreteDynamicsWorld> dynamicsWorld;
 
+    /**
+     * Damage from a contact, waiting to be applied after the substep
+     */
+    struct ContactDamage {
+        GameObject* object;
+        glm::vec3 position;
+        glm::vec3 source;
+        float hitpoints;
+        float impulse;
+    };
+
+    /**
+     * Queues damage from ContactProcessedCallback. This may be called from
+     * Bullet's worker threads.
+     */
+    void queueContactDamage(const ContactDamage& damage);
+
+    std::mutex contactDamageMutex;
+    std::vector<ContactDamage> contactDamage;
+
     /**
      * @brief physicsNearCallback
      * Used to implement uprooting and other physics oddities.
+     *
+     * This may run on a worker thread, so it only queues damage; the game
+     * objects are changed later from PhysicsTickCallback.
      */
     static bool ContactProcessedCallback(btManifoldPoint& mp, void* body0,
                                          void* body1);
 
     /**
      * @brief PhysicsTickCallback updates object each physics tick.
+     * It is called by Bullet after each substep, on the thread that is
+     * stepping the world.
      * @param physWorld
      * @param timeStep
      */
@@ -344,10 +451,43 @@ public:
                                     btScalar timeStep);
 
     /**
-     * @brief Loads and starts the named cutscene.
+     * Starts reading and parsing the tracks and animations of a cutscene on
+     * a worker thread, so that loading it later doesn't stall the frame
+     */
+    void prefetchCutscene(const std::string& name);
+
+    /**
+     * @return true if the cutscene's files have been read
+     */
+    bool isCutsceneReady(const std::string& name) const;
+
+    /**
+     * @brief Makes the named cutscene current and starts reading its files.
+     *
+     * Returns without waiting for the files, finishLoadingCutscene applies
+     * them once they have been read.
      * @param name
      */
     void loadCutscene(const std::string& name);
+
+    /**
+     * Applies the tracks, animations and audio of the current cutscene once
+     * its files have been read. Called every frame.
+     * @param wait Whether to block until the files have been read
+     * @return true if the current cutscene has its files
+     */
+    bool finishLoadingCutscene(bool wait = false);
+
+    /**
+     * Plays a cutscene animation on the object, or once the current
+     * cutscene's animations have been read if they haven't yet
+     */
+    void setCutsceneAnimation(CutsceneObject* object, const std::string& name);
+
+    /**
+     * Starts the current cutscene, waiting for its files only if they
+     * still haven't been read
+     */
     void startCutscene();
     void clearCutscene();
     bool isCutsceneDone();
@@ -356,6 +496,27 @@ public:
     void eraseCutsceneSound();
     void eraseCutsceneAnimations();
 
+    /**
+     * The parts of a cutscene that are read on a worker thread
+     */
+    struct CutsceneFiles {
+        CutsceneTracks tracks;
+        AnimationSet animations;
+    };
+
+    std::string prefetchedCutscene;
+    std::future<CutsceneFiles> cutscenePrefetch;
+    /// How the prefetch worker is launched, deferred only runs it once the
+    /// files are waited for
+    std::launch cutscenePrefetchLaunch = std::launch::async;
+    /// The current cutscene is still waiting for its files
+    bool cutsceneLoading = false;
+    /// Animations set on cutscene objects before the files were read
+    std::vector<std::pair<GameObjectID, std::string>> pendingCutsceneAnimations;
+    /// Replaced prefetches still reading, kept so replacing them doesn't
+    /// wait for the worker
+    std::vector<std::future<CutsceneFiles>> abandonedPrefetches;
+
     std::string cutsceneAudio;
     bool cutsceneAudioLoaded;
     std::string missionAudio;
@@ -385,7 +546,7 @@ public:
     bool isPaused() const;
 
     /**
-     * Clean up old VisualFX
+     * Clean up expired particles
      */
     void updateEffects();
 
@@ -402,6 +563,13 @@ public:
 
     ai::PlayerController* getPlayer();
 
+    /**
+     * Reseeds the random number generator, for reproducible runs
+     */
+    void setRandomSeed(unsigned int seed) {
+        randomNumberGen.seed(seed);
+    }
+
     template <
         typename T1, typename T2 = T1,
         typename std::enable_if<std::is_integral<T1>::value>::type* = nullptr,
@@ -440,6 +608,13 @@ private:
      */
     std::unique_ptr<btOverlappingPairCallback> _overlappingPairCallback;
 
+    /**
+     * Updates characters, see CharacterObject::tick for the phases
+     */
+    void tickCharacters(float dt);
+
+    bool threaded = false;
+
     /**
      * Randomness Engine
      */
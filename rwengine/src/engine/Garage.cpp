@@ -1,5 +1,8 @@
 #include "Garage.hpp"
 
+#include <algorithm>
+#include <vector>
+
 #ifdef _MSC_VER
 #pragma warning(disable : 4305)
 #endif
@@ -13,6 +16,7 @@
 #include "ai/PlayerController.hpp"
 #include "data/CollisionModel.hpp"
 #include "dynamics/CollisionInstance.hpp"
+#include "engine/GameData.hpp"
 #include "engine/GameState.hpp"
 #include "objects/CharacterObject.hpp"
 #include "objects/GameObject.hpp"
@@ -35,15 +39,26 @@ Garage::Garage(GameWorld* engine_, size_t id_, const glm::vec3& coord0,
     midpoint.y = (min.y + max.y) / 2;
 
     // Find door objects for this garage
-    for (const auto& p : engine->instancePool.objects) {
-        const auto inst = static_cast<InstanceObject*>(p.second.get());
-
-        if (!inst->getClump()) {
+    constexpr float kDoorSearchDistance = 20.f;
+    std::vector<InstanceObject*> doors;
+    std::vector<InstanceObject*> found;
+    for (const auto& m : engine->data->modelinfo) {
+        if (engine->modelInstances.getInstanceCount(m.first) == 0 ||
+            !SimpleModelInfo::isDoorModel(m.second->name)) {
             continue;
         }
+        // The search is a square, so the circle has to cover its corners
+        engine->modelInstances.findNear(m.first, midpoint,
+                                        kDoorSearchDistance * glm::sqrt(2.f),
+                                        found);
+        doors.insert(doors.end(), found.begin(), found.end());
+    }
+    std::sort(doors.begin(), doors.end(), [](const auto* a, const auto* b) {
+        return a->getGameObjectID() < b->getGameObjectID();
+    });
 
-        if (!SimpleModelInfo::isDoorModel(
-                inst->getModelInfo<BaseModelInfo>()->name)) {
+    for (const auto inst : doors) {
+        if (!inst->getClump()) {
             continue;
         }
 
@@ -51,7 +66,7 @@ Garage::Garage(GameWorld* engine_, size_t id_, const glm::vec3& coord0,
         const auto xDist = std::abs(instPos.x - midpoint.x);
         const auto yDist = std::abs(instPos.y - midpoint.y);
 
-        if (xDist < 20.f && yDist < 20.f) {
+        if (xDist < kDoorSearchDistance && yDist < kDoorSearchDistance) {
             if (!doorObject) {
                 doorObject = inst;
                 continue;
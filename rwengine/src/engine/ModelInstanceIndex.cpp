@@ -0,0 +1,160 @@
+#include "engine/ModelInstanceIndex.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <iterator>
+
+#include <glm/geometric.hpp>
+
+#include "objects/InstanceObject.hpp"
+
+namespace {
+bool eraseObject(std::vector<InstanceObject*>& list, InstanceObject* object) {
+    auto it = std::find(list.begin(), list.end(), object);
+    if (it == list.end()) {
+        return false;
+    }
+    list.erase(it);
+    return true;
+}
+}  // namespace
+
+std::int32_t ModelInstanceIndex::cellCoord(float p) {
+    return static_cast<std::int32_t>(std::floor(p / kCellSize));
+}
+
+ModelInstanceIndex::CellKey ModelInstanceIndex::cellKey(std::int32_t x,
+                                                        std::int32_t y) {
+    return (static_cast<CellKey>(static_cast<std::uint32_t>(x)) << 32u) |
+           static_cast<std::uint32_t>(y);
+}
+
+ModelInstanceIndex::CellKey ModelInstanceIndex::cellAt(
+    const glm::vec3& position) {
+    return cellKey(cellCoord(position.x), cellCoord(position.y));
+}
+
+bool ModelInstanceIndex::isMovable(const InstanceObject* object) {
+    return object->dynamics != nullptr;
+}
+
+void ModelInstanceIndex::insert(InstanceObject* object) {
+    auto& model = models[object->getModelInfo<BaseModelInfo>()->id()];
+    if (isMovable(object)) {
+        model.movable.push_back(object);
+    } else {
+        model.cells[cellAt(object->getPosition())].push_back(object);
+    }
+    model.count++;
+}
+
+bool ModelInstanceIndex::remove(InstanceObject* object) {
+    auto modelit = models.find(object->getModelInfo<BaseModelInfo>()->id());
+    if (modelit == models.end()) {
+        return false;
+    }
+    auto& model = modelit->second;
+
+    if (isMovable(object)) {
+        if (!eraseObject(model.movable, object)) {
+            return false;
+        }
+    } else {
+        auto cellit = model.cells.find(cellAt(object->getPosition()));
+        if (cellit == model.cells.end() ||
+            !eraseObject(cellit->second, object)) {
+            return false;
+        }
+        if (cellit->second.empty()) {
+            model.cells.erase(cellit);
+        }
+    }
+
+    if (--model.count == 0) {
+        models.erase(modelit);
+    }
+    return true;
+}
+
+void ModelInstanceIndex::move(InstanceObject* object, const glm::vec3& from,
+                              const glm::vec3& to) {
+    if (isMovable(object)) {
+        return;
+    }
+    const auto fromKey = cellAt(from);
+    const auto toKey = cellAt(to);
+    if (fromKey == toKey) {
+        return;
+    }
+
+    auto modelit = models.find(object->getModelInfo<BaseModelInfo>()->id());
+    if (modelit == models.end()) {
+        return;
+    }
+    auto& cells = modelit->second.cells;
+    auto cellit = cells.find(fromKey);
+    if (cellit == cells.end() || !eraseObject(cellit->second, object)) {
+        return;
+    }
+    if (cellit->second.empty()) {
+        cells.erase(cellit);
+    }
+    cells[toKey].push_back(object);
+}
+
+void ModelInstanceIndex::clear() {
+    models.clear();
+}
+
+void ModelInstanceIndex::findNear(ModelID model, const glm::vec2& centre,
+                                  float radius,
+                                  std::vector<InstanceObject*>& out) const {
+    out.clear();
+    auto modelit = models.find(model);
+    if (modelit == models.end()) {
+        return;
+    }
+    const auto& instances = modelit->second;
+
+    const auto inRange = [&](const InstanceObject* object) {
+        return glm::distance(glm::vec2(object->getPosition()), centre) <=
+               radius;
+    };
+
+    // Check the cells covering the circle, or each cell if that's fewer
+    const auto minX = cellCoord(centre.x - radius);
+    const auto maxX = cellCoord(centre.x + radius);
+    const auto minY = cellCoord(centre.y - radius);
+    const auto maxY = cellCoord(centre.y + radius);
+    const auto span = (std::int64_t{maxX} - minX + 1) *
+                      (std::int64_t{maxY} - minY + 1);
+    if (span < static_cast<std::int64_t>(instances.cells.size())) {
+        for (auto x = minX; x <= maxX; ++x) {
+            for (auto y = minY; y <= maxY; ++y) {
+                auto cellit = instances.cells.find(cellKey(x, y));
+                if (cellit == instances.cells.end()) {
+                    continue;
+                }
+                std::copy_if(cellit->second.begin(), cellit->second.end(),
+                             std::back_inserter(out), inRange);
+            }
+        }
+    } else {
+        for (const auto& cell : instances.cells) {
+            std::copy_if(cell.second.begin(), cell.second.end(),
+                         std::back_inserter(out), inRange);
+        }
+    }
+    std::copy_if(instances.movable.begin(), instances.movable.end(),
+                 std::back_inserter(out), inRange);
+
+    // Callers expect the same order as iterating the instance pool
+    std::sort(out.begin(), out.end(), [](const auto* a, const auto* b) {
+        return a->getGameObjectID() < b->getGameObjectID();
+    });
+}
+
+size_t ModelInstanceIndex::getInstanceCount(ModelID model) const {
+    auto modelit = models.find(model);
+    return modelit == models.end() ? 0 : modelit->second.count;
+}
@@ -0,0 +1,69 @@
+#ifndef _RWENGINE_MODELINSTANCEINDEX_HPP_
+#define _RWENGINE_MODELINSTANCEINDEX_HPP_
+
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+#include <glm/vec2.hpp>
+#include <glm/vec3.hpp>
+
+#include <data/ModelData.hpp>
+
+class InstanceObject;
+
+/**
+ * Finds the instances of a model without looking at every instance
+ *
+ * The instances of each model are bucketed by their XY position in a coarse
+ * grid. Instances with dynamics can be moved by physics, which doesn't go
+ * through setPosition, so they are kept in a list that every search checks.
+ */
+class ModelInstanceIndex {
+public:
+    static constexpr float kCellSize = 128.f;
+
+    void insert(InstanceObject* object);
+
+    /**
+     * @return false if the instance wasn't in the index
+     */
+    bool remove(InstanceObject* object);
+
+    /**
+     * Moves an instance to the bucket for its new position
+     */
+    void move(InstanceObject* object, const glm::vec3& from,
+              const glm::vec3& to);
+
+    void clear();
+
+    /**
+     * Finds the instances of a model within radius of a point on the XY
+     * plane, in the order they were created
+     */
+    void findNear(ModelID model, const glm::vec2& centre, float radius,
+                  std::vector<InstanceObject*>& out) const;
+
+    size_t getInstanceCount(ModelID model) const;
+
+private:
+    using CellKey = std::uint64_t;
+
+    struct ModelInstances {
+        std::unordered_map<CellKey, std::vector<InstanceObject*>> cells;
+        /// Instances that physics can move
+        std::vector<InstanceObject*> movable;
+        size_t count = 0;
+    };
+
+    static std::int32_t cellCoord(float p);
+    static CellKey cellKey(std::int32_t x, std::int32_t y);
+    static CellKey cellAt(const glm::vec3& position);
+    static bool isMovable(const InstanceObject* object);
+
+    std::unordered_map<ModelID, ModelInstances> models;
+};
+
+#endif
@@ -1,9 +1,12 @@
 #include "engine/Payphone.hpp"
 
+#include <vector>
+
 #include <rw/debug.hpp>
 
 #include "ai/PlayerController.hpp"
 
+#include "engine/GameData.hpp"
 #include "engine/GameState.hpp"
 #include "engine/GameWorld.hpp"
 
@@ -14,16 +17,15 @@
 Payphone::Payphone(GameWorld* engine_, size_t id_, const glm::vec2& coord)
     : engine(engine_), id(id_) {
     // Find payphone object, original game does this differently
-    for (const auto& p : engine->instancePool.objects) {
-        auto o = p.second.get();
+    std::vector<InstanceObject*> found;
+    engine->modelInstances.findNear(
+        engine->data->findModelObject("phonebooth1"), coord, 2.f, found);
+    for (const auto o : found) {
         if (!o->getClump()) {
             continue;
         }
-        if (o->getModelInfo<BaseModelInfo>()->name != "phonebooth1") {
-            continue;
-        }
         if (glm::distance(coord, glm::vec2(o->getPosition())) < 2.f) {
-            object = static_cast<InstanceObject*>(o);
+            object = o;
             break;
         }
     }
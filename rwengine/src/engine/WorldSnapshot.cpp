@@ -0,0 +1,420 @@
+#include "engine/WorldSnapshot.hpp"
+
+#include <algorithm>
+#include <functional>
+#include <iterator>
+
+#include <btBulletDynamicsCommon.h>
+
+#include <rw/debug.hpp>
+
+#include "ai/PlayerController.hpp"
+#include "core/Profiler.hpp"
+#include "dynamics/CollisionInstance.hpp"
+#include "engine/GameWorld.hpp"
+#include "engine/Garage.hpp"
+#include "engine/Payphone.hpp"
+#include "objects/InstanceObject.hpp"
+#include "objects/VehicleObject.hpp"
+
+namespace {
+template <class Record>
+const Record* findRecord(const std::vector<Record>& records, GameObjectID id) {
+    auto it = std::lower_bound(
+        records.begin(), records.end(), id,
+        [](const Record& r, GameObjectID value) { return r.object.id < value; });
+    return (it != records.end() && it->object.id == id) ? &*it : nullptr;
+}
+
+GameObject* findObject(GameWorld& world, GameObject::Type type,
+                       GameObjectID id) {
+    switch (type) {
+        case GameObject::Instance:
+            return world.instancePool.find(id);
+        case GameObject::Character:
+            return world.pedestrianPool.find(id);
+        case GameObject::Vehicle:
+            return world.vehiclePool.find(id);
+        case GameObject::Pickup:
+            return world.pickupPool.find(id);
+        case GameObject::Projectile:
+            return world.projectilePool.find(id);
+        case GameObject::Cutscene:
+            return world.cutscenePool.find(id);
+        default:
+            return nullptr;
+    }
+}
+
+void stopBody(btRigidBody* body) {
+    if (body) {
+        body->setLinearVelocity(btVector3(0.f, 0.f, 0.f));
+        body->setAngularVelocity(btVector3(0.f, 0.f, 0.f));
+    }
+}
+}  // namespace
+
+WorldSnapshot::ObjectRecord WorldSnapshot::record(const GameObject& object) {
+    return {object.getGameObjectID(),
+            static_cast<uint16_t>(object.getModelInfo<BaseModelInfo>()->id()),
+            object.getLifetime(), object.getPosition(), object.getRotation()};
+}
+
+WorldSnapshot::ScriptVariable WorldSnapshot::locate(
+    ScriptMachine& script, const ScriptInt* variable) {
+    if (!variable) {
+        return {};
+    }
+    const auto address = reinterpret_cast<const SCMByte*>(variable);
+    auto offsetIn = [address](const SCMByte* begin, size_t size,
+                              size_t& offset) {
+        if (std::less<const SCMByte*>()(address, begin) ||
+            !std::less<const SCMByte*>()(address, begin + size)) {
+            return false;
+        }
+        offset = static_cast<size_t>(address - begin);
+        return true;
+    };
+
+    ScriptVariable location;
+    const auto& globalData = script.getGlobalData();
+    if (offsetIn(globalData.data(), globalData.size(), location.offset)) {
+        location.storage = ScriptVariable::Global;
+        return location;
+    }
+    for (const auto& thread : script.getThreads()) {
+        if (offsetIn(thread.locals.data(), thread.locals.size(),
+                     location.offset)) {
+            location.storage = ScriptVariable::Local;
+            return location;
+        }
+        location.thread++;
+    }
+    RW_ERROR("Script variable is outside of the script's memory");
+    return {};
+}
+
+ScriptInt* WorldSnapshot::resolve(ScriptMachine& script,
+                                  const ScriptVariable& variable) {
+    SCMByte* memory = nullptr;
+    switch (variable.storage) {
+        case ScriptVariable::None:
+            return nullptr;
+        case ScriptVariable::Global:
+            memory = script.getGlobalData().data();
+            break;
+        case ScriptVariable::Local: {
+            auto& threads = script.getThreads();
+            RW_ASSERT(variable.thread < threads.size());
+            auto thread = std::next(
+                threads.begin(), static_cast<std::ptrdiff_t>(variable.thread));
+            memory = thread->locals.data();
+            break;
+        }
+    }
+    return reinterpret_cast<ScriptInt*>(memory + variable.offset);
+}
+
+void WorldSnapshot::restoreTransform(GameObject& object,
+                                     const ObjectRecord& record) {
+    object.setLifetime(record.lifetime);
+    object.setPosition(record.position);
+    object.setRotation(record.rotation);
+}
+
+void WorldSnapshot::capture(const GameState& state) {
+    RW_PROFILE_SCOPE(__func__);
+    RW_ASSERT(state.world && state.script);
+    clear();
+
+    auto& world = *state.world;
+
+    gameState = state;
+    gameState.world = nullptr;
+    gameState.script = nullptr;
+    gameState.scriptOnMissionFlag = nullptr;
+    gameState.scriptTimerVariable = nullptr;
+    gameState.missionObjects.clear();
+    for (GameObject* object : state.missionObjects) {
+        missionObjects.emplace_back(object->type(), object->getGameObjectID());
+    }
+
+    globals = state.script->getGlobalData();
+    threads = state.script->getThreads();
+    onMissionFlag = locate(*state.script, state.scriptOnMissionFlag);
+    timerVariable = locate(*state.script, state.scriptTimerVariable);
+
+    // Traffic is left to be spawned again, unless someone we keep is using it
+    for (const auto& [id, object] : world.pedestrianPool.objects) {
+        auto character = static_cast<CharacterObject*>(object.get());
+        if (character->getLifetime() == GameObject::TrafficLifetime) {
+            continue;
+        }
+        auto vehicle = character->getCurrentVehicle();
+        characters.push_back({record(*character), character->getCurrentState(),
+                              character->isPlayer(),
+                              vehicle ? vehicle->getGameObjectID() : 0,
+                              character->getCurrentSeat()});
+    }
+
+    for (const auto& [id, object] : world.vehiclePool.objects) {
+        auto vehicle = static_cast<VehicleObject*>(object.get());
+        const auto occupied =
+            std::any_of(characters.begin(), characters.end(),
+                        [&](const CharacterRecord& c) {
+                            return c.vehicle == vehicle->getGameObjectID();
+                        });
+        if (vehicle->getLifetime() == GameObject::TrafficLifetime &&
+            !occupied) {
+            continue;
+        }
+        vehicles.push_back({record(*vehicle), vehicle->health,
+                            vehicle->colourPrimary, vehicle->colourSecondary});
+    }
+
+    instances.reserve(world.instancePool.objects.size());
+    for (const auto& [id, object] : world.instancePool.objects) {
+        auto instance = static_cast<InstanceObject*>(object.get());
+        instances.push_back({record(*instance), instance->getHealth()});
+    }
+
+    for (const auto& [id, object] : world.pickupPool.objects) {
+        auto pickup = static_cast<PickupObject*>(object.get());
+        pickups.push_back({record(*pickup), pickup->getPickupType(),
+                           pickup->isEnabled(), pickup->isCollected()});
+    }
+
+    for (const auto& [id, object] : world.cutscenePool.objects) {
+        cutsceneObjects.push_back(id);
+    }
+
+    for (const auto& garage : world.garages) {
+        const auto target = garage->target;
+        garages.push_back({target ? target->getGameObjectID() : 0,
+                           target ? target->type() : GameObject::Unknown,
+                           garage->targetModel, garage->resprayDone});
+    }
+    payphoneCount = world.payphones.size();
+
+    captured = true;
+}
+
+bool WorldSnapshot::restore(GameState& state) const {
+    RW_PROFILE_SCOPE(__func__);
+    if (!captured) {
+        return false;
+    }
+    RW_ASSERT(state.world && state.script);
+
+    auto& world = *state.world;
+    auto& script = *state.script;
+
+    world.destroyQueuedObjects();
+    world.areaDamage.clear();
+
+    // Everyone gets out, the occupants are seated again once every vehicle
+    // exists
+    for (const auto& [id, object] : world.pedestrianPool.objects) {
+        auto character = static_cast<CharacterObject*>(object.get());
+        auto vehicle = character->getCurrentVehicle();
+        if (vehicle) {
+            const auto seat = character->getCurrentSeat();
+            vehicle->setOccupant(seat, nullptr);
+            character->setCurrentVehicle(nullptr, seat);
+        }
+    }
+
+    // Objects that weren't captured are removed, along with ones that have
+    // changed in ways that are easier to undo by creating them again
+    std::vector<GameObject*> removed;
+    for (const auto& [id, object] : world.pedestrianPool.objects) {
+        auto character = static_cast<CharacterObject*>(object.get());
+        // The player is revived instead, as controllers are kept by the world
+        if (character->isPlayer()) {
+            continue;
+        }
+        if (!findRecord(characters, id) || !character->isAlive()) {
+            removed.push_back(character);
+        }
+    }
+    for (const auto& [id, object] : world.vehiclePool.objects) {
+        auto vehicle = static_cast<VehicleObject*>(object.get());
+        const auto r = findRecord(vehicles, id);
+        if (!r || vehicle->health < r->health || vehicle->isWrecked()) {
+            removed.push_back(vehicle);
+        }
+    }
+    for (const auto& [id, object] : world.instancePool.objects) {
+        auto instance = static_cast<InstanceObject*>(object.get());
+        const auto r = findRecord(instances, id);
+        if (!r || r->object.model !=
+                      instance->getModelInfo<BaseModelInfo>()->id() ||
+            r->health != instance->getHealth()) {
+            removed.push_back(instance);
+        }
+    }
+    for (const auto& [id, object] : world.pickupPool.objects) {
+        if (!findRecord(pickups, id)) {
+            removed.push_back(object.get());
+        }
+    }
+    for (const auto& [id, object] : world.cutscenePool.objects) {
+        if (!std::binary_search(cutsceneObjects.begin(), cutsceneObjects.end(),
+                                id)) {
+            removed.push_back(object.get());
+        }
+    }
+    for (const auto& [id, object] : world.projectilePool.objects) {
+        removed.push_back(object.get());
+    }
+    for (GameObject* object : removed) {
+        world.destroyObject(object);
+    }
+
+    for (const auto& r : vehicles) {
+        auto vehicle =
+            static_cast<VehicleObject*>(world.vehiclePool.find(r.object.id));
+        if (!vehicle) {
+            vehicle = world.createVehicle(r.object.model, r.object.position,
+                                          r.object.rotation, r.object.id);
+            if (!vehicle) {
+                continue;
+            }
+        }
+        restoreTransform(*vehicle, r.object);
+        stopBody(vehicle->collision->getBulletBody());
+        vehicle->setThrottle(0.f);
+        vehicle->health = r.health;
+        vehicle->colourPrimary = r.colourPrimary;
+        vehicle->colourSecondary = r.colourSecondary;
+    }
+
+    for (const auto& r : characters) {
+        auto character = static_cast<CharacterObject*>(
+            world.pedestrianPool.find(r.object.id));
+        if (!character) {
+            character =
+                r.player ? world.createPlayer(r.object.position,
+                                              r.object.rotation, r.object.id)
+                         : world.createPedestrian(r.object.model,
+                                                  r.object.position,
+                                                  r.object.rotation,
+                                                  r.object.id);
+            if (!character) {
+                continue;
+            }
+        }
+        restoreTransform(*character, r.object);
+        character->getCurrentState() = r.state;
+        character->controller->skipActivity();
+        if (r.player) {
+            static_cast<ai::PlayerController*>(character->controller)
+                ->cancelRestart();
+        }
+
+        auto vehicle =
+            static_cast<VehicleObject*>(world.vehiclePool.find(r.vehicle));
+        if (vehicle && !vehicle->getOccupant(r.seat)) {
+            vehicle->setOccupant(r.seat, character);
+            character->setCurrentVehicle(vehicle, r.seat);
+        }
+    }
+
+    // Most of these are the static world, which is only touched if it moved
+    for (const auto& r : instances) {
+        auto instance =
+            static_cast<InstanceObject*>(world.instancePool.find(r.object.id));
+        if (!instance) {
+            instance = world.createInstance(r.object.model, r.object.position,
+                                            r.object.rotation, r.object.id);
+            if (instance) {
+                instance->setLifetime(r.object.lifetime);
+            }
+            continue;
+        }
+        if (instance->getPosition() != r.object.position ||
+            instance->getRotation() != r.object.rotation) {
+            restoreTransform(*instance, r.object);
+            if (instance->body) {
+                stopBody(instance->body->getBulletBody());
+            }
+        }
+    }
+
+    for (const auto& r : pickups) {
+        auto pickup =
+            static_cast<PickupObject*>(world.pickupPool.find(r.object.id));
+        if (!pickup) {
+            pickup = world.createPickup(r.object.position, r.object.model,
+                                        static_cast<int>(r.type), r.object.id);
+            if (!pickup) {
+                continue;
+            }
+        }
+        pickup->setLifetime(r.object.lifetime);
+        if (pickup->isEnabled() != r.enabled) {
+            pickup->setEnabled(r.enabled);
+        }
+        pickup->setCollected(r.collected);
+    }
+
+    // Garages and payphones are only ever added, by the script
+    RW_CHECK(world.garages.size() >= garages.size(), "Garages were removed");
+    if (world.garages.size() > garages.size()) {
+        world.garages.erase(
+            world.garages.begin() + static_cast<std::ptrdiff_t>(garages.size()),
+            world.garages.end());
+    }
+    for (size_t i = 0; i < world.garages.size(); ++i) {
+        auto& garage = *world.garages[i];
+        const auto& r = garages[i];
+        garage.target = findObject(world, r.targetType, r.target);
+        garage.targetModel = r.targetModel;
+        garage.resprayDone = r.resprayDone;
+    }
+    if (world.payphones.size() > payphoneCount) {
+        world.payphones.erase(
+            world.payphones.begin() + static_cast<std::ptrdiff_t>(payphoneCount),
+            world.payphones.end());
+    }
+
+    // The globals are copied in place, but the threads are replaced, so the
+    // pointers into script memory are looked up again below
+    auto& globalData = script.getGlobalData();
+    RW_ASSERT(globalData.size() == globals.size());
+    std::copy(globals.begin(), globals.end(), globalData.begin());
+    script.getThreads() = threads;
+
+    GameInputState input[2];
+    std::copy(std::begin(state.input), std::end(state.input), input);
+    state = gameState;
+    state.world = &world;
+    state.script = &script;
+    state.scriptOnMissionFlag = resolve(script, onMissionFlag);
+    state.scriptTimerVariable = resolve(script, timerVariable);
+    std::copy(std::begin(input), std::end(input), state.input);
+    for (const auto& [type, id] : missionObjects) {
+        if (auto object = findObject(world, type, id)) {
+            state.missionObjects.push_back(object);
+        }
+    }
+
+    return true;
+}
+
+void WorldSnapshot::clear() {
+    captured = false;
+    gameState = GameState();
+    missionObjects.clear();
+    globals.clear();
+    threads.clear();
+    onMissionFlag = {};
+    timerVariable = {};
+    characters.clear();
+    vehicles.clear();
+    instances.clear();
+    pickups.clear();
+    cutsceneObjects.clear();
+    garages.clear();
+    payphoneCount = 0;
+}
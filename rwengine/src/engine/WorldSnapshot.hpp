@@ -0,0 +1,134 @@
+#ifndef _RWENGINE_WORLDSNAPSHOT_HPP_
+#define _RWENGINE_WORLDSNAPSHOT_HPP_
+
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <utility>
+#include <vector>
+
+#include <glm/gtc/quaternion.hpp>
+#include <glm/gtc/type_precision.hpp>
+#include <glm/vec3.hpp>
+
+#include <engine/GameState.hpp>
+#include <objects/CharacterObject.hpp>
+#include <objects/GameObject.hpp>
+#include <objects/PickupObject.hpp>
+#include <script/ScriptMachine.hpp>
+
+/**
+ * Holds a copy of the game in memory, so it can be returned to a previous
+ * moment without reloading the world, e.g. to retry a mission.
+ *
+ * The static world and loaded models are left in place. Only the GameState,
+ * the script globals and threads, and the state of objects are recorded.
+ * Objects are matched by GameObjectID, so script handles stay valid: objects
+ * created since the capture are destroyed, and objects destroyed since are
+ * created again with the same ID.
+ */
+class WorldSnapshot {
+public:
+    /**
+     * Records the state, its world and its script
+     */
+    void capture(const GameState& state);
+
+    /**
+     * Returns the state, its world and its script to the captured moment.
+     * The world and script must be the ones that were captured
+     *
+     * @return false if nothing has been captured
+     */
+    bool restore(GameState& state) const;
+
+    bool isCaptured() const {
+        return captured;
+    }
+
+    void clear();
+
+private:
+    struct ObjectRecord {
+        GameObjectID id;
+        uint16_t model;
+        GameObject::ObjectLifetime lifetime;
+        glm::vec3 position;
+        glm::quat rotation;
+    };
+
+    struct CharacterRecord {
+        ObjectRecord object;
+        CharacterState state;
+        bool player;
+        /// The vehicle the character is sitting in, or 0
+        GameObjectID vehicle;
+        size_t seat;
+    };
+
+    struct VehicleRecord {
+        ObjectRecord object;
+        float health;
+        glm::u8vec3 colourPrimary;
+        glm::u8vec3 colourSecondary;
+    };
+
+    struct InstanceRecord {
+        ObjectRecord object;
+        float health;
+    };
+
+    struct PickupRecord {
+        ObjectRecord object;
+        PickupObject::PickupType type;
+        bool enabled;
+        bool collected;
+    };
+
+    struct GarageRecord {
+        GameObjectID target;
+        GameObject::Type targetType;
+        int targetModel;
+        bool resprayDone;
+    };
+
+    /// Where a pointer into script memory pointed, as the threads holding
+    /// locals are replaced when restoring
+    struct ScriptVariable {
+        enum Storage { None, Global, Local } storage = None;
+        /// Position of the thread in the thread list, for locals
+        size_t thread = 0;
+        size_t offset = 0;
+    };
+
+    static ObjectRecord record(const GameObject& object);
+    static ScriptVariable locate(ScriptMachine& script,
+                                 const ScriptInt* variable);
+    static ScriptInt* resolve(ScriptMachine& script,
+                              const ScriptVariable& variable);
+    static void restoreTransform(GameObject& object,
+                                 const ObjectRecord& record);
+
+    bool captured = false;
+
+    /// Doesn't reference the world or script, or any objects
+    GameState gameState;
+    std::vector<std::pair<GameObject::Type, GameObjectID>> missionObjects;
+
+    std::vector<SCMByte> globals;
+    std::list<SCMThread> threads;
+    ScriptVariable onMissionFlag;
+    ScriptVariable timerVariable;
+
+    // Sorted by ID
+    std::vector<CharacterRecord> characters;
+    std::vector<VehicleRecord> vehicles;
+    std::vector<InstanceRecord> instances;
+    std::vector<PickupRecord> pickups;
+    std::vector<GameObjectID> cutsceneObjects;
+
+    std::vector<GarageRecord> garages;
+    size_t payphoneCount = 0;
+};
+
+#endif
@@ -6,56 +6,60 @@
 #include <cctype>
 #include <memory>
 
-bool findKeyframes(float t, AnimationBone* bone, AnimationKeyframe& f1,
-                   AnimationKeyframe& f2, float& alpha) {
-    for (size_t f = 0; f < bone->frames.size(); ++f) {
-        if (t <= bone->frames[f].starttime) {
-            f2 = bone->frames[f];
-
-            if (f == 0) {
-                if (bone->frames.size() != 1) {
-                    f1 = bone->frames.back();
-                } else {
-                    f1 = f2;
-                }
-            } else {
-                f1 = bone->frames[f - 1];
-            }
+size_t AnimationBone::findKeyframe(float time, size_t cursor) const {
+    const auto count = frames.size();
+    auto isFirstAfter = [&](size_t f) {
+        return f < count && time <= frames[f].starttime &&
+               (f == 0 || frames[f - 1].starttime < time);
+    };
+
+    if (isFirstAfter(cursor)) {
+        return cursor;
+    }
+    if (isFirstAfter(cursor + 1)) {
+        return cursor + 1;
+    }
 
-            float tdiff = (f2.starttime - f1.starttime);
-            if (tdiff == 0.f) {
-                alpha = 1.f;
-            } else {
-                alpha = glm::clamp((t - f1.starttime) / tdiff, 0.f, 1.f);
-            }
+    auto it = std::lower_bound(frames.begin(), frames.end(), time,
+                               [](const AnimationKeyframe& kf, float t) {
+                                   return kf.starttime < t;
+                               });
+    return static_cast<size_t>(it - frames.begin());
+}
 
-            return true;
-        }
+AnimationKeyframe AnimationBone::getInterpolatedKeyframe(
+    float time, size_t& cursor) const {
+    const auto f = findKeyframe(time, cursor);
+    if (f >= frames.size()) {
+        return frames.back();
     }
-    return false;
-}
+    cursor = f;
 
-AnimationKeyframe AnimationBone::getInterpolatedKeyframe(float time) {
-    AnimationKeyframe f1, f2;
-    float alpha;
+    const auto& f2 = frames[f];
+    // Before the first keyframe, blend from the end of the loop
+    const auto& f1 = f == 0 ? frames.back() : frames[f - 1];
 
-    if (findKeyframes(time, this, f1, f2, alpha)) {
-        return {glm::normalize(glm::slerp(f1.rotation, f2.rotation, alpha)),
-                glm::mix(f1.position, f2.position, alpha),
-                glm::mix(f1.scale, f2.scale, alpha), time,
-                std::max(f1.id, f2.id)};
+    float alpha = 1.f;
+    float tdiff = (f2.starttime - f1.starttime);
+    if (tdiff != 0.f) {
+        alpha = glm::clamp((time - f1.starttime) / tdiff, 0.f, 1.f);
     }
 
-    return frames.back();
+    return {glm::normalize(glm::slerp(f1.rotation, f2.rotation, alpha)),
+            glm::mix(f1.position, f2.position, alpha),
+            glm::mix(f1.scale, f2.scale, alpha), time,
+            std::max(f1.id, f2.id)};
 }
 
-AnimationKeyframe AnimationBone::getKeyframe(float time) {
-    for (auto &frame : frames) {
-        if (time >= frame.starttime) {
-            return frame;
-        }
+AnimationKeyframe AnimationBone::getKeyframe(float time) const {
+    auto it = std::upper_bound(frames.begin(), frames.end(), time,
+                               [](float t, const AnimationKeyframe& kf) {
+                                   return t < kf.starttime;
+                               });
+    if (it == frames.begin()) {
+        return frames.front();
     }
-    return frames.back();
+    return *(it - 1);
 }
 
 bool LoaderIFP::loadFromMemory(char* data) {
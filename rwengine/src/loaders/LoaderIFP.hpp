@@ -56,8 +56,32 @@ struct AnimationBone {
 
     ~AnimationBone() = default;
 
-    AnimationKeyframe getInterpolatedKeyframe(float time);
-    AnimationKeyframe getKeyframe(float time);
+    /**
+     * Finds the first keyframe that starts at or after time.
+     *
+     * Playback usually moves forward by less than one keyframe, so the
+     * cursor from the previous lookup is checked first. Other times fall
+     * back to a binary search.
+     * @return the keyframe index, or frames.size() if time is past the end
+     */
+    size_t findKeyframe(float time, size_t cursor = 0) const;
+
+    AnimationKeyframe getInterpolatedKeyframe(float time) const {
+        size_t cursor = 0;
+        return getInterpolatedKeyframe(time, cursor);
+    }
+
+    /**
+     * Interpolates the keyframes around time, starting the search at cursor
+     * and updating it for the next call
+     */
+    AnimationKeyframe getInterpolatedKeyframe(float time,
+                                              size_t& cursor) const;
+
+    /**
+     * @return the last keyframe that starts at or before time
+     */
+    AnimationKeyframe getKeyframe(float time) const;
 };
 
 /**
@@ -38,6 +38,12 @@
 
 const float CharacterObject::DefaultJumpSpeed = 2.f;
 
+// Kinematic characters only update their animation every few frames
+constexpr unsigned int kKinematicAnimationInterval = 4;
+// How far kinematic characters look for the ground above and below their feet
+constexpr float kKinematicStepHeight = 1.f;
+constexpr float kKinematicDropHeight = 4.f;
+
 CharacterObject::CharacterObject(GameWorld* engine, const glm::vec3& pos,
                                  const glm::quat& rot, BaseModelInfo* modelinfo,
                                  ai::CharacterController* controller)
@@ -101,7 +107,9 @@ void CharacterObject::createActor(const glm::vec2& size) {
         engine->dynamicsWorld->addCollisionObject(
             physObject.get(), btBroadphaseProxy::KinematicFilter,
             btBroadphaseProxy::StaticFilter | btBroadphaseProxy::SensorTrigger);
-        engine->dynamicsWorld->addAction(physCharacter.get());
+        if (!kinematic) {
+            engine->dynamicsWorld->addAction(physCharacter.get());
+        }
     }
 }
 
@@ -285,6 +293,12 @@ glm::vec3 CharacterObject::updateMovementAnimation(float dt) {
 }
 
 void CharacterObject::tick(float dt) {
+    tickController(dt);
+    tickAnimation(dt);
+    applyTick();
+}
+
+void CharacterObject::tickController(float dt) {
     if (controller) {
         controller->update(dt);
 
@@ -293,9 +307,25 @@ void CharacterObject::tick(float dt) {
             cycle_ = AnimCycle::Idle;
         }
     }
+}
 
-    animator->tick(dt);
+void CharacterObject::tickAnimation(float dt) {
+    if (kinematic) {
+        // Nobody is close enough to notice a lower animation rate
+        skippedAnimationTime += dt;
+        if (++skippedAnimationFrames >= kKinematicAnimationInterval) {
+            animator->tick(skippedAnimationTime);
+            skippedAnimationTime = 0.f;
+            skippedAnimationFrames = 0;
+        }
+    } else {
+        animator->tick(dt);
+    }
     updateCharacter(dt);
+}
+
+void CharacterObject::applyTick() {
+    updateWater();
 
     // Ensure the character doesn't need to be reset
     if (getPosition().z < -100.f) {
@@ -306,7 +336,49 @@ void CharacterObject::tick(float dt) {
 void CharacterObject::tickPhysics(float dt) {
     if (physCharacter) {
         auto s = currenteMovementStep * dt;
-        physCharacter->setWalkDirection(btVector3(s.x, s.y, s.z));
+        if (kinematic) {
+            // Move the ghost directly, updateCharacter reads it back. Nothing
+            // else keeps it on the ground, so that is found with a ray
+            auto& wt = physObject->getWorldTransform();
+            auto origin = wt.getOrigin() + btVector3(s.x, s.y, 0.f);
+            const auto feet =
+                physShape->getHalfHeight() + physShape->getRadius();
+            const btVector3 from =
+                origin + btVector3(0.f, 0.f, kKinematicStepHeight - feet);
+            const btVector3 to =
+                origin - btVector3(0.f, 0.f, kKinematicDropHeight + feet);
+            btCollisionWorld::ClosestRayResultCallback ground(from, to);
+            ground.m_collisionFilterMask = btBroadphaseProxy::StaticFilter;
+            engine->dynamicsWorld->rayTest(from, to, ground);
+            if (ground.hasHit()) {
+                origin.setZ(ground.m_hitPointWorld.z() + feet);
+            }
+            wt.setOrigin(origin);
+        } else {
+            physCharacter->setWalkDirection(btVector3(s.x, s.y, s.z));
+        }
+    }
+}
+
+void CharacterObject::setKinematic(bool enable) {
+    if (kinematic == enable) {
+        return;
+    }
+    kinematic = enable;
+
+    if (physCharacter) {
+        if (kinematic) {
+            engine->dynamicsWorld->removeAction(physCharacter.get());
+        } else {
+            engine->dynamicsWorld->addAction(physCharacter.get());
+            physCharacter->warp(physObject->getWorldTransform().getOrigin());
+        }
+    }
+
+    if (!kinematic && skippedAnimationFrames > 0) {
+        animator->tick(skippedAnimationTime);
+        skippedAnimationTime = 0.f;
+        skippedAnimationFrames = 0;
     }
 }
 
@@ -383,48 +455,54 @@ void CharacterObject::updateCharacter(float dt) {
             physCharacter->getGhostObject()->getWorldTransform().getOrigin();
         position = glm::vec3(Pos.x(), Pos.y(), Pos.z());
         getClump()->getFrame()->setTranslation(position);
+    } else {
+        updateMovementAnimation(dt);
+    }
+}
+
+void CharacterObject::updateWater() {
+    if (!physCharacter) {
+        return;
+    }
+
+    // Handle above waist height water.
+    auto wi = engine->data->getWaterIndexAt(getPosition());
+    if (wi != NO_WATER_INDEX) {
+        float wh = engine->data->waterHeights[wi];
+        auto ws = getPosition();
+        wh += engine->data->getWaveHeightAt(ws);
+
+        // If Not in water before
+        //  If last position was above water
+        //   Now Underwater
+        //  Else Not Underwater
+        // Else
+        //  Underwater
 
-        // Handle above waist height water.
-        auto wi = engine->data->getWaterIndexAt(getPosition());
-        if (wi != NO_WATER_INDEX) {
-            float wh = engine->data->waterHeights[wi];
-            auto ws = getPosition();
-            wh += engine->data->getWaveHeightAt(ws);
-
-            // If Not in water before
-            //  If last position was above water
-            //   Now Underwater
-            //  Else Not Underwater
-            // Else
-            //  Underwater
-
-            if (!inWater && ws.z < wh && _lastHeight > wh) {
-                ws.z = wh;
-
-                btVector3 bpos(ws.x, ws.y, ws.z);
-                physCharacter->warp(bpos);
-                auto& wt = physObject->getWorldTransform();
-                wt.setOrigin(bpos);
-                physObject->setWorldTransform(wt);
+        if (!inWater && ws.z < wh && _lastHeight > wh) {
+            ws.z = wh;
+
+            btVector3 bpos(ws.x, ws.y, ws.z);
+            physCharacter->warp(bpos);
+            auto& wt = physObject->getWorldTransform();
+            wt.setOrigin(bpos);
+            physObject->setWorldTransform(wt);
 #if BT_BULLET_VERSION < 285
-                physCharacter->setGravity(0.f);
+            physCharacter->setGravity(0.f);
 #else
-                physCharacter->setGravity(btVector3(0.f, 0.f, 0.f));
+            physCharacter->setGravity(btVector3(0.f, 0.f, 0.f));
 #endif
-                inWater = true;
-            } else {
+            inWater = true;
+        } else {
 #if BT_BULLET_VERSION < 285
-                physCharacter->setGravity(9.81f);
+            physCharacter->setGravity(9.81f);
 #else
-                physCharacter->setGravity(btVector3(0.f, 0.f, -9.81f));
+            physCharacter->setGravity(btVector3(0.f, 0.f, -9.81f));
 #endif
-                inWater = false;
-            }
+            inWater = false;
         }
-        _lastHeight = getPosition().z;
-    } else {
-        updateMovementAnimation(dt);
     }
+    _lastHeight = getPosition().z;
 }
 
 void CharacterObject::setPosition(const glm::vec3& pos) {
@@ -78,6 +78,17 @@ private:
 
     AnimCycle cycle_ = AnimCycle::Idle;
 
+    /// Moving without the character controller, see setKinematic
+    bool kinematic = false;
+    /// Time not yet passed to the animator while kinematic
+    float skippedAnimationTime = 0.f;
+    unsigned int skippedAnimationFrames = 0;
+
+    /**
+     * Keeps the character afloat, this warps the physics body
+     */
+    void updateWater();
+
 public:
     static const float DefaultJumpSpeed;
 
@@ -105,10 +116,43 @@ public:
         return Character;
     }
 
+    /**
+     * Runs tickController, tickAnimation and applyTick. They are separate
+     * so the world can run the middle one for many characters at once, see
+     * GameWorld::tickObjects.
+     */
     void tick(float dt) override;
 
+    /**
+     * Runs the controller, which may change the world
+     */
+    void tickController(float dt);
+
+    /**
+     * Samples animation and works out movement. This only changes the
+     * character itself, so it is safe to run in parallel with others.
+     */
+    void tickAnimation(float dt);
+
+    /**
+     * Applies the parts of the update that reach outside the character
+     */
+    void applyTick();
+
     void tickPhysics(float dt);
 
+    /**
+     * Switches between the character controller and kinematic movement.
+     * Kinematic characters walk through other objects, following the
+     * height of the static world, and only update their animation every few
+     * frames.
+     */
+    void setKinematic(bool kinematic);
+
+    bool isKinematic() const {
+        return kinematic;
+    }
+
     const CharacterState& getCurrentState() const {
         return currentState;
     }
@@ -125,6 +169,8 @@ public:
 
     /**
      * @brief updateCharacter updates internall bullet Character.
+     *
+     * Only reads the physics state, water is handled in applyTick.
      */
     void updateCharacter(float dt);
 
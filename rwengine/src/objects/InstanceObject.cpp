@@ -60,9 +60,15 @@ InstanceObject::InstanceObject(GameWorld* engine, const glm::vec3& pos,
     if (SimpleModelInfo::isDoorModel(modelinfo->name)) {
         setStatic(true);
     }
+
+    if (needsPhysicsTick()) {
+        engine->activatePhysics(this);
+    }
 }
 
-InstanceObject::~InstanceObject() = default;
+InstanceObject::~InstanceObject() {
+    engine->deactivatePhysics(this);
+}
 
 void InstanceObject::tick(float dt) {
     RW_UNUSED(dt);
@@ -146,6 +152,25 @@ void InstanceObject::tickPhysics(float dt) {
     }
 }
 
+bool InstanceObject::needsPhysicsTick() const {
+    if (animator) {
+        return true;
+    }
+    if (!body || !dynamics) {
+        return false;
+    }
+    // Buoyancy has to keep checking the water height, even when asleep
+    return floating || changeAtomic != -1 ||
+           (usePhysics && body->getBulletBody()->isActive());
+}
+
+void InstanceObject::setFloating(bool f) {
+    floating = f;
+    if (needsPhysicsTick()) {
+        engine->activatePhysics(this);
+    }
+}
+
 void InstanceObject::changeModel(BaseModelInfo* incoming, int atomicNumber) {
     if (body) {
         body.reset();
@@ -156,7 +181,16 @@ void InstanceObject::changeModel(BaseModelInfo* incoming, int atomicNumber) {
             engine->data->loadModel(incoming->id());
         }
 
+        // New instances are added to the model index by the world
+        const auto current = getModelInfo<BaseModelInfo>();
+        const bool indexed = current && current != incoming &&
+                             engine->modelInstances.remove(this);
+
         changeModelInfo(incoming);
+
+        if (indexed) {
+            engine->modelInstances.insert(this);
+        }
         /// @todo this should only be temporary
         setModel(getModelInfo<SimpleModelInfo>()->getModel());
         auto collision = getModelInfo<SimpleModelInfo>()->getCollision();
@@ -177,6 +211,7 @@ void InstanceObject::changeModel(BaseModelInfo* incoming, int atomicNumber) {
 }
 
 void InstanceObject::setPosition(const glm::vec3& pos) {
+    engine->modelInstances.move(this, getPosition(), pos);
     if (body) {
         auto& wtr = body->getBulletBody()->getWorldTransform();
         wtr.setOrigin(btVector3(pos.x, pos.y, pos.z));
@@ -246,6 +281,9 @@ bool InstanceObject::takeDamage(const GameObject::DamageInfo& dmg) {
             default:
                 break;
         }
+
+        // Tick at least once to apply the changes, even if asleep
+        engine->activatePhysics(this);
     }
 
     return true;
@@ -21,6 +21,7 @@ class InstanceObject final : public GameObject {
     bool floating = false;
     bool static_ = false;
     bool usePhysics = false;
+    bool physicsActive = false;
     int changeAtomic = -1;
 
     /**
@@ -51,6 +52,24 @@ public:
 
     void tickPhysics(float dt);
 
+    /**
+     * @return true if tickPhysics has any work to do for this object. Bodies
+     * that only react to collisions can be skipped once Bullet puts them
+     * to sleep.
+     */
+    bool needsPhysicsTick() const;
+
+    /**
+     * Whether this object is in the world's physicsInstances list
+     */
+    bool isPhysicsActive() const {
+        return physicsActive;
+    }
+
+    void setPhysicsActive(bool active) {
+        physicsActive = active;
+    }
+
     void changeModel(BaseModelInfo* incoming, int atomicNumber = 0);
 
     void setPosition(const glm::vec3& pos) override;
@@ -75,9 +94,7 @@ public:
         return visible;
     }
 
-    void setFloating(bool f) {
-        floating = f;
-    }
+    void setFloating(bool f);
 
     bool isFloating() const {
         return floating;
@@ -64,25 +64,10 @@ void ProjectileObject::explode() {
         const float damageSize = 5.f;
         const float damage = static_cast<float>(_info.weapon->damage);
 
-        for (auto& o : engine->allObjects) {
-            if (o == this) continue;
-            switch (o->type()) {
-                case GameObject::Instance:
-                case GameObject::Vehicle:
-                case GameObject::Character:
-                    break;
-                default:
-                    continue;
-            }
-
-            float d = glm::distance(getPosition(), o->getPosition());
-            if (d > damageSize) continue;
-
-            o->takeDamage({DamageInfo::DamageType::Explosion,
-                           getPosition(), getPosition(),
-                           damage / glm::max(d, 1.f),
-                           0.f});
-        }
+        AreaDamage::Request request{DamageInfo::DamageType::Explosion,
+                                    getPosition(), damageSize, damage, this};
+        request.falloff = true;
+        engine->areaDamage.queue(request);
 
         auto& explosion = engine->createParticleEffect();
 
@@ -328,6 +328,11 @@ void VehicleObject::tickPhysics(float dt) {
 
     static constexpr float steeringWeight = 1.f/0.35f;
 
+    if (kinematic) {
+        tickKinematic(dt);
+        return;
+    }
+
     if (physVehicle) {
         // todo: a real engine function
         float velFac = info->handling.maxVelocity;
@@ -447,22 +452,7 @@ void VehicleObject::tickPhysics(float dt) {
             }
         }
 
-        // Update passenger positions
-        for (auto& [seatId, objectPtr] : seatOccupants) {
-            auto character = static_cast<CharacterObject*>(objectPtr);
-
-            glm::vec3 passPosition{};
-            if (character->isEnteringOrExitingVehicle()) {
-                passPosition = getSeatEntryPositionWorld(seatId);
-            } else {
-                passPosition = getPosition();
-                if (seatId < info->seats.size()) {
-                    passPosition +=
-                        getRotation() * (info->seats[seatId].offset);
-                }
-            }
-            objectPtr->updateTransform(passPosition, getRotation());
-        }
+        updateOccupantTransforms();
 
         if (getVehicle()->vehicletype_ == VehicleModelInfo::BOAT) {
             if (isInWater()) {
@@ -617,6 +607,74 @@ void VehicleObject::tickPhysics(float dt) {
     }
 }
 
+void VehicleObject::updateOccupantTransforms() {
+    for (auto& [seatId, objectPtr] : seatOccupants) {
+        auto character = static_cast<CharacterObject*>(objectPtr);
+
+        glm::vec3 passPosition{};
+        if (character->isEnteringOrExitingVehicle()) {
+            passPosition = getSeatEntryPositionWorld(seatId);
+        } else {
+            passPosition = getPosition();
+            if (seatId < info->seats.size()) {
+                passPosition += getRotation() * (info->seats[seatId].offset);
+            }
+        }
+        objectPtr->updateTransform(passPosition, getRotation());
+    }
+}
+
+void VehicleObject::setKinematic(bool enable) {
+    if (kinematic == enable) {
+        return;
+    }
+
+    auto body = collision->getBulletBody();
+    if (enable) {
+        kinematicSpeed = std::max(0.f, getVelocity());
+        hasKinematicTarget = false;
+        engine->dynamicsWorld->removeAction(physVehicle.get());
+        body->setLinearVelocity(btVector3(0.f, 0.f, 0.f));
+        body->setAngularVelocity(btVector3(0.f, 0.f, 0.f));
+        body->forceActivationState(DISABLE_SIMULATION);
+    } else {
+        engine->dynamicsWorld->addAction(physVehicle.get());
+        body->forceActivationState(DISABLE_DEACTIVATION);
+        // Keep driving at the same speed
+        auto velocity = getRotation() * glm::vec3(0.f, kinematicSpeed, 0.f);
+        body->setLinearVelocity(btVector3(velocity.x, velocity.y, velocity.z));
+    }
+    kinematic = enable;
+}
+
+void VehicleObject::setKinematicTarget(const glm::vec3& target, float speed) {
+    if (!hasKinematicTarget) {
+        kinematicHeight = getPosition().z - target.z;
+        hasKinematicTarget = true;
+    }
+    kinematicTarget = target;
+    kinematicSpeed = speed;
+}
+
+void VehicleObject::tickKinematic(float dt) {
+    if (hasKinematicTarget) {
+        auto position = getPosition();
+        auto goal = kinematicTarget + glm::vec3(0.f, 0.f, kinematicHeight);
+        auto delta = goal - position;
+        auto distance = glm::length(glm::vec2(delta));
+        if (distance > 0.01f) {
+            auto step = std::min(distance, kinematicSpeed * dt);
+            setPosition(position + delta * (step / distance));
+            // The chassis faces along +Y
+            auto heading = std::atan2(delta.y, delta.x) - glm::half_pi<float>();
+            setRotation(glm::angleAxis(heading, glm::vec3(0.f, 0.f, 1.f)));
+            engine->dynamicsWorld->updateSingleAabb(collision->getBulletBody());
+        }
+    }
+
+    updateOccupantTransforms();
+}
+
 bool VehicleObject::isFlipped() const {
     auto forward = getRotation() * glm::vec3(0.f, 0.f, 1.f);
     return forward.z <= -0.97f;
@@ -628,6 +686,9 @@ bool VehicleObject::isUpright() const {
 }
 
 float VehicleObject::getVelocity() const {
+    if (kinematic) {
+        return kinematicSpeed;
+    }
     if (physVehicle) {
         return (physVehicle->getCurrentSpeedKmHour() * 1000.f) / (60.f * 60.f);
     }
@@ -47,6 +47,14 @@ private:
     bool handbrake = true;
     std::vector<btScalar> wheelsRotation;
 
+    /// Moving along the road graph without raycast vehicle physics
+    bool kinematic = false;
+    bool hasKinematicTarget = false;
+    glm::vec3 kinematicTarget{};
+    float kinematicSpeed = 0.f;
+    /// Height of the chassis above the road nodes
+    float kinematicHeight = 0.f;
+
     Atomic* chassishigh_ = nullptr;
     Atomic* chassislow_ = nullptr;
 
@@ -151,6 +159,22 @@ public:
 
     void tickPhysics(float dt);
 
+    /**
+     * Switches between full physics and kinematic movement. Kinematic
+     * vehicles are taken out of the simulation and move straight towards
+     * the target set with setKinematicTarget.
+     */
+    void setKinematic(bool kinematic);
+
+    bool isKinematic() const {
+        return kinematic;
+    }
+
+    /**
+     * Sets the point a kinematic vehicle drives towards, and its speed
+     */
+    void setKinematicTarget(const glm::vec3& target, float speed);
+
     bool isFlipped() const;
 
     bool isUpright() const;
@@ -246,6 +270,8 @@ public:
     std::tuple<glm::vec3, glm::vec3> obstacleCheckVolume() const;
 
 private:
+    void tickKinematic(float dt);
+    void updateOccupantTransforms();
     void setupModel();
     void registerPart(ModelFrame* mf);
     void createObjectHinge(Part* part);
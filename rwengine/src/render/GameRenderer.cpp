@@ -4,18 +4,21 @@
 #include <cstdint>
 #include <cmath>
 #include <string>
+#include <tuple>
 #include <vector>
 
 #include <glm/gtc/constants.hpp>
 #include <glm/gtc/type_ptr.hpp>
 #include <glm/gtc/matrix_transform.hpp>
 #include <glm/gtc/quaternion.hpp>
+#include <glm/gtx/norm.hpp>
 
 #include <gl/TextureData.hpp>
 #include <rw/types.hpp>
 
 #include "core/Logger.hpp"
 #include "core/Profiler.hpp"
+#include "core/Telemetry.hpp"
 #include "engine/GameData.hpp"
 #include "engine/GameState.hpp"
 #include "engine/GameWorld.hpp"
@@ -23,6 +26,7 @@
 #include "objects/GameObject.hpp"
 #include "render/ObjectRenderer.hpp"
 #include "render/GameShaders.hpp"
+#include "render/ShaderCache.hpp"
 #include "render/VisualFX.hpp"
 
 constexpr size_t skydomeSegments = 8, skydomeRows = 10;
@@ -40,9 +44,11 @@ struct ParticleVert {
     float r, g, b;
 };
 
-GameRenderer::GameRenderer(Logger* log, GameData* _data)
+GameRenderer::GameRenderer(Logger* log, GameData* _data,
+                           const rwfs::path& shaderCacheDirectory)
     : data(_data)
     , logger(log)
+    , renderer(std::make_unique<OpenGLRenderer>(shaderCacheDirectory))
     , map(*renderer, _data)
     , water(*this)
     , text(*this) {
@@ -66,6 +72,8 @@ GameRenderer::GameRenderer(Logger* log, GameData* _data)
 
     skyProg = renderer->createShader(GameShaders::Sky::VertexShader,
                                      GameShaders::Sky::FragmentShader);
+    skyTopColour = renderer->getUniform(skyProg.get(), "TopColor");
+    skyBottomColour = renderer->getUniform(skyProg.get(), "BottomColor");
 
     renderer->setProgramBlockBinding(skyProg.get(), "SceneData", 1);
 
@@ -155,6 +163,14 @@ GameRenderer::GameRenderer(Logger* log, GameData* _data)
     particleDraw.addGeometry(&particleGeom);
     particleDraw.setFaceType(GL_TRIANGLE_STRIP);
 
+    // Batched draws are indexed
+    glGenBuffers(1, &particleIBO);
+    const GLuint particleIndices[] = {0, 1, 2, 3};
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, particleIBO);
+    glBufferData(GL_ELEMENT_ARRAY_BUFFER, sizeof(particleIndices),
+                 particleIndices, GL_STATIC_DRAW);
+    glBindVertexArray(0);
+
     ssRectGeom.uploadVertices<VertexP2>({{-1.f, -1.f}, {1.f, -1.f}, {-1.f, 1.f}, {1.f, 1.f}});
     ssRectDraw.addGeometry(&ssRectGeom);
     ssRectDraw.setFaceType(GL_TRIANGLE_STRIP);
@@ -162,11 +178,21 @@ GameRenderer::GameRenderer(Logger* log, GameData* _data)
     ssRectProg =
         renderer->createShader(GameShaders::ScreenSpaceRect::VertexShader,
                                GameShaders::ScreenSpaceRect::FragmentShader);
-    renderer->setUniform(ssRectProg.get(), "texture", 0);
+    renderer->setUniformTexture(ssRectProg.get(), "texture", 0);
+    ssRectColour = renderer->getUniform(ssRectProg.get(), "colour");
+    ssRectSize = renderer->getUniform(ssRectProg.get(), "size");
+    ssRectOffset = renderer->getUniform(ssRectProg.get(), "offset");
+
+    if (auto cache =
+            static_cast<OpenGLRenderer&>(*renderer).getShaderCache()) {
+        logger->info("Renderer", "Shader cache: ", cache->getHitCount(),
+                     " loaded, ", cache->getMissCount(), " compiled");
+    }
 }
 
 GameRenderer::~GameRenderer() {
     glDeleteFramebuffers(1, &framebufferName);
+    glDeleteBuffers(1, &particleIBO);
 }
 
 void GameRenderer::setupRender() {
@@ -234,6 +260,7 @@ void GameRenderer::renderWorld(GameWorld* world, const ViewCamera& camera,
     }
 
     culled = 0;
+    occluded = 0;
 
     renderer->pushDebugGroup("Water");
 
@@ -252,10 +279,8 @@ void GameRenderer::renderWorld(GameWorld* world, const ViewCamera& camera,
     dp.count = skydomeSegments * skydomeRows * 6;
 
     renderer->useProgram(skyProg.get());
-    renderer->setUniform(skyProg.get(), "TopColor",
-                         glm::vec4{weather.skyTopColor, 1.f});
-    renderer->setUniform(skyProg.get(), "BottomColor",
-                         glm::vec4{weather.skyBottomColor, 1.f});
+    renderer->setUniform(skyTopColour, glm::vec4{weather.skyTopColor, 1.f});
+    renderer->setUniform(skyBottomColour, glm::vec4{weather.skyBottomColor, 1.f});
 
     renderer->draw(glm::mat4(1.0f), &skyDbuff, dp);
 
@@ -297,7 +322,7 @@ void GameRenderer::renderObjects(const GameWorld *world) {
     RW_PROFILE_SCOPE(__func__);
 
     renderer->useProgram(worldProg.get());
-    RenderList renderList = createObjectRenderList(world);
+    createObjectRenderList(world);
 
     renderer->pushDebugGroup("Objects");
     renderer->pushDebugGroup("RenderList");
@@ -307,17 +332,21 @@ void GameRenderer::renderObjects(const GameWorld *world) {
     profObjects = renderer->popDebugGroup();
 }
 
-RenderList GameRenderer::createObjectRenderList(const GameWorld *world) {
+const RenderList& GameRenderer::createObjectRenderList(const GameWorld *world) {
     RW_PROFILE_SCOPE(__func__);
+    RW_TELEMETRY_SCOPE(RenderList);
     // This is sequential at the moment, it should be easy to make it
     // run in parallel with a good threading system.
-    RenderList renderList;
+    renderList.clear();
     // Naive optimisation, assume 50% hitrate
     renderList.reserve(static_cast<size_t>(world->allObjects.size() * 0.5f));
 
     ObjectRenderer objectRenderer(_renderWorld,
                                   (cullOverride ? cullingCamera : _camera),
                                   _renderAlpha);
+    if (occlusionCulling) {
+        objectRenderer.buildOcclusion(occlusion);
+    }
 
     // World Objects
     for (auto object : world->allObjects) {
@@ -368,11 +397,13 @@ RenderList GameRenderer::createObjectRenderList(const GameWorld *world) {
         objectRenderer.renderClump(arrowModel.get(), model, nullptr, renderList);
     }
     culled += objectRenderer.culled;
+    occluded += objectRenderer.occluded;
 
     RW_PROFILE_SCOPE("sortRenderList");
     // Also parallelizable
     // Earlier position in the array means earlier object's rendering
     // Transparent objects should be sorted and rendered after opaque
+    // Opaque objects are grouped by geometry so the renderer can instance them
     sort(renderList.begin(), renderList.end(),
          [](const Renderer::RenderInstruction &a,
             const Renderer::RenderInstruction &b) {
@@ -380,6 +411,10 @@ RenderList GameRenderer::createObjectRenderList(const GameWorld *world) {
                  return true;
              if (a.drawInfo.blendMode != BlendMode::BLEND_NONE && b.drawInfo.blendMode == BlendMode::BLEND_NONE)
                  return false;
+             if (a.drawInfo.blendMode == BlendMode::BLEND_NONE) {
+                 return std::tie(a.dbuff, a.drawInfo.start, a.drawInfo.textures, a.sortKey) >
+                        std::tie(b.dbuff, b.drawInfo.start, b.drawInfo.textures, b.sortKey);
+             }
              return (a.sortKey > b.sortKey);
          });
 
@@ -406,9 +441,9 @@ void GameRenderer::renderSplash(GameWorld* world, GLuint splashTexName, glm::u16
     glm::vec4 fadeNormed(fc.r / 255.f, fc.g / 255.f, fc.b / 255.f, a);
 
     renderer->useProgram(ssRectProg.get());
-    renderer->setUniform(ssRectProg.get(), "colour", fadeNormed);
-    renderer->setUniform(ssRectProg.get(), "size", glm::vec2{1.f, 1.f});
-    renderer->setUniform(ssRectProg.get(), "offset", glm::vec2{0.f, 0.f});
+    renderer->setUniform(ssRectColour, fadeNormed);
+    renderer->setUniform(ssRectSize, glm::vec2{1.f, 1.f});
+    renderer->setUniform(ssRectOffset, glm::vec2{0.f, 0.f});
 
     Renderer::DrawParameters wdp;
     wdp.depthMode = DepthMode::OFF;
@@ -437,24 +472,35 @@ void GameRenderer::renderPostProcess() {
 }
 
 void GameRenderer::renderEffects(GameWorld* world) {
+    RW_PROFILE_SCOPE(__func__);
     renderer->useProgram(particleProg.get());
 
     auto cpos = _camera.position;
     auto cfwd = glm::normalize(glm::inverse(_camera.rotation) *
                                glm::vec3(0.f, 1.f, 0.f));
 
-    auto& effects = world->effects;
+    const auto& particles = world->particles.getParticles();
 
-    std::sort(effects.begin(), effects.end(),
-              [&](const auto& a, const auto& b) {
-                  return glm::distance(a->position, cpos) >
-                         glm::distance(b->position, cpos);
+    // Work out the keys once instead of in every comparison. Additive
+    // blending doesn't depend on order, so particles are grouped by texture
+    // first and only drawn back to front within a group.
+    particleKeys.clear();
+    for (size_t i = 0; i < particles.size(); ++i) {
+        const auto particle = particles[i];
+        particleKeys.push_back({particle->texture->getName(),
+                                glm::distance2(particle->position, cpos), i});
+    }
+    std::sort(particleKeys.begin(), particleKeys.end(),
+              [](const ParticleKey& a, const ParticleKey& b) {
+                  if (a.texture != b.texture) {
+                      return a.texture < b.texture;
+                  }
+                  return a.depth > b.depth;
               });
 
-    for (auto& fx : effects) {
-        // Other effects not implemented yet
-        if (fx->getType() != Particle) continue;
-        auto particle = static_cast<ParticleFX*>(fx.get());
+    particleList.clear();
+    for (const auto& key : particleKeys) {
+        auto particle = particles[key.index];
 
         auto& p = particle->position;
 
@@ -481,16 +527,22 @@ void GameRenderer::renderEffects(GameWorld* world) {
             glm::vec3(particle->size,1.0f)) * glm::inverse(lookMat);
 
         Renderer::DrawParameters dp;
-        dp.textures = {{particle->texture->getName()}};
+        dp.textures = {{key.texture}};
         dp.ambient = 1.f;
         dp.colour = glm::u8vec4(particle->colour * 255.f);
         dp.start = 0;
         dp.count = 4;
         dp.blendMode = BlendMode::BLEND_ADDITIVE;
+        // Keeps the result independent of the order within the batch
+        dp.depthWrite = false;
         dp.diffuse = 1.f;
 
-        renderer->drawArrays(transformMat, &particleDraw, dp);
+        particleList.emplace_back(0, transformMat, &particleDraw, dp);
     }
+
+    // Particles with the same texture only differ by their uniforms, so
+    // they are drawn as instances
+    renderer->drawBatched(particleList);
 }
 
 void GameRenderer::drawTexture(TextureData* texture, glm::vec4 extents) {
@@ -502,6 +554,9 @@ void GameRenderer::drawColour(const glm::vec4& colour, glm::vec4 extents) {
 }
 
 void GameRenderer::drawRect(const glm::vec4& colour, TextureData* texture, glm::vec4& extents) {
+    // Keep queued text below the rectangle
+    text.flush();
+
     // Move into NDC
     extents.x /= renderer->getViewport().x;
     extents.y /= renderer->getViewport().y;
@@ -514,9 +569,9 @@ void GameRenderer::drawRect(const glm::vec4& colour, TextureData* texture, glm::
     extents *= glm::vec4(2.f, -2.f, 1.f, 1.f);
 
     renderer->useProgram(ssRectProg.get());
-    renderer->setUniform(ssRectProg.get(), "colour", colour);
-    renderer->setUniform(ssRectProg.get(), "size", glm::vec2{extents.z, extents.w});
-    renderer->setUniform(ssRectProg.get(), "offset", glm::vec2{extents.x, extents.y});
+    renderer->setUniform(ssRectColour, colour);
+    renderer->setUniform(ssRectSize, glm::vec2{extents.z, extents.w});
+    renderer->setUniform(ssRectOffset, glm::vec2{extents.x, extents.y});
 
     Renderer::DrawParameters wdp;
     wdp.depthMode = DepthMode::OFF;
@@ -530,9 +585,9 @@ void GameRenderer::drawRect(const glm::vec4& colour, TextureData* texture, glm::
 void GameRenderer::renderLetterbox() {
     constexpr float cinematicExperienceSize = 0.15f;
     renderer->useProgram(ssRectProg.get());
-    renderer->setUniform(ssRectProg.get(), "colour", glm::vec4{0.f, 0.f, 0.f, 1.f});
-    renderer->setUniform(ssRectProg.get(), "size", glm::vec2{1.f, cinematicExperienceSize});
-    renderer->setUniform(ssRectProg.get(), "offset", glm::vec2{0.f,-1.f * (1.f - cinematicExperienceSize)});
+    renderer->setUniform(ssRectColour, glm::vec4{0.f, 0.f, 0.f, 1.f});
+    renderer->setUniform(ssRectSize, glm::vec2{1.f, cinematicExperienceSize});
+    renderer->setUniform(ssRectOffset, glm::vec2{0.f,-1.f * (1.f - cinematicExperienceSize)});
     Renderer::DrawParameters wdp;
     wdp.depthMode = DepthMode::OFF;
     wdp.blendMode = BlendMode::BLEND_NONE;
@@ -540,7 +595,7 @@ void GameRenderer::renderLetterbox() {
     wdp.textures = {{0}};
 
     renderer->drawArrays(glm::mat4(1.0f), &ssRectDraw, wdp);
-    renderer->setUniform(ssRectProg.get(), "offset", glm::vec2{0.f, 1.f * (1.f - cinematicExperienceSize)});
+    renderer->setUniform(ssRectOffset, glm::vec2{0.f, 1.f * (1.f - cinematicExperienceSize)});
     renderer->drawArrays(glm::mat4(1.0f), &ssRectDraw, wdp);
 }
 
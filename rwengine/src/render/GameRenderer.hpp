@@ -3,6 +3,7 @@
 
 #include <cstddef>
 #include <memory>
+#include <vector>
 
 #include <gl/DrawBuffer.hpp>
 #include <gl/GeometryBuffer.hpp>
@@ -11,6 +12,7 @@
 
 #include <render/OpenGLRenderer.hpp>
 #include <render/MapRenderer.hpp>
+#include <render/OcclusionBuffer.hpp>
 #include <render/TextRenderer.hpp>
 #include <render/ViewCamera.hpp>
 #include <render/WaterRenderer.hpp>
@@ -50,6 +52,12 @@ class GameRenderer {
 
     /** Number of culling events */
     size_t culled;
+    /** Objects in the frustum hidden by occluders */
+    size_t occluded = 0;
+
+    /** Reused by createObjectRenderList each frame */
+    OcclusionBuffer occlusion;
+    bool occlusionCulling = true;
 
     GLuint framebufferName;
     GLuint fbTextures[2];
@@ -58,12 +66,31 @@ class GameRenderer {
 
     GeometryBuffer particleGeom;
     DrawBuffer particleDraw;
+    GLuint particleIBO = 0;
+
+    struct ParticleKey {
+        GLuint texture;
+        float depth;
+        size_t index;
+    };
+
+    /** Reused by renderEffects each frame */
+    std::vector<ParticleKey> particleKeys;
+    RenderList particleList;
+
+    /** Reused by createObjectRenderList each frame */
+    RenderList renderList;
 
     GeometryBuffer ssRectGeom;
     DrawBuffer ssRectDraw;
 
 public:
-    GameRenderer(Logger* log, GameData* data);
+    /**
+     * @param shaderCacheDirectory Where to keep linked program binaries,
+     * shaders are compiled on every launch if empty
+     */
+    GameRenderer(Logger* log, GameData* data,
+                 const rwfs::path& shaderCacheDirectory = {});
     ~GameRenderer();
 
     std::unique_ptr<Renderer::ShaderProgram> worldProg;
@@ -72,6 +99,12 @@ public:
 
     std::unique_ptr<Renderer::ShaderProgram> ssRectProg;
 
+    Renderer::Uniform skyTopColour;
+    Renderer::Uniform skyBottomColour;
+    Renderer::Uniform ssRectColour;
+    Renderer::Uniform ssRectSize;
+    Renderer::Uniform ssRectOffset;
+
     GLuint skydomeIBO;
 
     DrawBuffer skyDbuff;
@@ -85,6 +118,18 @@ public:
         return culled;
     }
 
+    size_t getOccludedCount() {
+        return occluded;
+    }
+
+    bool isOcclusionCulling() const {
+        return occlusionCulling;
+    }
+
+    void setOcclusionCulling(bool enabled) {
+        occlusionCulling = enabled;
+    }
+
     /**
      * Renders the world using the parameters of the passed Camera.
      * Note: The camera's near and far planes are overriden by weather effects.
@@ -164,7 +209,11 @@ private:
 
     void renderObjects(const GameWorld *world);
 
-    RenderList createObjectRenderList(const GameWorld *world);
+    /**
+     * @return The visible objects, sorted for drawing. Valid until the next
+     * call
+     */
+    const RenderList& createObjectRenderList(const GameWorld *world);
 };
 
 #endif
@@ -1,6 +1,10 @@
 #ifndef _RWENGINE_GAMESHADERS_HPP_
 #define _RWENGINE_GAMESHADERS_HPP_
 
+#include <string>
+
+#include <render/OpenGLRenderer.hpp>
+
 /**
  * @brief collection of shaders to make managing them a little easier.
  */
@@ -156,8 +160,9 @@ struct Sky {
 };
 
 struct WorldObject {
-    static constexpr char const* VertexShader =
-        R"(
+    /** Sized for Renderer::kMaxInstances entries in ObjectData */
+    static inline const std::string VertexShader =
+        std::string(R"(
             #version 330
 
             layout(location = 0) in vec3 position;
@@ -168,6 +173,9 @@ struct WorldObject {
             out vec2 TexCoords;
             out vec4 Colour;
             out vec4 WorldSpace;
+            flat out vec4 ObjectColour;
+            flat out float AmbientFactor;
+            flat out float Visibility;
 
             layout(std140) uniform SceneData {
                 mat4 projection;
@@ -180,7 +188,7 @@ struct WorldObject {
                 float fogEnd;
             };
 
-            layout(std140) uniform ObjectData {
+            struct ObjectEntry {
                 mat4 model;
                 vec4 colour;
                 float diffusefac;
@@ -188,11 +196,21 @@ struct WorldObject {
                 float visibility;
             };
 
+            // Instanced draws use one entry per instance
+            layout(std140) uniform ObjectData {
+                ObjectEntry objects[)") +
+        std::to_string(Renderer::kMaxInstances) + R"(];
+            };
+
             void main() {
+                ObjectEntry object = objects[gl_InstanceID];
                 Normal = normal;
                 TexCoords = texCoords;
                 Colour = _colour;
-                vec4 worldspace = model * vec4(position, 1.0);
+                ObjectColour = object.colour;
+                AmbientFactor = object.ambientfac;
+                Visibility = object.visibility;
+                vec4 worldspace = object.model * vec4(position, 1.0);
                 vec4 viewspace = view * worldspace;
                 gl_Position = projection * viewspace;
 
@@ -206,6 +224,8 @@ struct WorldObject {
             in vec2 TexCoords;
             in vec4 Colour;
             in vec4 WorldSpace;
+            flat in vec4 ObjectColour;
+            flat in float AmbientFactor;
             uniform sampler2D tex;
             out vec4 fragOut;
 
@@ -220,21 +240,13 @@ struct WorldObject {
                 float fogEnd;
             };
 
-            layout(std140) uniform ObjectData {
-                mat4 model;
-                vec4 colour;
-                float diffusefac;
-                float ambientfac;
-                float visibility;
-            };
-
             float alphaThreshold = (1.0/255.0);
 
             void main() {
                 // Only the visibility parameter invokes the screen door.
                 vec4 diffuse = Colour;
-                diffuse.rgb += ambient.rgb*ambientfac;
-                diffuse *= colour;
+                diffuse.rgb += ambient.rgb*AmbientFactor;
+                diffuse *= ObjectColour;
                 diffuse *= texture(tex, TexCoords);
                 if(diffuse.a <= alphaThreshold) discard;
                 float fog = 1.0 - clamp( (fogEnd-WorldSpace.w)/(fogEnd-fogStart), 0.0, 1.0 );
@@ -251,6 +263,8 @@ struct Particle {
             in vec3 Normal;
             in vec2 TexCoords;
             in vec4 Colour;
+            flat in vec4 ObjectColour;
+            flat in float Visibility;
             uniform sampler2D tex;
             out vec4 outColour;
 
@@ -265,14 +279,6 @@ struct Particle {
                 float fogEnd;
             };
 
-            layout(std140) uniform ObjectData {
-                mat4 model;
-                vec4 colour;
-                float diffusefac;
-                float ambientfac;
-                float visibility;
-            };
-
             #define ALPHA_DISCARD_THRESHOLD 0.01
 
             void main() {
@@ -281,7 +287,7 @@ struct Particle {
                 if(c.a <= ALPHA_DISCARD_THRESHOLD) discard;
                 float fogZ = (gl_FragCoord.z / gl_FragCoord.w);
                 float fogfac = clamp( (fogStart-fogZ)/(fogEnd-fogStart), 0.0, 1.0 );
-                vec4 tint = vec4(colour.rgb, visibility);
+                vec4 tint = vec4(ObjectColour.rgb, Visibility);
                 outColour = c * tint;
             })";
 };
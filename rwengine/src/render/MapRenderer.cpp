@@ -1,7 +1,9 @@
 #include "render/MapRenderer.hpp"
 
+#include <algorithm>
 #include <cstdint>
 #include <cmath>
+#include <utility>
 #include <vector>
 
 #include <glm/glm.hpp>
@@ -10,6 +12,7 @@
 
 #include <gl/gl_core_3_3.h>
 #include <gl/TextureData.hpp>
+#include <rw/debug.hpp>
 
 #include "engine/GameData.hpp"
 #include "engine/GameState.hpp"
@@ -39,16 +42,71 @@ constexpr char const* MapFragmentShader = R"(
 in vec2 TexCoord;
 uniform vec4 colour;
 uniform sampler2D spriteTexture;
+uniform float texScale;
 out vec4 outColour;
 
 void main() {
-    vec4 c = texture(spriteTexture, TexCoord*0.99);
+    vec4 c = texture(spriteTexture, TexCoord * texScale);
     outColour = vec4(colour.rgb + c.rgb, colour.a * c.a);
 })";
+
+constexpr char const* BlipVertexShader = R"(
+#version 330
+
+layout(location = 0) in vec2 position;
+layout(location = 4) in vec4 placement;
+layout(location = 5) in vec4 colour;
+layout(location = 6) in vec4 spriteRect;
+out vec2 TexCoord;
+out vec4 Colour;
+
+uniform mat4 proj;
+
+void main() {
+    float s = sin(placement.w);
+    float c = cos(placement.w);
+    vec2 p = mat2(c, s, -s, c) * position * placement.z;
+    gl_Position = proj * vec4(placement.xy + p, 0.0, 1.0);
+    TexCoord = spriteRect.xy + (position + vec2(0.5)) * spriteRect.zw;
+    Colour = colour;
+})";
+
+constexpr char const* BlipFragmentShader = R"(
+#version 330
+
+in vec2 TexCoord;
+in vec4 Colour;
+uniform sampler2D spriteTexture;
+out vec4 outColour;
+
+void main() {
+    vec4 c = texture(spriteTexture, TexCoord);
+    outColour = vec4(Colour.rgb + c.rgb, Colour.a * c.a);
+})";
+
+constexpr int kMapBlockLine = 8;
+constexpr int kSpriteCellSize = 64;
+constexpr int kSpriteAtlasCells = 8;
+constexpr int kSpriteAtlasSize = kSpriteCellSize * kSpriteAtlasCells;
+
+glm::vec4 spriteCellRect(int cell, const glm::ivec2& size) {
+    // Inset by half a texel so neighbouring cells don't bleed in
+    glm::vec2 origin(static_cast<float>((cell % kSpriteAtlasCells) *
+                                        kSpriteCellSize),
+                     static_cast<float>((cell / kSpriteAtlasCells) *
+                                        kSpriteCellSize));
+    const auto atlasSize = static_cast<float>(kSpriteAtlasSize);
+    return glm::vec4((origin + glm::vec2(0.5f)) / atlasSize,
+                     (glm::vec2(size) - glm::vec2(1.f)) / atlasSize);
+}
 }  // namespace
 
 MapRenderer::MapRenderer(Renderer &renderer, GameData* _data)
-    : data(_data), renderer(renderer) {
+    : data(_data),
+      renderer(renderer),
+      untexturedSpriteRect(spriteCellRect(0, glm::ivec2(kSpriteCellSize))),
+      centreSpriteRect(untexturedSpriteRect),
+      northSpriteRect(untexturedSpriteRect) {
     rectGeom.uploadVertices<VertexP2>(
         {{-.5f, -.5f}, {.5f, -.5f}, {.5f, .5f}, {-.5f, .5f}});
     rect.addGeometry(&rectGeom);
@@ -66,114 +124,208 @@ MapRenderer::MapRenderer(Renderer &renderer, GameData* _data)
     circle.setFaceType(GL_TRIANGLE_FAN);
 
     rectProg = renderer.createShader(MapVertexShader, MapFragmentShader);
-
-    renderer.setUniform(rectProg.get(), "colour", glm::vec4(1.f));
+    rectProj = renderer.getUniform(rectProg.get(), "proj");
+    rectView = renderer.getUniform(rectProg.get(), "view");
+    rectModel = renderer.getUniform(rectProg.get(), "model");
+    rectColour = renderer.getUniform(rectProg.get(), "colour");
+    rectTexScale = renderer.getUniform(rectProg.get(), "texScale");
+
+    renderer.setUniform(rectColour, glm::vec4(1.f));
+    renderer.setUniform(rectTexScale, 1.f);
+
+    blipProg = renderer.createShader(BlipVertexShader, BlipFragmentShader);
+    blipProj = renderer.getUniform(blipProg.get(), "proj");
+    blipTexture = renderer.getUniform(blipProg.get(), "spriteTexture");
+
+    // The blip quad comes from rectGeom, the rest is per instance
+    glGenVertexArrays(1, &blipVAO);
+    glGenBuffers(1, &blipInstanceVBO);
+    glBindVertexArray(blipVAO);
+    glBindBuffer(GL_ARRAY_BUFFER, rectGeom.getVBOName());
+    glEnableVertexAttribArray(ATRS_Position);
+    glVertexAttribPointer(ATRS_Position, 2, GL_FLOAT, GL_FALSE,
+                          sizeof(VertexP2), nullptr);
+    glBindBuffer(GL_ARRAY_BUFFER, blipInstanceVBO);
+    for (GLuint a = 0; a < 3; ++a) {
+        glEnableVertexAttribArray(4 + a);
+        glVertexAttribPointer(
+            4 + a, 4, GL_FLOAT, GL_FALSE, sizeof(BlipInstance),
+            reinterpret_cast<void*>(sizeof(glm::vec4) * a));
+        glVertexAttribDivisor(4 + a, 1);
+    }
+    glBindVertexArray(0);
 }
 
-#define GAME_MAP_SIZE 4000
-
-void MapRenderer::draw(GameWorld* world, const MapInfo& mi) {
-    renderer.pushDebugGroup("Map");
-    renderer.useProgram(rectProg.get());
-
-    Renderer::DrawParameters dp { };
-    dp.start = 0;
-    dp.blendMode = BlendMode::BLEND_ALPHA;
-    dp.depthWrite = false;
-
-    // World out the number of units per tile
-    glm::vec2 worldSize(GAME_MAP_SIZE);
-    const int mapBlockLine = 8;
-    glm::vec2 tileSize = worldSize / static_cast<float>(mapBlockLine);
-    // Determine the scale to show the right number of world units on the screen
-    float worldScale = mi.screenSize / mi.worldSize;
-
-    auto proj = renderer.get2DProjection();
-    glm::mat4 view{1.0f}, model{1.0f};
-    renderer.setUniform(rectProg.get(), "proj", proj);
-    renderer.setUniform(rectProg.get(), "model", glm::mat4(1.0f));
-    renderer.setUniform(rectProg.get(), "colour", glm::vec4(0.f, 0.f, 0.f, 1.f));
+MapRenderer::~MapRenderer() {
+    glDeleteVertexArrays(1, &blipVAO);
+    glDeleteBuffers(1, &blipInstanceVBO);
+    glDeleteTextures(1, &radarAtlas);
+    glDeleteTextures(1, &spriteAtlas);
+}
 
-    view = glm::translate(view, glm::vec3(mi.screenPosition, 0.f));
+void MapRenderer::loadRadarAtlas() {
+    if (radarAtlas != 0) {
+        return;
+    }
 
-    if (mi.clipToSize) {
-        glm::mat4 circleView = glm::scale(view, glm::vec3(mi.screenSize));
-        renderer.setUniform(rectProg.get(), "view", circleView);
-        dp.count = 182;
-        glEnable(GL_STENCIL_TEST);
-        glStencilFunc(GL_ALWAYS, 1, 0xFF);
-        glStencilOp(GL_KEEP, GL_KEEP, GL_REPLACE);
-        glStencilMask(0xFF);
-        glColorMask(0x00, 0x00, 0x00, 0x00);
-        renderer.drawArrays(glm::mat4(1.0f), &circle, dp);
-        glColorMask(0xFF, 0xFF, 0xFF, 0xFF);
-        glStencilFunc(GL_EQUAL, 1, 0xFF);
+    // The tiles are assumed to be the same size as the first
+    glm::ivec2 tileSize{};
+    for (int m = 0; m < MAP_BLOCK_SIZE && tileSize.x == 0; ++m) {
+        std::string num = (m < 10 ? "0" : "");
+        std::string name = "radar" + num + std::to_string(m);
+        if (auto texturePtr = data->findSlotTexture(name, name)) {
+            tileSize = texturePtr->getSize();
+        }
+    }
+    if (tileSize.x == 0) {
+        return;
     }
 
-    view = glm::scale(view, glm::vec3(worldScale));
-    view = glm::rotate(view, mi.rotation, glm::vec3(0.f, 0.f, 1.f));
-    view = glm::translate(
-        view, glm::vec3(glm::vec2(-1.f, 1.f) * mi.worldCenter, 0.f));
-    renderer.setUniform(rectProg.get(), "view", view);
+    const glm::ivec2 atlasSize = tileSize * kMapBlockLine;
+    // Leave anything without a tile transparent
+    std::vector<std::uint8_t> pixels(
+        static_cast<size_t>(atlasSize.x) * static_cast<size_t>(atlasSize.y) *
+        4);
+    glGenTextures(1, &radarAtlas);
+    glBindTexture(GL_TEXTURE_2D, radarAtlas);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, atlasSize.x, atlasSize.y, 0,
+                 GL_RGBA, GL_UNSIGNED_BYTE, pixels.data());
 
     // radar00 = -x, +y
     // incrementing in X, then Y
-
-    int initX = -(mapBlockLine / 2);
-    int initY = -(mapBlockLine / 2);
-
+    // which is the order the rows of the atlas are in
     for (int m = 0; m < MAP_BLOCK_SIZE; ++m) {
         std::string num = (m < 10 ? "0" : "");
         std::string name = "radar" + num + std::to_string(m);
-        auto texturePtr = world->data->findSlotTexture(name, name);
-        dp.textures = {{texturePtr->getName()}};
+        auto texturePtr = data->findSlotTexture(name, name);
+        if (texturePtr == nullptr) {
+            continue;
+        }
+        if (texturePtr->getSize() != tileSize) {
+            RW_ERROR("Radar tile " << name << " is not "
+                     << tileSize.x << "x" << tileSize.y);
+            continue;
+        }
 
-        dp.count = 4;
+        glBindTexture(GL_TEXTURE_2D, texturePtr->getName());
+        glGetTexImage(GL_TEXTURE_2D, 0, GL_RGBA, GL_UNSIGNED_BYTE,
+                      pixels.data());
 
-        int mX = initX + (m % mapBlockLine);
-        int mY = initY + (m / mapBlockLine);
+        glBindTexture(GL_TEXTURE_2D, radarAtlas);
+        glTexSubImage2D(GL_TEXTURE_2D, 0, (m % kMapBlockLine) * tileSize.x,
+                        (m / kMapBlockLine) * tileSize.y, tileSize.x,
+                        tileSize.y, GL_RGBA, GL_UNSIGNED_BYTE, pixels.data());
+    }
 
-        auto tc = glm::vec2(mX, mY) * tileSize + glm::vec2(tileSize / 2.f);
+    glBindTexture(GL_TEXTURE_2D, radarAtlas);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER,
+                    GL_LINEAR_MIPMAP_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+    glGenerateMipmap(GL_TEXTURE_2D);
 
-        glm::mat4 tilemodel = model;
-        tilemodel = glm::translate(tilemodel, glm::vec3(tc, 0.f));
-        tilemodel = glm::scale(tilemodel, glm::vec3(tileSize, 1.f));
+    renderer.invalidate();
+}
 
-        renderer.setUniform(rectProg.get(), "model", tilemodel);
+void MapRenderer::loadSprites() {
+    if (spriteAtlas != 0) {
+        return;
+    }
 
-        renderer.drawArrays(glm::mat4(1.0f), &rect, dp);
+    // The first cell is opaque black, for the untextured blips
+    std::vector<std::uint8_t> pixels(kSpriteAtlasSize * kSpriteAtlasSize * 4,
+                                     0);
+    for (int y = 0; y < kSpriteCellSize; ++y) {
+        for (int x = 0; x < kSpriteCellSize; ++x) {
+            pixels[(y * kSpriteAtlasSize + x) * 4 + 3] = 0xFF;
+        }
     }
+    glGenTextures(1, &spriteAtlas);
+    glBindTexture(GL_TEXTURE_2D, spriteAtlas);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, kSpriteAtlasSize,
+                 kSpriteAtlasSize, 0, GL_RGBA, GL_UNSIGNED_BYTE,
+                 pixels.data());
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+
+    // Sorted, so each sprite gets the same cell every time
+    std::vector<std::pair<std::string, TextureData*>> sprites;
+    auto hud = data->textureSlots.find("hud");
+    if (hud != data->textureSlots.end()) {
+        for (const auto& [name, texture] : hud->second) {
+            if (name.compare(0, 6, "radar_") == 0) {
+                sprites.emplace_back(name, texture.get());
+            }
+        }
+    }
+    std::sort(sprites.begin(), sprites.end());
+
+    int cell = 1;
+    for (const auto& [name, texture] : sprites) {
+        const auto& size = texture->getSize();
+        if (size.x > kSpriteCellSize || size.y > kSpriteCellSize ||
+            cell >= kSpriteAtlasCells * kSpriteAtlasCells) {
+            RW_ERROR("No space for blip sprite " << name);
+            continue;
+        }
 
-    // From here on out we will work in screenspace
-    renderer.setUniform(rectProg.get(), "view", glm::mat4(1.0f));
+        pixels.resize(static_cast<size_t>(size.x) *
+                      static_cast<size_t>(size.y) * 4);
+        glBindTexture(GL_TEXTURE_2D, texture->getName());
+        glGetTexImage(GL_TEXTURE_2D, 0, GL_RGBA, GL_UNSIGNED_BYTE,
+                      pixels.data());
+
+        glBindTexture(GL_TEXTURE_2D, spriteAtlas);
+        glTexSubImage2D(GL_TEXTURE_2D, 0,
+                        (cell % kSpriteAtlasCells) * kSpriteCellSize,
+                        (cell / kSpriteAtlasCells) * kSpriteCellSize, size.x,
+                        size.y, GL_RGBA, GL_UNSIGNED_BYTE, pixels.data());
+        spriteRects[name] = spriteCellRect(cell, size);
+        cell++;
+    }
 
-    if (mi.clipToSize) {
-        glDisable(GL_STENCIL_TEST);
-        // We only need the outer ring if we're clipping.
-        glBlendFuncSeparate(GL_DST_COLOR, GL_ZERO, GL_ONE, GL_ZERO);
-        auto radarDiscTexPtr = data->findSlotTexture("hud", "radardisc");
-        dp.textures = {{radarDiscTexPtr->getName()}};
+    centreSpriteRect = getSpriteRect("radar_centre");
+    northSpriteRect = getSpriteRect("radar_north");
 
-        glm::mat4 model{1.0f};
-        model = glm::translate(model, glm::vec3(mi.screenPosition, 0.0f));
-        model = glm::scale(model, glm::vec3(mi.screenSize * 1.07f));
-        renderer.setUniform(rectProg.get(), "model", model);
-        renderer.drawArrays(glm::mat4(1.0f), &rect, dp);
-        glBlendFuncSeparate(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA, GL_ONE,
-                            GL_ZERO);
-    }
+    renderer.invalidate();
+}
+
+const glm::vec4& MapRenderer::getSpriteRect(const std::string& texture) const {
+    auto it = spriteRects.find(texture);
+    return it != spriteRects.end() ? it->second : untexturedSpriteRect;
+}
+
+#define GAME_MAP_SIZE 4000
+
+void MapRenderer::draw(GameWorld* world, const MapInfo& mi) {
+    glm::vec2 worldSize(GAME_MAP_SIZE);
+    // Determine the scale to show the right number of world units on the screen
+    float worldScale = mi.screenSize / mi.worldSize;
+
+    glm::mat4 view{1.0f}, model{1.0f};
+    view = glm::translate(view, glm::vec3(mi.screenPosition, 0.f));
+
+    glm::mat4 worldView = glm::scale(view, glm::vec3(worldScale));
+    worldView = glm::rotate(worldView, mi.rotation, glm::vec3(0.f, 0.f, 1.f));
+    worldView = glm::translate(
+        worldView, glm::vec3(glm::vec2(-1.f, 1.f) * mi.worldCenter, 0.f));
+
+    loadRadarAtlas();
+    loadSprites();
 
-    // Draw the player blip
     auto player = world->pedestrianPool.find(world->state->playerObject);
     if (player) {
         glm::vec2 plyblip(player->getPosition());
         float hdg = glm::roll(player->getRotation());
-        drawBlip(plyblip, view, mi, "radar_centre",
-                 glm::vec4(0.0f, 0.0f, 0.0f, 1.0f), defaultBlipSize, mi.rotation - hdg);
+        addBlip(plyblip, worldView, mi, centreSpriteRect,
+                glm::vec4(0.0f, 0.0f, 0.0f, 1.0f), defaultBlipSize,
+                mi.rotation - hdg);
     }
 
-    drawBlip(mi.worldCenter + glm::vec2(0.f, mi.worldSize), view, mi,
-             "radar_north", glm::vec4(0.0f, 0.0f, 0.0f, 1.0f), radarNorthBlipSize);
+    addBlip(mi.worldCenter + glm::vec2(0.f, mi.worldSize), worldView, mi,
+            northSpriteRect, glm::vec4(0.0f, 0.0f, 0.0f, 1.0f),
+            radarNorthBlipSize);
 
     for (auto& radarBlip : world->state->radarBlips) {
         const auto& blip = radarBlip.second;
@@ -193,8 +345,8 @@ void MapRenderer::draw(GameWorld* world, const MapInfo& mi) {
 
         const auto& texture = blip.texture;
         if (!texture.empty()) {
-            drawBlip(blippos, view, mi, texture,
-                     glm::vec4(0.0f, 0.0f, 0.0f, 1.0f), defaultBlipSize);
+            addBlip(blippos, worldView, mi, getSpriteRect(texture),
+                    glm::vec4(0.0f, 0.0f, 0.0f, 1.0f), defaultBlipSize);
         } else {
             // Colours from http://www.gtamodding.com/wiki/0165 (colors not
             // specific to that opcode!)
@@ -232,18 +384,80 @@ void MapRenderer::draw(GameWorld* world, const MapInfo& mi) {
                              1.0f  // Note: Alpha is not controlled by blip
                              );
 
-            drawBlip(blippos, view, mi, colour, blip.size * hudScale * 2.0f);
+            addBlip(blippos, worldView, mi, colour, blip.size * hudScale * 2.0f);
         }
     }
 
+    renderer.pushDebugGroup("Map");
+    renderer.useProgram(rectProg.get());
+
+    Renderer::DrawParameters dp { };
+    dp.start = 0;
+    dp.blendMode = BlendMode::BLEND_ALPHA;
+    dp.depthWrite = false;
+
+    auto proj = renderer.get2DProjection();
+    renderer.setUniform(rectProj, proj);
+    renderer.setUniform(rectModel, glm::mat4(1.0f));
+    renderer.setUniform(rectColour, glm::vec4(0.f, 0.f, 0.f, 1.f));
+
+    if (mi.clipToSize) {
+        glm::mat4 circleView = glm::scale(view, glm::vec3(mi.screenSize));
+        renderer.setUniform(rectView, circleView);
+        dp.count = 182;
+        glEnable(GL_STENCIL_TEST);
+        glStencilFunc(GL_ALWAYS, 1, 0xFF);
+        glStencilOp(GL_KEEP, GL_KEEP, GL_REPLACE);
+        glStencilMask(0xFF);
+        glColorMask(0x00, 0x00, 0x00, 0x00);
+        renderer.drawArrays(glm::mat4(1.0f), &circle, dp);
+        glColorMask(0xFF, 0xFF, 0xFF, 0xFF);
+        glStencilFunc(GL_EQUAL, 1, 0xFF);
+    }
+
+    renderer.setUniform(rectView, worldView);
+
+    if (radarAtlas != 0) {
+        dp.textures = {{radarAtlas}};
+        dp.count = 4;
+
+        glm::mat4 mapModel = glm::scale(model, glm::vec3(worldSize, 1.f));
+        renderer.setUniform(rectModel, mapModel);
+        renderer.setUniform(rectTexScale, 1.f);
+
+        renderer.drawArrays(glm::mat4(1.0f), &rect, dp);
+    }
+
+    // From here on out we will work in screenspace
+    renderer.setUniform(rectView, glm::mat4(1.0f));
+
+    if (mi.clipToSize) {
+        glDisable(GL_STENCIL_TEST);
+        // We only need the outer ring if we're clipping.
+        glBlendFuncSeparate(GL_DST_COLOR, GL_ZERO, GL_ONE, GL_ZERO);
+        auto radarDiscTexPtr = data->findSlotTexture("hud", "radardisc");
+        dp.textures = {{radarDiscTexPtr->getName()}};
+
+        glm::mat4 model{1.0f};
+        model = glm::translate(model, glm::vec3(mi.screenPosition, 0.0f));
+        model = glm::scale(model, glm::vec3(mi.screenSize * 1.07f));
+        renderer.setUniform(rectModel, model);
+        renderer.setUniform(rectTexScale, 0.99f);
+        renderer.drawArrays(glm::mat4(1.0f), &rect, dp);
+        glBlendFuncSeparate(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA, GL_ONE,
+                            GL_ZERO);
+    }
+
+    drawBlips();
+
     /// @TODO migrate to using the renderer
     renderer.invalidate();
     renderer.popDebugGroup();
 }
 
-void MapRenderer::prepareBlip(const glm::vec2& coord, const glm::mat4& view,
-                              const MapInfo& mi, const std::string& texture,
-                              glm::vec4 colour, float size, float heading) {
+void MapRenderer::addBlip(const glm::vec2& coord, const glm::mat4& view,
+                          const MapInfo& mi, const glm::vec4& spriteRect,
+                          glm::vec4 colour, float size, float heading) {
     glm::vec2 adjustedCoord = coord;
     if (mi.clipToSize) {
         float maxDist = mi.worldSize / 2.f;
@@ -254,40 +468,41 @@ void MapRenderer::prepareBlip(const glm::vec2& coord, const glm::mat4& view,
         }
     }
 
-    glm::vec3 viewPos(
+    glm::vec2 viewPos(
         view * glm::vec4(glm::vec2(1.f, -1.f) * adjustedCoord, 0.f, 1.f));
-    glm::mat4 model{1.0f};
-    model = glm::translate(model, viewPos);
-    model = glm::scale(model, glm::vec3(size));
-    model = glm::rotate(model, heading, glm::vec3(0.f, 0.f, 1.f));
-    renderer.setUniform(rectProg.get(), "model", model);
-
-    GLuint tex = 0;
-    if (!texture.empty()) {
-        auto spriteTexPtr = data->findSlotTexture("hud", texture);
-        tex = spriteTexPtr->getName();
+    blips.push_back({glm::vec4(viewPos, size, heading), colour, spriteRect});
+}
+
+void MapRenderer::addBlip(const glm::vec2& coord, const glm::mat4& view,
+                          const MapInfo& mi, glm::vec4 colour, float size) {
+    // A slightly larger black quad underneath stands in for the outline
+    addBlip(coord, view, mi, untexturedSpriteRect,
+            glm::vec4(0.0f, 0.0f, 0.0f, 1.0f), size + 2.f);
+    addBlip(coord, view, mi, untexturedSpriteRect, colour, size);
+}
+
+void MapRenderer::drawBlips() {
+    if (blips.empty()) {
+        return;
     }
-    renderer.setUniform(rectProg.get(), "colour", colour);
 
-    glBindTexture(GL_TEXTURE_2D, tex);
+    renderer.useProgram(blipProg.get());
+    renderer.setUniform(blipProj, renderer.get2DProjection());
+    renderer.setUniformTexture(blipTexture, 0);
 
-    glDrawArrays(GL_TRIANGLE_FAN, 0, 4);
-}
+    glActiveTexture(GL_TEXTURE0);
+    glBindTexture(GL_TEXTURE_2D, spriteAtlas);
 
-void MapRenderer::drawBlip(const glm::vec2& coord, const glm::mat4& view,
-                           const MapInfo& mi, const std::string& texture,
-                           glm::vec4 colour, float size, float heading) {
-    prepareBlip(coord, view, mi, texture, colour, size, heading);
-    glBindVertexArray(rect.getVAOName());
-    glDrawArrays(GL_TRIANGLE_FAN, 0, 4);
-}
+    glBindBuffer(GL_ARRAY_BUFFER, blipInstanceVBO);
+    glBufferData(GL_ARRAY_BUFFER,
+                 static_cast<GLsizeiptr>(blips.size() * sizeof(BlipInstance)),
+                 blips.data(), GL_STREAM_DRAW);
+
+    glBindVertexArray(blipVAO);
+    glDrawArraysInstanced(GL_TRIANGLE_FAN, 0, 4,
+                          static_cast<GLsizei>(blips.size()));
 
-void MapRenderer::drawBlip(const glm::vec2& coord, const glm::mat4& view,
-                           const MapInfo& mi, glm::vec4 colour, float size) {
-    drawBlip(coord, view, mi, "", colour, size);
-    // Draw outline
-    renderer.setUniform(rectProg.get(), "colour", glm::vec4(0.0f, 0.0f, 0.0f, 1.0f));
-    glDrawArrays(GL_LINE_LOOP, 0, 4);
+    blips.clear();
 }
 
 void MapRenderer::scaleHUD(const float scale) {
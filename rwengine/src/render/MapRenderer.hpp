@@ -3,6 +3,8 @@
 
 #include <memory>
 #include <string>
+#include <unordered_map>
+#include <vector>
 
 #include <gl/DrawBuffer.hpp>
 #include <gl/GeometryBuffer.hpp>
@@ -35,6 +37,25 @@ public:
     };
 
     MapRenderer(Renderer& renderer, GameData* data);
+    ~MapRenderer();
+
+    /**
+     * Copies the radarNN tiles into one atlas, so the map is a single draw.
+     * Done on the first draw if it hasn't been called after loading them.
+     */
+    void loadRadarAtlas();
+
+    /**
+     * Copies the radar_ hud textures into the blip sprite atlas. Done on the
+     * first draw if it hasn't been called after loading them.
+     */
+    void loadSprites();
+
+    /**
+     * @return The sprite atlas rectangle for a hud texture, textures that
+     * aren't blip sprites give the untextured cell
+     */
+    const glm::vec4& getSpriteRect(const std::string& texture) const;
 
     void draw(GameWorld* world, const MapInfo& mi);
     void scaleHUD(const float scale);
@@ -54,15 +75,47 @@ private:
     float hudScale = 1.f;
 
     std::unique_ptr<Renderer::ShaderProgram> rectProg;
-
-    void prepareBlip(const glm::vec2& coord, const glm::mat4& view,
-                     const MapInfo& mi, const std::string& texture,
-                     glm::vec4 colour, float size, float heading);
-    void drawBlip(const glm::vec2& coord, const glm::mat4& view,
-                  const MapInfo& mi, const std::string& texture,
-                  glm::vec4 colour, float size, float heading = 0.0f);
-    void drawBlip(const glm::vec2& coord, const glm::mat4& view,
-                  const MapInfo& mi, glm::vec4 colour, float size);
+    Renderer::Uniform rectProj;
+    Renderer::Uniform rectView;
+    Renderer::Uniform rectModel;
+    Renderer::Uniform rectColour;
+    Renderer::Uniform rectTexScale;
+
+    /// All of the radar tiles, laid out as they are in the world
+    GLuint radarAtlas = 0;
+
+    /**
+     * Blip sprites are copied into fixed size cells of an atlas when the map
+     * is loaded, so all blips can share one texture.
+     */
+    GLuint spriteAtlas = 0;
+    /// Sprite name -> offset and scale of its texture coordinates
+    std::unordered_map<std::string, glm::vec4> spriteRects;
+    glm::vec4 untexturedSpriteRect;
+    /// Looked up once for the blips drawn on every map
+    glm::vec4 centreSpriteRect;
+    glm::vec4 northSpriteRect;
+
+    struct BlipInstance {
+        /// Screen position, size and heading
+        glm::vec4 placement;
+        glm::vec4 colour;
+        glm::vec4 spriteRect;
+    };
+    std::vector<BlipInstance> blips;
+    GLuint blipVAO = 0;
+    GLuint blipInstanceVBO = 0;
+
+    std::unique_ptr<Renderer::ShaderProgram> blipProg;
+    Renderer::Uniform blipProj;
+    Renderer::Uniform blipTexture;
+
+    void addBlip(const glm::vec2& coord, const glm::mat4& view,
+                 const MapInfo& mi, const glm::vec4& spriteRect,
+                 glm::vec4 colour, float size, float heading = 0.0f);
+    void addBlip(const glm::vec2& coord, const glm::mat4& view,
+                 const MapInfo& mi, glm::vec4 colour, float size);
+    void drawBlips();
 };
 
 #endif
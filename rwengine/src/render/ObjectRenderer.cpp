@@ -1,17 +1,22 @@
 #include "render/ObjectRenderer.hpp"
 
+#include <algorithm>
 #include <cstdint>
+#include <functional>
 
 #include <BulletDynamics/Vehicle/btRaycastVehicle.h>
 #include <glm/gtc/type_ptr.hpp>
 
 #include <data/Clump.hpp>
 
+#include "core/Profiler.hpp"
+#include "data/CollisionModel.hpp"
 #include "data/CutsceneData.hpp"
 #include "data/WeaponData.hpp"
 #include "engine/GameData.hpp"
 #include "engine/GameState.hpp"
 #include "engine/GameWorld.hpp"
+#include "render/OcclusionBuffer.hpp"
 #include "render/ViewCamera.hpp"
 
 // Objects that we know how to turn into renderlist entries
@@ -34,6 +39,10 @@ constexpr float kPedestrianDrawDistanceFactor = kDrawDistanceFactor;
 constexpr float kMagicLODDistance = 330.f;
 constexpr float kVehicleLODDistance = 70.f;
 constexpr float kVehicleDrawDistance = 280.f;
+/// Buildings smaller than this don't hide enough to be worth drawing
+constexpr float kMinOccluderRadius = 10.f;
+constexpr float kMaxOccluderDistance = 250.f;
+constexpr size_t kMaxOccluders = 64;
 
 RenderKey createKey(float normalizedDepth, Renderer::Textures& textures) {
     return (uint32_t(0x7FFFFF * normalizedDepth) << 8 |
@@ -106,7 +115,7 @@ void ObjectRenderer::renderGeometry(Geometry* geom,
         float depth = (distance - m_camera.frustum.near) /
                       (m_camera.frustum.far - m_camera.frustum.near);
         outList.emplace_back(createKey(depth * depth, dp.textures), modelMatrix,
-                             &geom->dbuff, dp);
+                             geom->getDrawBuffer(), dp);
     }
 }
 
@@ -129,6 +138,14 @@ void ObjectRenderer::renderAtomic(Atomic* atomic,
         return;
     }
 
+    // Occluders would be hidden by their own collision
+    if (m_occlusion && !m_occlusion->isVisible(boundpos, bounds.radius) &&
+        !std::binary_search(m_occluders.begin(), m_occluders.end(), object,
+                            std::less<>())) {
+        occluded++;
+        return;
+    }
+
     renderGeometry(geometry.get(), transform, object, render);
 }
 
@@ -158,16 +175,8 @@ void ObjectRenderer::renderInstance(InstanceObject* instance,
 
     auto modelinfo = instance->getModelInfo<SimpleModelInfo>();
 
-    // Handles times provided by TOBJ data
-    const auto currentHour = m_world->getHour();
-    if (modelinfo->timeOff < modelinfo->timeOn) {
-        if (currentHour >= modelinfo->timeOff &&
-            currentHour < modelinfo->timeOn)
-            return;
-    } else {
-        if (currentHour >= modelinfo->timeOff ||
-            currentHour < modelinfo->timeOn)
-            return;
+    if (!isVisibleAtHour(modelinfo)) {
+        return;
     }
 
     float mindist = glm::length(instance->getPosition() - m_camera.position) /
@@ -202,6 +211,17 @@ void ObjectRenderer::renderInstance(InstanceObject* instance,
     renderAtomic(atomic.get(), glm::mat4(1.0f), instance, outList);
 }
 
+bool ObjectRenderer::isVisibleAtHour(const SimpleModelInfo* modelinfo) const {
+    // Handles times provided by TOBJ data
+    const auto currentHour = m_world->getHour();
+    if (modelinfo->timeOff < modelinfo->timeOn) {
+        return currentHour < modelinfo->timeOff ||
+               currentHour >= modelinfo->timeOn;
+    }
+    return currentHour < modelinfo->timeOff &&
+           currentHour >= modelinfo->timeOn;
+}
+
 void ObjectRenderer::renderCharacter(CharacterObject* pedestrian,
                                      RenderList& outList) {
     const auto& clump = pedestrian->getClump();
@@ -362,3 +382,76 @@ void ObjectRenderer::buildRenderList(GameObject* object, RenderList& outList) {
             break;
     }
 }
+
+void ObjectRenderer::buildOcclusion(OcclusionBuffer& buffer) {
+    RW_PROFILE_SCOPE(__func__);
+    buffer.clear(m_camera.frustum.projection() * m_camera.getView());
+
+    struct Candidate {
+        /// Roughly the size on screen
+        float size;
+        InstanceObject* instance;
+    };
+    FrameVector<Candidate> candidates;
+
+    // Only buildings that renderInstance will draw this frame can hide others
+    for (const auto& [id, object] : m_world->instancePool.objects) {
+        auto instance = static_cast<InstanceObject*>(object.get());
+        if (!instance->getAtomic() || !instance->isVisible() ||
+            instance->dynamics) {
+            continue;
+        }
+
+        auto modelinfo = instance->getModelInfo<SimpleModelInfo>();
+        const auto collision = modelinfo->getCollision();
+        if (!collision || collision->boundingSphere.radius < kMinOccluderRadius ||
+            modelinfo->isBigBuilding() ||
+            (modelinfo->flags & (SimpleModelInfo::DRAW_LAST |
+                                 SimpleModelInfo::NO_ZBUFFER_WRITE)) ||
+            !isVisibleAtHour(modelinfo)) {
+            continue;
+        }
+
+        const float distance =
+            glm::length(instance->getPosition() - m_camera.position);
+        const float mindist = distance / kDrawDistanceFactor;
+        if (distance > kMaxOccluderDistance ||
+            mindist > modelinfo->getLargestLodDistance() ||
+            !modelinfo->getDistanceAtomic(mindist / kDrawDistanceFactor)) {
+            continue;
+        }
+
+        const auto radius = collision->boundingSphere.radius;
+        const auto center =
+            instance->getPosition() +
+            instance->getRotation() * collision->boundingSphere.center;
+        if (!m_camera.frustum.intersects(center, radius)) {
+            continue;
+        }
+
+        candidates.push_back({radius / std::max(distance, 1.f), instance});
+    }
+
+    if (candidates.size() > kMaxOccluders) {
+        std::nth_element(candidates.begin(),
+                         candidates.begin() +
+                             static_cast<std::ptrdiff_t>(kMaxOccluders),
+                         candidates.end(),
+                         [](const Candidate& a, const Candidate& b) {
+                             return a.size > b.size;
+                         });
+        candidates.resize(kMaxOccluders);
+    }
+
+    m_occluders.clear();
+    for (const auto& candidate : candidates) {
+        auto instance = candidate.instance;
+        buffer.drawCollision(
+            instance->getAtomic()->getFrame()->getWorldTransform(),
+            *instance->getModelInfo<SimpleModelInfo>()->getCollision());
+        m_occluders.push_back(instance);
+    }
+    std::sort(m_occluders.begin(), m_occluders.end(), std::less<>());
+
+    m_occlusion = &buffer;
+}
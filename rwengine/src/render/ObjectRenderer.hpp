@@ -3,6 +3,7 @@
 
 #include <cstddef>
 
+#include "core/FrameArena.hpp"
 #include "render/OpenGLRenderer.hpp"
 
 class Atomic;
@@ -12,8 +13,10 @@ class CutsceneObject;
 class GameObject;
 class GameWorld;
 class InstanceObject;
+class OcclusionBuffer;
 class PickupObject;
 class ProjectileObject;
+class SimpleModelInfo;
 class VehicleObject;
 class ViewCamera;
 struct Geometry;
@@ -39,8 +42,16 @@ public:
      * Exports rendering instructions for an object
      */
     size_t culled = 0;
+    /// Objects inside the frustum that were hidden by occluders
+    size_t occluded = 0;
     void buildRenderList(GameObject* object, RenderList& outList);
 
+    /**
+     * Draws the collision of the largest buildings in view into the buffer,
+     * objects that it hides are skipped from then on
+     */
+    void buildOcclusion(OcclusionBuffer& buffer);
+
     void renderGeometry(Geometry* geom, const glm::mat4& modelMatrix,
                         GameObject* object, RenderList& outList);
 
@@ -65,6 +76,12 @@ private:
     const ViewCamera& m_camera;
     float m_renderAlpha;
 
+    OcclusionBuffer* m_occlusion = nullptr;
+    /// Sorted, so they can be found quickly
+    FrameVector<const GameObject*> m_occluders;
+
+    bool isVisibleAtHour(const SimpleModelInfo* modelinfo) const;
+
     void renderInstance(InstanceObject* instance, RenderList& outList);
     void renderCharacter(CharacterObject* pedestrian, RenderList& outList);
     void renderVehicle(VehicleObject* vehicle, RenderList& outList);
@@ -0,0 +1,251 @@
+#include "render/OcclusionBuffer.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <limits>
+
+#include <rw/debug.hpp>
+
+#include "data/CollisionModel.hpp"
+
+namespace {
+constexpr std::array<std::array<int, 3>, 12> kBoxTriangles{{{{0, 1, 3}},
+                                                            {{0, 3, 2}},
+                                                            {{4, 6, 7}},
+                                                            {{4, 7, 5}},
+                                                            {{0, 4, 5}},
+                                                            {{0, 5, 1}},
+                                                            {{2, 3, 7}},
+                                                            {{2, 7, 6}},
+                                                            {{0, 2, 6}},
+                                                            {{0, 6, 4}},
+                                                            {{1, 5, 7}},
+                                                            {{1, 7, 3}}}};
+
+std::array<glm::vec3, 8> boxCorners(const glm::vec3& min,
+                                    const glm::vec3& max) {
+    std::array<glm::vec3, 8> corners;
+    for (size_t i = 0; i < corners.size(); ++i) {
+        corners[i] = {(i & 4) ? max.x : min.x, (i & 2) ? max.y : min.y,
+                      (i & 1) ? max.z : min.z};
+    }
+    return corners;
+}
+
+float edge(const glm::vec3& a, const glm::vec3& b, float x, float y) {
+    return (b.x - a.x) * (y - a.y) - (b.y - a.y) * (x - a.x);
+}
+
+/// Distance in front of the near plane, in clip space
+float nearDistance(const glm::vec4& v) {
+    return v.z + v.w;
+}
+}  // namespace
+
+OcclusionBuffer::OcclusionBuffer(int width, int height)
+    : width(width)
+    , height(height)
+    , depth(static_cast<size_t>(width * height), 1.f) {
+    RW_ASSERT(width > 0 && height > 0);
+}
+
+void OcclusionBuffer::clear(const glm::mat4& vp) {
+    viewProjection = vp;
+    std::fill(depth.begin(), depth.end(), 1.f);
+    triangles = 0;
+}
+
+void OcclusionBuffer::drawTriangle(const glm::mat4& model, const glm::vec3& a,
+                                   const glm::vec3& b, const glm::vec3& c) {
+    const auto mvp = viewProjection * model;
+    drawClipped(mvp * glm::vec4(a, 1.f), mvp * glm::vec4(b, 1.f),
+                mvp * glm::vec4(c, 1.f));
+}
+
+void OcclusionBuffer::drawBox(const glm::mat4& model, const glm::vec3& min,
+                              const glm::vec3& max) {
+    const auto mvp = viewProjection * model;
+    const auto corners = boxCorners(min, max);
+    std::array<glm::vec4, 8> clip;
+    for (size_t i = 0; i < corners.size(); ++i) {
+        clip[i] = mvp * glm::vec4(corners[i], 1.f);
+    }
+    for (const auto& t : kBoxTriangles) {
+        drawClipped(clip[t[0]], clip[t[1]], clip[t[2]]);
+    }
+}
+
+void OcclusionBuffer::drawCollision(const glm::mat4& model,
+                                    const CollisionModel& collision) {
+    for (const auto& box : collision.boxes) {
+        drawBox(model, box.min, box.max);
+    }
+
+    if (collision.faces.empty()) {
+        return;
+    }
+
+    // Vertices are shared between faces, so only transform them once
+    const auto mvp = viewProjection * model;
+    auto& clip = clipVertices;
+    clip.clear();
+    for (const auto& v : collision.vertices) {
+        clip.push_back(mvp * glm::vec4(v, 1.f));
+    }
+    for (const auto& face : collision.faces) {
+        if (face.tri[0] >= clip.size() || face.tri[1] >= clip.size() ||
+            face.tri[2] >= clip.size()) {
+            continue;
+        }
+        drawClipped(clip[face.tri[0]], clip[face.tri[1]], clip[face.tri[2]]);
+    }
+}
+
+bool OcclusionBuffer::isVisible(const glm::vec3& center, float radius) const {
+    // Test the box around the sphere, using its nearest depth everywhere
+    const auto corners =
+        boxCorners(center - glm::vec3(radius), center + glm::vec3(radius));
+    glm::vec3 min{std::numeric_limits<float>::max()};
+    glm::vec3 max{std::numeric_limits<float>::lowest()};
+    for (const auto& corner : corners) {
+        const auto clip = viewProjection * glm::vec4(corner, 1.f);
+        if (nearDistance(clip) <= 0.f) {
+            // Crosses the near plane, so it covers the camera
+            return true;
+        }
+        const auto screen = toScreen(clip);
+        min = glm::min(min, screen);
+        max = glm::max(max, screen);
+    }
+
+    if (max.x < 0.f || max.y < 0.f || min.x > static_cast<float>(width) ||
+        min.y > static_cast<float>(height)) {
+        // Outside of the buffer, the frustum decides
+        return true;
+    }
+
+    // A pixel of margin makes up for occluders covering pixel centres only
+    const auto clampX = [&](float v) {
+        return static_cast<int>(
+            std::clamp(v, 0.f, static_cast<float>(width - 1)));
+    };
+    const auto clampY = [&](float v) {
+        return static_cast<int>(
+            std::clamp(v, 0.f, static_cast<float>(height - 1)));
+    };
+    const int minX = clampX(std::floor(min.x) - 1.f);
+    const int maxX = clampX(std::ceil(max.x) + 1.f);
+    const int minY = clampY(std::floor(min.y) - 1.f);
+    const int maxY = clampY(std::ceil(max.y) + 1.f);
+
+    for (int y = minY; y <= maxY; ++y) {
+        const float* row = depth.data() + y * width;
+        float farthest = row[minX];
+        for (int x = minX + 1; x <= maxX; ++x) {
+            farthest = std::max(farthest, row[x]);
+        }
+        if (farthest >= min.z) {
+            return true;
+        }
+    }
+    return false;
+}
+
+void OcclusionBuffer::drawClipped(const glm::vec4& a, const glm::vec4& b,
+                                  const glm::vec4& c) {
+    const std::array<glm::vec4, 3> in{{a, b, c}};
+    const auto inFront = std::count_if(in.begin(), in.end(), [](const auto& v) {
+        return nearDistance(v) > 0.f;
+    });
+    if (inFront == 0) {
+        return;
+    }
+    if (inFront == 3) {
+        rasterise(toScreen(a), toScreen(b), toScreen(c));
+        return;
+    }
+
+    // Cut off the part behind the near plane, which leaves up to 4 vertices
+    std::array<glm::vec4, 4> out;
+    size_t count = 0;
+    for (size_t i = 0; i < in.size(); ++i) {
+        const auto& current = in[i];
+        const auto& next = in[(i + 1) % in.size()];
+        const auto dCurrent = nearDistance(current);
+        const auto dNext = nearDistance(next);
+        if (dCurrent > 0.f) {
+            out[count++] = current;
+        }
+        if ((dCurrent > 0.f) != (dNext > 0.f)) {
+            const auto t = dCurrent / (dCurrent - dNext);
+            out[count++] = current + (next - current) * t;
+        }
+    }
+
+    const auto first = toScreen(out[0]);
+    for (size_t i = 1; i + 1 < count; ++i) {
+        rasterise(first, toScreen(out[i]), toScreen(out[i + 1]));
+    }
+}
+
+void OcclusionBuffer::rasterise(const glm::vec3& a, const glm::vec3& b,
+                                const glm::vec3& c) {
+    auto area = edge(a, b, c.x, c.y);
+    if (area == 0.f || std::isnan(area)) {
+        return;
+    }
+    // Counter-clockwise on screen, occluders are drawn from both sides
+    const glm::vec3& v0 = a;
+    const glm::vec3& v1 = area > 0.f ? b : c;
+    const glm::vec3& v2 = area > 0.f ? c : b;
+    area = std::abs(area);
+
+    const auto minCorner = glm::min(a, glm::min(b, c));
+    const auto maxCorner = glm::max(a, glm::max(b, c));
+    if (maxCorner.x < 0.f || maxCorner.y < 0.f ||
+        minCorner.x > static_cast<float>(width) ||
+        minCorner.y > static_cast<float>(height)) {
+        return;
+    }
+    const int minX = static_cast<int>(std::max(std::floor(minCorner.x), 0.f));
+    const int minY = static_cast<int>(std::max(std::floor(minCorner.y), 0.f));
+    const int maxX = static_cast<int>(
+        std::min(std::ceil(maxCorner.x), static_cast<float>(width - 1)));
+    const int maxY = static_cast<int>(
+        std::min(std::ceil(maxCorner.y), static_cast<float>(height - 1)));
+
+    triangles++;
+
+    // The edge functions and depth are linear in screen space, so each
+    // pixel is computed from the row start and its column
+    const float startX = static_cast<float>(minX) + 0.5f;
+    const glm::vec3 stepX{v1.y - v2.y, v2.y - v0.y, v0.y - v1.y};
+    const glm::vec3 z{v0.z, v1.z, v2.z};
+    const float depthStepX = glm::dot(stepX, z) / area;
+
+    for (int y = minY; y <= maxY; ++y) {
+        const float py = static_cast<float>(y) + 0.5f;
+        const glm::vec3 rowStart{edge(v1, v2, startX, py),
+                                 edge(v2, v0, startX, py),
+                                 edge(v0, v1, startX, py)};
+        const float depthStart = glm::dot(rowStart, z) / area;
+
+        float* row = depth.data() + y * width;
+        for (int x = minX; x <= maxX; ++x) {
+            const auto dx = static_cast<float>(x - minX);
+            const float w0 = rowStart.x + stepX.x * dx;
+            const float w1 = rowStart.y + stepX.y * dx;
+            const float w2 = rowStart.z + stepX.z * dx;
+            const float d = depthStart + depthStepX * dx;
+            const bool inside = (w0 >= 0.f) & (w1 >= 0.f) & (w2 >= 0.f);
+            row[x] = inside ? std::min(row[x], d) : row[x];
+        }
+    }
+}
+
+glm::vec3 OcclusionBuffer::toScreen(const glm::vec4& clip) const {
+    const auto ndc = glm::vec3(clip) / clip.w;
+    return {(ndc.x * 0.5f + 0.5f) * static_cast<float>(width),
+            (ndc.y * 0.5f + 0.5f) * static_cast<float>(height), ndc.z};
+}
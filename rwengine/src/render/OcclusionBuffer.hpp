@@ -0,0 +1,93 @@
+#ifndef _RWENGINE_OCCLUSIONBUFFER_HPP_
+#define _RWENGINE_OCCLUSIONBUFFER_HPP_
+
+#include <cstddef>
+#include <vector>
+
+#include <glm/mat4x4.hpp>
+#include <glm/vec3.hpp>
+#include <glm/vec4.hpp>
+
+struct CollisionModel;
+
+/**
+ * Low resolution depth buffer drawn on the CPU, to skip objects that are
+ * hidden behind large buildings before they reach the render list
+ *
+ * Occluders are drawn with simplified geometry such as collision meshes,
+ * then the bounds of other objects are tested against the depth. A pixel
+ * only counts as covered if its centre is inside a triangle, and bounds are
+ * tested with a pixel of margin, so objects are kept when in doubt.
+ *
+ * Rows are stored contiguously and the inner loops avoid branches, so the
+ * compiler can vectorise them. The results only depend on the input.
+ */
+class OcclusionBuffer {
+public:
+    static constexpr int kDefaultWidth = 256;
+    static constexpr int kDefaultHeight = 128;
+
+    OcclusionBuffer(int width = kDefaultWidth, int height = kDefaultHeight);
+
+    /**
+     * Empties the buffer, ready for occluders seen through viewProjection
+     */
+    void clear(const glm::mat4& viewProjection);
+
+    void drawTriangle(const glm::mat4& model, const glm::vec3& a,
+                      const glm::vec3& b, const glm::vec3& c);
+
+    void drawBox(const glm::mat4& model, const glm::vec3& min,
+                 const glm::vec3& max);
+
+    /**
+     * Draws the boxes and triangles of a collision model, spheres are
+     * ignored
+     */
+    void drawCollision(const glm::mat4& model, const CollisionModel& collision);
+
+    /**
+     * @return false if the sphere is completely behind occluders
+     */
+    bool isVisible(const glm::vec3& center, float radius) const;
+
+    int getWidth() const {
+        return width;
+    }
+
+    int getHeight() const {
+        return height;
+    }
+
+    /**
+     * @return The normalized device depth at the pixel, 1 if nothing was
+     * drawn there
+     */
+    float getDepth(int x, int y) const {
+        return depth[static_cast<size_t>(y * width + x)];
+    }
+
+    /// Triangles drawn since the last clear, after clipping
+    size_t getTriangleCount() const {
+        return triangles;
+    }
+
+private:
+    /// Clips against the near plane, then draws in screen space
+    void drawClipped(const glm::vec4& a, const glm::vec4& b,
+                     const glm::vec4& c);
+    void rasterise(const glm::vec3& a, const glm::vec3& b,
+                   const glm::vec3& c);
+
+    glm::vec3 toScreen(const glm::vec4& clip) const;
+
+    int width;
+    int height;
+    std::vector<float> depth;
+    glm::mat4 viewProjection{1.f};
+    /// Reused for the vertices of each collision model
+    std::vector<glm::vec4> clipVertices;
+    size_t triangles = 0;
+};
+
+#endif
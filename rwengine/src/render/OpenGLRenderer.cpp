@@ -1,5 +1,6 @@
 #include "render/OpenGLRenderer.hpp"
 
+#include <algorithm>
 #include <cstring>
 #include <sstream>
 
@@ -10,12 +11,46 @@
 #include <gl/DrawBuffer.hpp>
 #include <rw/debug.hpp>
 
+#include "render/ShaderCache.hpp"
+
 namespace {
 constexpr GLuint kUBOIndexScene = 1;
 constexpr GLuint kUBOIndexDraw = 2;
+
+// Enough object entries per frame to cover a dense downtown view
+constexpr GLsizeiptr kObjectRingEntries = 8192;
+// Array stride of the ObjectData entries under std140 rules
+constexpr GLsizeiptr kObjectStride =
+    ((sizeof(Renderer::ObjectUniformData) + 15) / 16) * 16;
+// Size of the ObjectData block declared by the world shaders
+constexpr GLsizeiptr kObjectBlockSize = kObjectStride * Renderer::kMaxInstances;
+// Nanoseconds to wait for the GPU to release a ring buffer slice
+constexpr GLuint64 kRingFenceTimeout = 1000000000;
+
+Renderer::ObjectUniformData makeObjectData(const glm::mat4& model,
+                                           const Renderer::DrawParameters& p) {
+    return {model,
+            glm::vec4(p.colour.r / 255.f, p.colour.g / 255.f,
+                      p.colour.b / 255.f, p.colour.a / 255.f),
+            1.f, 1.f, p.visibility};
 }
 
-GLuint compileShader(GLenum type, const char* source) {
+GLsizeiptr alignOffset(GLsizeiptr offset, GLsizeiptr alignment) {
+    return ((offset + (alignment - 1)) / alignment) * alignment;
+}
+
+/// Instructions can share a draw if only their object uniforms differ
+bool canInstance(const Renderer::RenderInstruction& a,
+                 const Renderer::RenderInstruction& b) {
+    return a.dbuff == b.dbuff && a.drawInfo.start == b.drawInfo.start &&
+           a.drawInfo.count == b.drawInfo.count &&
+           a.drawInfo.textures == b.drawInfo.textures &&
+           a.drawInfo.blendMode == b.drawInfo.blendMode &&
+           a.drawInfo.depthMode == b.drawInfo.depthMode &&
+           a.drawInfo.depthWrite == b.drawInfo.depthWrite;
+}
+
+GLuint createShaderObject(GLenum type, const char* source) {
     GLuint shader = glCreateShader(type);
 
     if (shader == 0) {
@@ -26,6 +61,15 @@ GLuint compileShader(GLenum type, const char* source) {
     glShaderSource(shader, 1, &source, nullptr);
     glCompileShader(shader);
 
+    return shader;
+}
+
+/**
+ * Reports the outcome of glCompileShader, querying it waits for drivers
+ * that compile in the background
+ * @return false if compilation failed
+ */
+bool checkShader(GLuint shader) {
     GLint status;
     glGetShaderiv(shader, GL_COMPILE_STATUS, &status);
 
@@ -49,19 +93,30 @@ GLuint compileShader(GLenum type, const char* source) {
                   << sourceBuff.get());
     }
 
-    if (status != GL_TRUE) {
+    return status == GL_TRUE;
+}
+}  // namespace
+
+GLuint compileShader(GLenum type, const char* source) {
+    GLuint shader = createShaderObject(type, source);
+    if (!checkShader(shader)) {
         throw std::runtime_error("Compiling shader failed");
     }
-
     return shader;
 }
 
 GLuint compileProgram(const char* vertex, const char* fragment) {
-    GLuint vertexShader = compileShader(GL_VERTEX_SHADER, vertex);
-    GLuint fragmentShader = compileShader(GL_FRAGMENT_SHADER, fragment);
+    // Both stages are submitted before any status is queried, so drivers
+    // with threaded compilers can work on them at the same time
+    GLuint vertexShader = createShaderObject(GL_VERTEX_SHADER, vertex);
+    GLuint fragmentShader = createShaderObject(GL_FRAGMENT_SHADER, fragment);
 
     GLuint prog = glCreateProgram();
 
+    if (ogl_ext_ARB_get_program_binary) {
+        glProgramParameteri(prog, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+    }
+
     glAttachShader(prog, vertexShader);
     glAttachShader(prog, fragmentShader);
     glLinkProgram(prog);
@@ -69,9 +124,17 @@ GLuint compileProgram(const char* vertex, const char* fragment) {
     glDetachShader(prog, vertexShader);
     glDetachShader(prog, fragmentShader);
 
+    const bool vertexCompiled = checkShader(vertexShader);
+    const bool fragmentCompiled = checkShader(fragmentShader);
+
     glDeleteShader(vertexShader);
     glDeleteShader(fragmentShader);
 
+    if (!vertexCompiled || !fragmentCompiled) {
+        glDeleteProgram(prog);
+        throw std::runtime_error("Compiling shader failed");
+    }
+
     GLint status;
     glGetProgramiv(prog, GL_LINK_STATUS, &status);
 
@@ -90,6 +153,7 @@ GLuint compileProgram(const char* vertex, const char* fragment) {
     }
 
     if (status != GL_TRUE) {
+        glDeleteProgram(prog);
         throw std::runtime_error("Linking shaders failed");
     }
 
@@ -105,14 +169,22 @@ void Renderer::setViewport(const glm::ivec2& vp) {
 
 void Renderer::swap() {
     drawCounter = 0;
+    instanceCounter = 0;
     textureCounter = 0;
     bufferCounter = 0;
+    uploadCounter = 0;
+    uniformLookupCounter = 0;
+    uniformCounter = 0;
 }
 
 int Renderer::getDrawCount() {
     return drawCounter;
 }
 
+int Renderer::getInstanceCount() {
+    return instanceCounter;
+}
+
 int Renderer::getBufferCount() {
     return bufferCounter;
 }
@@ -121,6 +193,18 @@ int Renderer::getTextureCount() {
     return textureCounter;
 }
 
+int Renderer::getUploadCount() {
+    return uploadCounter;
+}
+
+int Renderer::getUniformLookupCount() {
+    return uniformLookupCounter;
+}
+
+int Renderer::getUniformCount() {
+    return uniformCounter;
+}
+
 const Renderer::SceneUniformData& Renderer::getSceneData() const {
     return lastSceneData;
 }
@@ -205,10 +289,14 @@ void OpenGLRenderer::useProgram(Renderer::ShaderProgram* p) {
     }
 }
 
-OpenGLRenderer::OpenGLRenderer() {
+OpenGLRenderer::OpenGLRenderer(const rwfs::path& shaderCacheDirectory) {
     // We need to query for some profiling exts.
     ogl_CheckExtensions();
 
+    if (!shaderCacheDirectory.empty() && ShaderCache::isSupported()) {
+        shaderCache = std::make_unique<ShaderCache>(shaderCacheDirectory);
+    }
+
     glGenQueries(1, &debugQuery);
 
     createUBO(UBOScene, sizeof(SceneUniformData), sizeof(SceneUniformData));
@@ -217,11 +305,27 @@ OpenGLRenderer::OpenGLRenderer() {
     GLint MaxUBOSize;
     glGetIntegerv(GL_MAX_UNIFORM_BLOCK_SIZE, &MaxUBOSize);
 
-    createUBO(UBOObject, MaxUBOSize, sizeof(ObjectUniformData));
+    createUBO(UBOObject, MaxUBOSize, sizeof(ObjectUniformData),
+              kObjectBlockSize);
+
+    createRing(objectRing, kObjectBlockSize, kObjectRingEntries);
 
     swap();
 }
 
+OpenGLRenderer::~OpenGLRenderer() {
+    for (auto& fence : objectRing.fences) {
+        if (fence) {
+            glDeleteSync(fence);
+        }
+    }
+    if (objectRing.mapped) {
+        attachUBO(objectRing.name);
+        glUnmapBuffer(GL_UNIFORM_BUFFER);
+    }
+    glDeleteBuffers(1, &objectRing.name);
+}
+
 std::string OpenGLRenderer::getIDString() const {
     std::stringstream ss;
     ss << "OpenGL Renderer";
@@ -233,7 +337,14 @@ std::string OpenGLRenderer::getIDString() const {
 
 std::unique_ptr<Renderer::ShaderProgram> OpenGLRenderer::createShader(const std::string& vert,
                                                       const std::string& frag) {
-    return std::make_unique<OpenGLShaderProgram>(compileProgram(vert.c_str(), frag.c_str()));
+    GLuint program = shaderCache ? shaderCache->load(vert, frag) : 0;
+    if (program == 0) {
+        program = compileProgram(vert.c_str(), frag.c_str());
+        if (shaderCache) {
+            shaderCache->store(vert, frag, program);
+        }
+    }
+    return std::make_unique<OpenGLShaderProgram>(program);
 }
 
 void OpenGLRenderer::setProgramBlockBinding(Renderer::ShaderProgram* p,
@@ -247,48 +358,97 @@ void OpenGLRenderer::setProgramBlockBinding(Renderer::ShaderProgram* p,
 
 void OpenGLRenderer::setUniformTexture(Renderer::ShaderProgram* p,
                                        const std::string& name, GLint tex) {
-    useProgram(p);
-
-    glUniform1i(currentProgram->getUniformLocation(name), tex);
+    setUniformTexture(getUniform(p, name), tex);
 }
 
 void OpenGLRenderer::setUniform(Renderer::ShaderProgram* p,
                                 const std::string& name, const glm::mat4& m) {
-    useProgram(p);
-
-    glUniformMatrix4fv(currentProgram->getUniformLocation(name.c_str()), 1,
-                       GL_FALSE, glm::value_ptr(m));
+    setUniform(getUniform(p, name), m);
 }
 
 void OpenGLRenderer::setUniform(Renderer::ShaderProgram* p,
                                 const std::string& name, const glm::vec4& m) {
-    useProgram(p);
-
-    glUniform4fv(currentProgram->getUniformLocation(name.c_str()), 1,
-                 glm::value_ptr(m));
+    setUniform(getUniform(p, name), m);
 }
 
 void OpenGLRenderer::setUniform(Renderer::ShaderProgram* p,
                                 const std::string& name, const glm::vec3& m) {
-    useProgram(p);
-
-    glUniform3fv(currentProgram->getUniformLocation(name.c_str()), 1,
-                 glm::value_ptr(m));
+    setUniform(getUniform(p, name), m);
 }
 
 void OpenGLRenderer::setUniform(Renderer::ShaderProgram* p,
                                 const std::string& name, const glm::vec2& m) {
-    useProgram(p);
-
-    glUniform2fv(currentProgram->getUniformLocation(name.c_str()), 1,
-                 glm::value_ptr(m));
+    setUniform(getUniform(p, name), m);
 }
 
 void OpenGLRenderer::setUniform(Renderer::ShaderProgram* p,
                                 const std::string& name, float f) {
-    useProgram(p);
+    setUniform(getUniform(p, name), f);
+}
+
+Renderer::Uniform OpenGLRenderer::getUniform(Renderer::ShaderProgram* p,
+                                             const std::string& name) {
+    uniformLookupCounter++;
+    auto glsh = static_cast<OpenGLShaderProgram*>(p);
+    return {p, glsh->findUniform(name)};
+}
+
+GLint OpenGLRenderer::prepareUniform(const Renderer::Uniform& u,
+                                     const void* data, size_t size) {
+    // Callers rely on this binding the program, even if nothing changes
+    useProgram(u.program);
+
+    if (u.slot < 0 || !currentProgram->storeValue(u.slot, data, size)) {
+        return -1;
+    }
+    uniformCounter++;
+    return currentProgram->getLocation(u.slot);
+}
+
+void OpenGLRenderer::setUniformTexture(const Renderer::Uniform& u, GLint tex) {
+    const auto location = prepareUniform(u, &tex, sizeof(tex));
+    if (location >= 0) {
+        glUniform1i(location, tex);
+    }
+}
+
+void OpenGLRenderer::setUniform(const Renderer::Uniform& u,
+                                const glm::mat4& m) {
+    const auto location = prepareUniform(u, &m, sizeof(m));
+    if (location >= 0) {
+        glUniformMatrix4fv(location, 1, GL_FALSE, glm::value_ptr(m));
+    }
+}
+
+void OpenGLRenderer::setUniform(const Renderer::Uniform& u,
+                                const glm::vec4& v) {
+    const auto location = prepareUniform(u, &v, sizeof(v));
+    if (location >= 0) {
+        glUniform4fv(location, 1, glm::value_ptr(v));
+    }
+}
+
+void OpenGLRenderer::setUniform(const Renderer::Uniform& u,
+                                const glm::vec3& v) {
+    const auto location = prepareUniform(u, &v, sizeof(v));
+    if (location >= 0) {
+        glUniform3fv(location, 1, glm::value_ptr(v));
+    }
+}
 
-    glUniform1fv(currentProgram->getUniformLocation(name.c_str()), 1, &f);
+void OpenGLRenderer::setUniform(const Renderer::Uniform& u,
+                                const glm::vec2& v) {
+    const auto location = prepareUniform(u, &v, sizeof(v));
+    if (location >= 0) {
+        glUniform2fv(location, 1, glm::value_ptr(v));
+    }
+}
+
+void OpenGLRenderer::setUniform(const Renderer::Uniform& u, float f) {
+    const auto location = prepareUniform(u, &f, sizeof(f));
+    if (location >= 0) {
+        glUniform1fv(location, 1, &f);
+    }
 }
 
 void OpenGLRenderer::clear(const glm::vec4& colour, bool clearColour,
@@ -317,8 +477,9 @@ void OpenGLRenderer::setSceneParameters(
     lastSceneData = data;
 }
 
-void OpenGLRenderer::setDrawState(const glm::mat4& model, DrawBuffer* draw,
-                                  const Renderer::DrawParameters& p) {
+void OpenGLRenderer::setDrawParameters(DrawBuffer* draw,
+                                       const Renderer::DrawParameters& p,
+                                       GLsizei instances) {
     useDrawBuffer(draw);
 
     for (GLuint u = 0; u < p.textures.size(); ++u) {
@@ -329,21 +490,24 @@ void OpenGLRenderer::setDrawState(const glm::mat4& model, DrawBuffer* draw,
     setDepthWrite(p.depthWrite);
     setDepthMode(p.depthMode);
 
-    ObjectUniformData objectData{model,
-                             glm::vec4(p.colour.r / 255.f, p.colour.g / 255.f,
-                                       p.colour.b / 255.f, p.colour.a / 255.f),
-                             1.f, 1.f, p.visibility};
-    uploadUBO(UBOObject, objectData);
-
     drawCounter++;
+    instanceCounter += instances;
 #ifdef RW_GRAPHICS_STATS
     if (currentDebugDepth > 0) {
         profileInfo[currentDebugDepth - 1].draws++;
-        profileInfo[currentDebugDepth - 1].primitives += p.count;
+        profileInfo[currentDebugDepth - 1].instances += instances;
+        profileInfo[currentDebugDepth - 1].primitives += p.count * instances;
     }
 #endif
 }
 
+void OpenGLRenderer::setDrawState(const glm::mat4& model, DrawBuffer* draw,
+                                  const Renderer::DrawParameters& p) {
+    setDrawParameters(draw, p);
+
+    uploadUBO(UBOObject, makeObjectData(model, p));
+}
+
 void OpenGLRenderer::draw(const glm::mat4& model, DrawBuffer* draw,
                           const Renderer::DrawParameters& p) {
     setDrawState(model, draw, p);
@@ -362,53 +526,86 @@ void OpenGLRenderer::drawArrays(const glm::mat4& model, DrawBuffer* draw,
 
 void OpenGLRenderer::drawBatched(const RenderList& list) {
     RW_PROFILE_SCOPE(__func__);
-#if 0  // Needs shader changes
-	// Determine how many batches we need to process the entire list
-	auto entries = list.size();
-	glBindBuffer(GL_UNIFORM_BUFFER, UBOObject);
-	for (int b = 0; b < entries; b += maxObjectEntries)
-	{
-		auto toConsume = std::min((GLuint)entries, b + maxObjectEntries) - b;
-		std::vector<ObjectUniformData> uploadBuffer;
-		uploadBuffer.resize(toConsume);
-		for (int d = 0; d < toConsume; ++d)
-		{
-			auto& draw = list[b+d];
-			uploadBuffer[d] = {
-				draw.model,
-				glm::vec4(draw.drawInfo.colour.r/255.f,
-				draw.drawInfo.colour.g/255.f,
-				draw.drawInfo.colour.b/255.f, 1.f),
-				1.f,
-				1.f,
-				draw.drawInfo.colour.a/255.f
-			};
-		}
-		glBufferData(GL_UNIFORM_BUFFER,
-					 toConsume * sizeof(ObjectUniformData),
-					 uploadBuffer.data(),
-					 GL_STREAM_DRAW);
-
-		// Dispatch individual draws
-		for (int d = 0; d < toConsume; ++d)
-		{
-			auto& draw = list[b+d];
-			useDrawBuffer(draw.dbuff);
-
-			for( GLuint u = 0; u < draw.drawInfo.textures.size(); ++u )
-			{
-				useTexture(u, draw.drawInfo.textures[u]);
-			}
-
-			glDrawElements(draw.dbuff->getFaceType(), draw.drawInfo.count, GL_UNSIGNED_INT,
-                           reinterpret_cast<void*>(sizeof(RenderIndex) * draw.drawInfo.start));
-		}
-	}
-#else
-    for (auto& ri : list) {
+    auto& ring = objectRing;
+
+    // Split as much of the list as this frame's slice holds into runs of
+    // instructions that only differ by their object uniforms.
+    batches.clear();
+    auto head = ring.head;
+    size_t first = 0;
+    while (first < list.size() && head + ring.bindSize <= ring.frameSize) {
+        size_t last = first + 1;
+        while (last < list.size() &&
+               last - first < static_cast<size_t>(kMaxInstances) &&
+               canInstance(list[first], list[last])) {
+            last++;
+        }
+
+        const auto count = static_cast<GLsizei>(last - first);
+        batches.push_back({first, count, head});
+        head += alignOffset(count * kObjectStride, ring.alignment);
+        first = last;
+    }
+
+    if (!batches.empty()) {
+        const auto base = ring.frame * ring.frameSize;
+
+        attachUBO(ring.name);
+        std::uint8_t* dst = ring.mapped;
+        if (dst) {
+            dst += base + ring.head;
+        } else {
+            // The fence guarantees the GPU is done with this range
+            const auto flags = GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_RANGE_BIT |
+                               GL_MAP_UNSYNCHRONIZED_BIT;
+            dst = static_cast<std::uint8_t*>(glMapBufferRange(
+                GL_UNIFORM_BUFFER, base + ring.head, head - ring.head, flags));
+            RW_ASSERT(dst != nullptr);
+        }
+
+        for (const auto& batch : batches) {
+            auto entry = dst + (batch.offset - ring.head);
+            for (GLsizei i = 0; i < batch.count; ++i) {
+                const auto& ri = list[batch.first + i];
+                const auto data = makeObjectData(ri.model, ri.drawInfo);
+                memcpy(entry, &data, sizeof(data));
+                entry += kObjectStride;
+            }
+        }
+
+        if (!ring.mapped) {
+            glUnmapBuffer(GL_UNIFORM_BUFFER);
+        }
+        countUpload();
+
+        // Dispatch the draws, only moving the uniform range
+        for (const auto& batch : batches) {
+            const auto& ri = list[batch.first];
+            setDrawParameters(ri.dbuff, ri.drawInfo, batch.count);
+
+            glBindBufferRange(GL_UNIFORM_BUFFER, kUBOIndexDraw, ring.name,
+                              base + batch.offset, ring.bindSize);
+
+            const auto count = static_cast<GLsizei>(ri.drawInfo.count);
+            const auto offset = reinterpret_cast<void*>(
+                sizeof(RenderIndex) * ri.drawInfo.start);
+            if (batch.count > 1) {
+                glDrawElementsInstanced(ri.dbuff->getFaceType(), count,
+                                        GL_UNSIGNED_INT, offset, batch.count);
+            } else {
+                glDrawElements(ri.dbuff->getFaceType(), count,
+                               GL_UNSIGNED_INT, offset);
+            }
+        }
+
+        ring.head = head;
+    }
+
+    // Anything that didn't fit falls back to uploading per draw
+    for (size_t d = first; d < list.size(); ++d) {
+        const auto& ri = list[d];
         draw(ri.model, ri.dbuff, ri.drawInfo);
     }
-#endif
 }
 
 void OpenGLRenderer::invalidate() {
@@ -420,7 +617,13 @@ void OpenGLRenderer::invalidate() {
     setDepthMode(DepthMode::OFF);
 }
 
-bool OpenGLRenderer::createUBO(Buffer &out, GLsizei size, GLsizei entrySize)
+void OpenGLRenderer::swap() {
+    Renderer::swap();
+    advanceRing(objectRing);
+}
+
+bool OpenGLRenderer::createUBO(Buffer &out, GLsizei size, GLsizei entrySize,
+                               GLsizei bindSize)
 {
     glGenBuffers(1, &out.name);
     glBindBuffer(GL_UNIFORM_BUFFER, out.name);
@@ -433,13 +636,67 @@ bool OpenGLRenderer::createUBO(Buffer &out, GLsizei size, GLsizei entrySize)
         entrySize = ((entrySize + (UBOAlignment-1))/UBOAlignment) * UBOAlignment;
     }
 
+    // Each bound range may extend past its entry, but not the buffer
+    out.bindSize = std::max(bindSize, entrySize);
     out.bufferSize = size;
     out.entrySize = entrySize;
-    out.entryCount = size / entrySize;
+    out.entryCount = (size - out.bindSize) / entrySize + 1;
 
     return true;
 }
 
+bool OpenGLRenderer::createRing(RingBuffer& out, GLsizeiptr bindSize,
+                                GLsizeiptr entries) {
+    GLint UBOAlignment;
+    glGetIntegerv(GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT, &UBOAlignment);
+    RW_ASSERT(UBOAlignment > 0);
+
+    // Leave room to bind a whole block from the last entry of a slice
+    out.alignment = UBOAlignment;
+    out.bindSize = bindSize;
+    out.frameSize =
+        alignOffset(kObjectStride, out.alignment) * entries + bindSize;
+    const auto size = out.frameSize * kObjectRingFrames;
+
+    glGenBuffers(1, &out.name);
+    attachUBO(out.name);
+
+    if (ogl_ext_ARB_buffer_storage) {
+        const auto flags =
+            GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+        glBufferStorage(GL_UNIFORM_BUFFER, size, nullptr, flags);
+        out.mapped = static_cast<std::uint8_t*>(
+            glMapBufferRange(GL_UNIFORM_BUFFER, 0, size, flags));
+    }
+
+    if (!out.mapped) {
+        glBufferData(GL_UNIFORM_BUFFER, size, nullptr, GL_STREAM_DRAW);
+    }
+
+    return true;
+}
+
+void OpenGLRenderer::advanceRing(RingBuffer& ring) {
+    if (ring.name == 0) {
+        return;
+    }
+
+    // Fence the slice written this frame so it isn't reused too early
+    if (ring.head > 0) {
+        ring.fences[ring.frame] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+    }
+
+    ring.frame = (ring.frame + 1) % kObjectRingFrames;
+    ring.head = 0;
+
+    auto& fence = ring.fences[ring.frame];
+    if (fence) {
+        glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, kRingFenceTimeout);
+        glDeleteSync(fence);
+        fence = nullptr;
+    }
+}
+
 void OpenGLRenderer::attachUBO(GLuint buffer) {
     if (currentUBO != buffer) {
         glBindBuffer(GL_UNIFORM_BUFFER, buffer);
@@ -466,7 +723,8 @@ void OpenGLRenderer::uploadUBOEntry(Buffer &buffer, const void *data, size_t siz
         RW_ASSERT(dst != nullptr);
         memcpy(dst, data, size);
         glUnmapBuffer(GL_UNIFORM_BUFFER);
-        glBindBufferRange(GL_UNIFORM_BUFFER, kUBOIndexDraw, buffer.name, offset, size);
+        glBindBufferRange(GL_UNIFORM_BUFFER, kUBOIndexDraw, buffer.name, offset,
+                          buffer.bindSize);
         buffer.currentEntry++;
     }
     else {
@@ -479,8 +737,8 @@ void OpenGLRenderer::pushDebugGroup(const std::string& title) {
     if (ogl_ext_KHR_debug) {
         glPushDebugGroup(GL_DEBUG_SOURCE_APPLICATION, 0, -1, title.c_str());
         ProfileInfo& prof = profileInfo[currentDebugDepth];
-        prof.buffers = prof.draws = prof.textures = prof.uploads =
-            prof.primitives = 0;
+        prof.buffers = prof.draws = prof.instances = prof.textures =
+            prof.uploads = prof.primitives = 0;
 
         glQueryCounter(debugQuery, GL_TIMESTAMP);
         glGetQueryObjectui64v(debugQuery, GL_QUERY_RESULT, &prof.timerStart);
@@ -512,6 +770,7 @@ const Renderer::ProfileInfo& OpenGLRenderer::popDebugGroup() {
         if (currentDebugDepth > 0) {
             ProfileInfo& p = profileInfo[currentDebugDepth - 1];
             p.draws += prof.draws;
+            p.instances += prof.instances;
             p.buffers += prof.buffers;
             p.primitives += prof.primitives;
             p.textures += prof.textures;
@@ -526,14 +785,54 @@ const Renderer::ProfileInfo& OpenGLRenderer::popDebugGroup() {
 
 Renderer::ShaderProgram::~ShaderProgram() = default;
 
-GLint OpenGLRenderer::OpenGLShaderProgram::getUniformLocation(const std::string &name) {
-    auto c = uniforms.find(name.c_str());
-    GLint loc = -1;
-    if (c == uniforms.end()) {
-        loc = glGetUniformLocation(program, name.c_str());
-        uniforms[name] = loc;
-    } else {
-        loc = c->second;
+OpenGLRenderer::OpenGLShaderProgram::OpenGLShaderProgram(GLuint p)
+    : program(p) {
+    GLint count = 0;
+    GLint maxLength = 0;
+    glGetProgramiv(program, GL_ACTIVE_UNIFORMS, &count);
+    glGetProgramiv(program, GL_ACTIVE_UNIFORM_MAX_LENGTH, &maxLength);
+
+    std::vector<GLchar> name(static_cast<size_t>(std::max(maxLength, 1)));
+    for (GLint i = 0; i < count; ++i) {
+        GLsizei length = 0;
+        GLint size = 0;
+        GLenum type = 0;
+        glGetActiveUniform(program, static_cast<GLuint>(i), maxLength, &length,
+                           &size, &type, name.data());
+
+        // Members of uniform blocks don't have a location
+        const auto location = glGetUniformLocation(program, name.data());
+        if (location < 0) {
+            continue;
+        }
+
+        // Arrays are listed by their first element
+        std::string uniformName(name.data(), static_cast<size_t>(length));
+        const auto bracket = uniformName.find('[');
+        if (bracket != std::string::npos) {
+            uniformName.resize(bracket);
+        }
+
+        slotNames.emplace(uniformName, static_cast<int>(slots.size()));
+        slots.push_back({location});
     }
-    return loc;
+}
+
+int OpenGLRenderer::OpenGLShaderProgram::findUniform(
+    const std::string& name) const {
+    auto it = slotNames.find(name);
+    return it != slotNames.end() ? it->second : -1;
+}
+
+bool OpenGLRenderer::OpenGLShaderProgram::storeValue(int slot,
+                                                     const void* data,
+                                                     size_t size) {
+    auto& stored = slots[static_cast<size_t>(slot)];
+    RW_ASSERT(size <= stored.value.size());
+    if (stored.size == size && memcmp(stored.value.data(), data, size) == 0) {
+        return false;
+    }
+    memcpy(stored.value.data(), data, size);
+    stored.size = size;
+    return true;
 }
@@ -10,6 +10,7 @@
 #include <array>
 
 #include <gl/GeometryBuffer.hpp>
+#include <rw/filesystem.hpp>
 
 #include <glm/gtc/type_precision.hpp>
 #include <glm/mat4x4.hpp>
@@ -17,6 +18,7 @@
 #include <glm/vec4.hpp>
 
 class DrawBuffer;
+class ShaderCache;
 
 typedef uint64_t RenderKey;
 
@@ -138,6 +140,12 @@ public:
         float visibility{};
     };
 
+    /**
+     * Maximum number of instances in a single draw, the world shaders size
+     * their ObjectData array from it.
+     */
+    static constexpr GLsizei kMaxInstances = 64;
+
     struct SceneUniformData {
         glm::mat4 projection{1.0f};
         glm::mat4 view{1.0f};
@@ -181,6 +189,26 @@ public:
     virtual void setUniform(ShaderProgram* p, const std::string& name,
                             float f) = 0;
 
+    /**
+     * A uniform resolved ahead of time with getUniform. Setting a value
+     * through a handle skips the name lookup, and values that haven't
+     * changed since the last call aren't sent to GL again.
+     */
+    struct Uniform {
+        ShaderProgram* program = nullptr;
+        /// Index into the program's uniforms, -1 if it isn't active
+        int slot = -1;
+    };
+
+    virtual Uniform getUniform(ShaderProgram* p, const std::string& name) = 0;
+
+    virtual void setUniformTexture(const Uniform& u, GLint tex) = 0;
+    virtual void setUniform(const Uniform& u, const glm::mat4& m) = 0;
+    virtual void setUniform(const Uniform& u, const glm::vec4& v) = 0;
+    virtual void setUniform(const Uniform& u, const glm::vec3& v) = 0;
+    virtual void setUniform(const Uniform& u, const glm::vec2& v) = 0;
+    virtual void setUniform(const Uniform& u, float f) = 0;
+
     virtual void clear(const glm::vec4& colour, bool clearColour = true,
                        bool clearDepth = true) = 0;
 
@@ -207,14 +235,32 @@ public:
     /**
      * Resets all per-frame counters.
      */
-    void swap();
+    virtual void swap();
 
     /**
      * Returns the number of draw calls issued for the current frame.
      */
     int getDrawCount();
+    /**
+     * Returns the number of objects drawn for the current frame,
+     * instanced draws count each of their instances.
+     */
+    int getInstanceCount();
     int getTextureCount();
     int getBufferCount();
+    /**
+     * Returns the number of uniform buffer uploads for the current frame.
+     */
+    int getUploadCount();
+    /**
+     * Returns the number of uniforms looked up by name for the current
+     * frame, including the name based setUniform calls.
+     */
+    int getUniformLookupCount();
+    /**
+     * Returns the number of uniform values sent to GL for the current frame.
+     */
+    int getUniformCount();
 
     const SceneUniformData& getSceneData() const;
 
@@ -228,6 +274,7 @@ public:
         GLuint64 duration{};
         unsigned int primitives{};
         unsigned int draws{};
+        unsigned int instances{};
         unsigned int textures{};
         unsigned int buffers{};
         unsigned int uploads{};
@@ -250,8 +297,12 @@ private:
 
 protected:
     int drawCounter{};
+    int instanceCounter{};
     int textureCounter{};
     int bufferCounter{};
+    int uploadCounter{};
+    int uniformLookupCounter{};
+    int uniformCounter{};
     SceneUniformData lastSceneData{};
 };
 
@@ -259,11 +310,21 @@ class OpenGLRenderer final : public Renderer {
 public:
     class OpenGLShaderProgram final : public ShaderProgram {
         GLuint program;
-        std::map<std::string, GLint> uniforms;
+
+        struct UniformSlot {
+            GLint location;
+            /// The last value set, to skip redundant updates
+            std::array<std::uint8_t, sizeof(glm::mat4)> value{};
+            size_t size = 0;
+        };
+        std::vector<UniformSlot> slots;
+        std::map<std::string, int> slotNames;
 
     public:
-        OpenGLShaderProgram(GLuint p) : program(p) {
-        }
+        /**
+         * Resolves the locations of all of the program's active uniforms
+         */
+        explicit OpenGLShaderProgram(GLuint p);
 
         ~OpenGLShaderProgram() override {
             glDeleteProgram(program);
@@ -273,15 +334,40 @@ public:
             return program;
         }
 
-        GLint getUniformLocation(const std::string& name);
+        /**
+         * @return The slot for a uniform, or -1 if it isn't active
+         */
+        int findUniform(const std::string& name) const;
+
+        GLint getLocation(int slot) const {
+            return slots[static_cast<size_t>(slot)].location;
+        }
+
+        /**
+         * Stores the value for a slot
+         * @return false if the slot already had this value
+         */
+        bool storeValue(int slot, const void* data, size_t size);
     };
 
-    OpenGLRenderer();
+    /**
+     * @param shaderCacheDirectory Where to keep linked program binaries,
+     * programs are compiled every time if empty
+     */
+    explicit OpenGLRenderer(const rwfs::path& shaderCacheDirectory = {});
 
-    ~OpenGLRenderer() override = default;
+    ~OpenGLRenderer() override;
 
     std::string getIDString() const override;
 
+    /**
+     * @return The program binary cache, or nullptr if the driver or
+     * configuration doesn't allow one
+     */
+    ShaderCache* getShaderCache() const {
+        return shaderCache.get();
+    }
+
     std::unique_ptr<ShaderProgram> createShader(const std::string& vert,
                                 const std::string& frag) override;
     void setProgramBlockBinding(ShaderProgram* p, const std::string& name,
@@ -298,6 +384,16 @@ public:
                     const glm::vec2& m) override;
     void setUniform(ShaderProgram* p, const std::string& name,
                     float f) override;
+
+    Uniform getUniform(ShaderProgram* p, const std::string& name) override;
+
+    void setUniformTexture(const Uniform& u, GLint tex) override;
+    void setUniform(const Uniform& u, const glm::mat4& m) override;
+    void setUniform(const Uniform& u, const glm::vec4& v) override;
+    void setUniform(const Uniform& u, const glm::vec3& v) override;
+    void setUniform(const Uniform& u, const glm::vec2& v) override;
+    void setUniform(const Uniform& u, float f) override;
+
     void useProgram(ShaderProgram* p) override;
 
     void clear(const glm::vec4& colour, bool clearColour = true,
@@ -317,6 +413,8 @@ public:
 
     void invalidate() override;
 
+    void swap() override;
+
     void pushDebugGroup(const std::string& title) override;
 
     const ProfileInfo& popDebugGroup() override;
@@ -329,14 +427,54 @@ private:
         GLuint entryCount{};
         GLuint entrySize{};
         GLsizei bufferSize{};
+        /// Size of the range bound for each entry
+        GLsizei bindSize{};
+    };
+
+    /// Number of frames the object ring buffer is split into
+    static constexpr GLuint kObjectRingFrames = 3;
+
+    /**
+     * Stores per-object uniforms for every instruction in a RenderList.
+     *
+     * Each frame writes into its own slice, which is fenced at the end of
+     * the frame and only reused once the GPU has finished reading it.
+     * Instances of a draw are packed together from an aligned offset.
+     */
+    struct RingBuffer {
+        GLuint name{};
+        /// Persistent mapping, null if each batch has to map its range.
+        std::uint8_t* mapped = nullptr;
+
+        GLsizeiptr alignment{};
+        GLsizeiptr bindSize{};
+        GLsizeiptr frameSize{};
+        GLsizeiptr head{};
+        GLuint frame{};
+        std::array<GLsync, kObjectRingFrames> fences{};
+    };
+
+    /// A run of instructions from a RenderList drawn with one call
+    struct Batch {
+        size_t first;
+        GLsizei count;
+        GLsizeiptr offset;
     };
 
     void useDrawBuffer(DrawBuffer* dbuff);
 
     void useTexture(GLuint unit, GLuint tex);
 
+    /**
+     * Binds the uniform's program and stores the new value
+     * @return The location to update, or -1 if there is nothing to send
+     */
+    GLint prepareUniform(const Uniform& u, const void* data, size_t size);
+
     Buffer UBOObject {};
     Buffer UBOScene {};
+    RingBuffer objectRing {};
+    std::vector<Batch> batches;
 
     // State Cache
     DrawBuffer* currentDbuff = nullptr;
@@ -355,9 +493,18 @@ private:
 
     void setDepthWrite(bool enable);
 
+    /// Applies everything but the object uniforms for a draw
+    void setDrawParameters(DrawBuffer* draw, const DrawParameters& p,
+                           GLsizei instances = 1);
+
     template <class T>
     void uploadUBO(Buffer& buffer, const T& data) {
         uploadUBOEntry(buffer, &data, sizeof(T));
+        countUpload();
+    }
+
+    void countUpload() {
+        uploadCounter++;
 #ifdef RW_GRAPHICS_STATS
         if (currentDebugDepth > 0) {
             profileInfo[currentDebugDepth - 1].uploads++;
@@ -366,15 +513,23 @@ private:
     }
 
     // Buffer Helpers
-    bool createUBO(Buffer& out, GLsizei size, GLsizei entrySize);
+    bool createUBO(Buffer& out, GLsizei size, GLsizei entrySize,
+                   GLsizei bindSize = 0);
 
     void attachUBO(GLuint buffer);
 
     void uploadUBOEntry(Buffer& buffer, const void *data, size_t size);
 
+    // Ring Helpers
+    bool createRing(RingBuffer& out, GLsizeiptr bindSize, GLsizeiptr entries);
+
+    void advanceRing(RingBuffer& ring);
+
     // Debug group profiling timers
     ProfileInfo profileInfo[MAX_DEBUG_DEPTH];
     GLuint debugQuery;
+
+    std::unique_ptr<ShaderCache> shaderCache;
 #ifdef RW_GRAPHICS_STATS
     int currentDebugDepth = 0;
 #endif
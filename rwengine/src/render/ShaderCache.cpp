@@ -0,0 +1,205 @@
+#include "render/ShaderCache.hpp"
+
+#include <array>
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <utility>
+#include <vector>
+
+namespace {
+constexpr std::array<char, 4> kMagic{{'R', 'W', 'S', 'C'}};
+constexpr std::uint32_t kVersion = 1;
+constexpr const char* kExtension = ".rwsc";
+
+/// Larger binaries are assumed to be damaged
+constexpr std::uint32_t kMaxBinarySize = 64 * 1024 * 1024;
+constexpr std::uint32_t kMaxDriverLength = 4096;
+
+template <class T>
+void write(std::ostream& out, const T& value) {
+    out.write(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+template <class T>
+bool read(std::istream& in, T& value) {
+    in.read(reinterpret_cast<char*>(&value), sizeof(T));
+    return in.good();
+}
+
+std::uint64_t hash(std::uint64_t h, const std::string& data) {
+    // FNV-1a, with a separator so the strings can't run into each other
+    for (const auto c : data) {
+        h ^= static_cast<std::uint8_t>(c);
+        h *= 1099511628211ull;
+    }
+    h ^= 0xFF;
+    h *= 1099511628211ull;
+    return h;
+}
+
+std::string getString(GLenum name) {
+    const auto value = glGetString(name);
+    return value ? reinterpret_cast<const char*>(value) : "";
+}
+}  // namespace
+
+ShaderCache::ShaderCache(rwfs::path directory)
+    : directory(std::move(directory)), driver(getDriverID()) {
+}
+
+bool ShaderCache::isSupported() {
+    if (!ogl_ext_ARB_get_program_binary) {
+        return false;
+    }
+    GLint formats = 0;
+    glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &formats);
+    return formats > 0;
+}
+
+std::string ShaderCache::getDriverID() {
+    std::stringstream ss;
+    ss << getString(GL_VENDOR) << '\n'
+       << getString(GL_RENDERER) << '\n'
+       << getString(GL_VERSION) << '\n'
+       << getString(GL_SHADING_LANGUAGE_VERSION);
+
+    // Drivers list a new format when their binaries change
+    if (ogl_ext_ARB_get_program_binary) {
+        GLint count = 0;
+        glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &count);
+        if (count > 0) {
+            std::vector<GLint> formats(static_cast<size_t>(count));
+            glGetIntegerv(GL_PROGRAM_BINARY_FORMATS, formats.data());
+            for (const auto format : formats) {
+                ss << '\n' << std::hex << format;
+            }
+        }
+    }
+    return ss.str();
+}
+
+rwfs::path ShaderCache::getPath(const std::string& vertex,
+                                const std::string& fragment) const {
+    std::uint64_t h = 14695981039346656037ull;
+    h = hash(h, driver);
+    h = hash(h, vertex);
+    h = hash(h, fragment);
+
+    char name[17];
+    std::snprintf(name, sizeof(name), "%016llx",
+                  static_cast<unsigned long long>(h));
+    return directory / (std::string(name) + kExtension);
+}
+
+GLuint ShaderCache::load(const std::string& vertex,
+                         const std::string& fragment) {
+    std::ifstream in(getPath(vertex, fragment).string(), std::ios::binary);
+    if (!in.is_open()) {
+        misses++;
+        return 0;
+    }
+
+    std::array<char, 4> magic{};
+    std::uint32_t version = 0;
+    std::uint32_t driverLength = 0;
+    in.read(magic.data(), magic.size());
+    if (!in.good() || magic != kMagic || !read(in, version) ||
+        version != kVersion || !read(in, driverLength) ||
+        driverLength > kMaxDriverLength) {
+        misses++;
+        return 0;
+    }
+
+    std::string storedDriver(driverLength, '\0');
+    in.read(&storedDriver[0], driverLength);
+    std::uint64_t vertexLength = 0;
+    std::uint64_t fragmentLength = 0;
+    std::uint32_t format = 0;
+    std::uint32_t size = 0;
+    if (!in.good() || storedDriver != driver || !read(in, vertexLength) ||
+        vertexLength != vertex.size() || !read(in, fragmentLength) ||
+        fragmentLength != fragment.size() || !read(in, format) ||
+        !read(in, size) || size == 0 || size > kMaxBinarySize) {
+        misses++;
+        return 0;
+    }
+
+    std::vector<char> binary(size);
+    in.read(binary.data(), size);
+    if (!in.good()) {
+        misses++;
+        return 0;
+    }
+
+    GLuint program = glCreateProgram();
+    glProgramBinary(program, format, binary.data(),
+                    static_cast<GLsizei>(binary.size()));
+
+    GLint status = GL_FALSE;
+    glGetProgramiv(program, GL_LINK_STATUS, &status);
+    if (status != GL_TRUE) {
+        glDeleteProgram(program);
+        misses++;
+        return 0;
+    }
+
+    hits++;
+    return program;
+}
+
+bool ShaderCache::store(const std::string& vertex, const std::string& fragment,
+                        GLuint program) {
+    GLint length = 0;
+    glGetProgramiv(program, GL_PROGRAM_BINARY_LENGTH, &length);
+    if (length <= 0) {
+        return false;
+    }
+
+    std::vector<char> binary(static_cast<size_t>(length));
+    GLenum format = 0;
+    GLsizei written = 0;
+    glGetProgramBinary(program, length, &written, &format, binary.data());
+    if (written <= 0) {
+        return false;
+    }
+    binary.resize(static_cast<size_t>(written));
+
+    rwfs::error_code ec;
+    rwfs::create_directories(directory, ec);
+    if (ec) {
+        return false;
+    }
+
+    // Renamed once complete, so a partial file can't be loaded
+    const auto path = getPath(vertex, fragment);
+    auto temporary = path;
+    temporary += ".tmp";
+    {
+        std::ofstream out(temporary.string(), std::ios::binary);
+        if (!out.is_open()) {
+            return false;
+        }
+        out.write(kMagic.data(), kMagic.size());
+        write(out, kVersion);
+        write(out, static_cast<std::uint32_t>(driver.size()));
+        out.write(driver.data(), static_cast<std::streamsize>(driver.size()));
+        write(out, static_cast<std::uint64_t>(vertex.size()));
+        write(out, static_cast<std::uint64_t>(fragment.size()));
+        write(out, static_cast<std::uint32_t>(format));
+        write(out, static_cast<std::uint32_t>(binary.size()));
+        out.write(binary.data(), static_cast<std::streamsize>(binary.size()));
+        if (!out.good()) {
+            out.close();
+            rwfs::remove(temporary, ec);
+            return false;
+        }
+    }
+    rwfs::rename(temporary, path, ec);
+    if (ec) {
+        rwfs::remove(temporary, ec);
+        return false;
+    }
+    return true;
+}
@@ -0,0 +1,66 @@
+#ifndef _RWENGINE_SHADERCACHE_HPP_
+#define _RWENGINE_SHADERCACHE_HPP_
+
+#include <cstddef>
+#include <string>
+
+#include <gl/gl_core_3_3.h>
+#include <rw/filesystem.hpp>
+
+/**
+ * Linked programs stored on disk with glGetProgramBinary, so later launches
+ * don't have to compile the GLSL sources again
+ *
+ * Binaries are keyed by the shader sources and the driver: vendor, renderer,
+ * version strings and the binary formats it supports. Binaries the driver
+ * rejects, for example after an update that didn't change the strings, are
+ * treated as a miss and the caller compiles the sources instead.
+ *
+ * Needs a current context with ARB_get_program_binary.
+ */
+class ShaderCache {
+public:
+    explicit ShaderCache(rwfs::path directory);
+
+    /**
+     * @return true if the driver can save program binaries
+     */
+    static bool isSupported();
+
+    /**
+     * @return Identifies the driver that created the binaries
+     */
+    static std::string getDriverID();
+
+    /**
+     * @return A linked program, or 0 if it isn't in the cache or the driver
+     * can't use the binary
+     */
+    GLuint load(const std::string& vertex, const std::string& fragment);
+
+    /**
+     * Saves the binary of a program linked from these sources
+     * @return false if the binary couldn't be retrieved or written
+     */
+    bool store(const std::string& vertex, const std::string& fragment,
+               GLuint program);
+
+    rwfs::path getPath(const std::string& vertex,
+                       const std::string& fragment) const;
+
+    size_t getHitCount() const {
+        return hits;
+    }
+
+    size_t getMissCount() const {
+        return misses;
+    }
+
+private:
+    rwfs::path directory;
+    std::string driver;
+    size_t hits = 0;
+    size_t misses = 0;
+};
+
+#endif
@@ -115,36 +115,19 @@ glm::vec4 indexToTexCoord(size_t index, const glm::u32vec2 &textureSize,
     float q = ((y + 1) * glyphOffset.y - 1.5f) / textureSize.y;
     return glm::vec4(s, t, p, q);
 }
-
-struct TextVertex {
-    glm::vec2 position;
-    glm::vec2 texcoord;
-    glm::vec3 colour;
-
-    TextVertex(glm::vec2 _position, glm::vec2 _texcoord, glm::vec3 _colour)
-        : position(_position), texcoord(_texcoord), colour(_colour) {
-    }
-
-    TextVertex() = default;
-
-    static const AttributeList vertex_attributes() {
-        return {
-            {ATRS_Position, 2, sizeof(TextVertex), 0ul},
-            {ATRS_TexCoord, 2, sizeof(TextVertex), 0ul + sizeof(glm::vec2)},
-            {ATRS_Colour, 3, sizeof(TextVertex), 0ul + sizeof(glm::vec2) * 2},
-        };
-    }
-};
 }  // namespace
 
 TextRenderer::TextRenderer(GameRenderer &renderer) : renderer(renderer) {
     textShader = renderer.getRenderer().createShader(TextVertexShader,
                                                      TextFragmentShader);
+    auto& r = renderer.getRenderer();
+    textProj = r.getUniform(textShader.get(), "proj");
+    textFontTexture = r.getUniform(textShader.get(), "fontTexture");
+    textAlignment = r.getUniform(textShader.get(), "alignment");
 }
 
-void TextRenderer::setFontTexture(font_t font, const std::string& textureName) {
-    auto fTexturePtr = renderer.getData().findSlotTexture("fonts", textureName);
-    const glm::u32vec2 textureSize = fTexturePtr->getSize();
+TextRenderer::FontMetrics TextRenderer::FontMetrics::forFont(
+    font_t font, const glm::u32vec2& textureSize) {
     glm::u8vec2 glyphOffset{textureSize.x / 16, textureSize.x / 16};
     if (font != FONT_PAGER) {
         glyphOffset.y += glyphOffset.y / 4;
@@ -168,41 +151,56 @@ void TextRenderer::setFontTexture(font_t font, const std::string& textureName) {
         monoWidth = 1 + *std::max_element(fontWidthsPager.cbegin(),
                                           fontWidthsPager.cend());
     }
-    fonts[font] = FontMetaData{
-        textureName,
-        *glyphWidths,
-        textureSize,
-        glyphOffset,
-        monoWidth
-    };
+    return {{glyphWidths->cbegin(), glyphWidths->cend()},
+            textureSize,
+            glyphOffset,
+            monoWidth};
 }
 
-void TextRenderer::renderText(const TextRenderer::TextInfo& ti,
-                              bool forceColour) {
-    if (ti.text.empty() || ti.text[0] == '*')
-        return;
+size_t TextRenderer::LayoutCache::KeyHash::operator()(const Key& key) const {
+    // FNV-1a over the characters, then the remaining fields
+    size_t hash = 14695981039346656037ull;
+    auto mix = [&hash](size_t value) {
+        hash ^= value;
+        hash *= 1099511628211ull;
+    };
+    for (auto c : key.text) {
+        mix(c);
+    }
+    mix(key.font);
+    mix(std::hash<float>()(key.size));
+    mix(static_cast<size_t>(key.wrapX));
+    mix((key.colour.r << 16u) | (key.colour.g << 8u) | key.colour.b);
+    mix(key.forceColour);
+    return hash;
+}
 
-    renderer.getRenderer().pushDebugGroup("Text");
-    renderer.getRenderer().useProgram(textShader.get());
+void TextRenderer::setFontTexture(font_t font, const std::string& textureName) {
+    auto fTexturePtr = renderer.getData().findSlotTexture("fonts", textureName);
+    fonts[font] =
+        FontMetrics::forFont(font, glm::u32vec2(fTexturePtr->getSize()));
+    fontTextures[font] = textureName;
+    // Cached layouts used the old metrics
+    layoutCache.clear();
+}
 
+void TextRenderer::layoutText(const FontMetrics& fontMetaData,
+                              const TextRenderer::TextInfo& ti,
+                              bool forceColour, TextLayout& out) {
     glm::vec2 coord(0.f, 0.f);
-    glm::vec2 alignment = ti.screenPosition;
     // We should track real size not just chars.
     auto lineLength = 0;
 
     glm::vec2 ss(ti.size);
 
     glm::vec3 colour = glm::vec3(ti.baseColour) * (1 / 255.f);
-    glm::vec4 colourBG = glm::vec4(ti.backgroundColour) * (1 / 255.f);
-    std::vector<TextVertex> geo;
+    auto& geo = out.vertices;
+    geo.clear();
 
     float maxWidth = 0.f;
     float maxHeight = ss.y;
 
     auto text = ti.text;
-
-    const auto &fontMetaData = fonts[ti.font];
-
     for (size_t i = 0; i < text.length(); ++i) {
         char16_t c = text[i];
 
@@ -316,39 +314,110 @@ void TextRenderer::renderText(const TextRenderer::TextInfo& ti,
         geo.emplace_back(glm::vec2{p.x + ss.x, p.y + ss.y}, glm::vec2{tex.z, tex.w}, colour);
     }
 
+    out.size = glm::vec2(maxWidth, maxHeight);
+    out.glyphSize = ss;
+}
+
+const TextRenderer::TextLayout& TextRenderer::LayoutCache::get(
+    const FontMetrics& font, const TextInfo& ti, bool forceColour) {
+    Key key{ti.text,  ti.font,       ti.size,
+            ti.wrapX, ti.baseColour, forceColour};
+    auto it = layouts.find(key);
+    if (it == layouts.end()) {
+        Entry entry;
+        layoutText(font, ti, forceColour, entry.layout);
+        it = layouts.emplace(std::move(key), std::move(entry)).first;
+        builds++;
+    }
+    it->second.lastUsed = ticks;
+    return it->second.layout;
+}
+
+void TextRenderer::LayoutCache::tick() {
+    ticks++;
+    if (layouts.size() <= kCapacity) {
+        return;
+    }
+    for (auto it = layouts.begin(); it != layouts.end();) {
+        if (it->second.lastUsed + kLifetime < ticks) {
+            it = layouts.erase(it);
+        } else {
+            ++it;
+        }
+    }
+}
+
+void TextRenderer::renderText(const TextRenderer::TextInfo& ti,
+                              bool forceColour) {
+    if (ti.text.empty() || ti.text[0] == '*')
+        return;
+
+    const auto& layout = layoutCache.get(fonts[ti.font], ti, forceColour);
+
+    glm::vec2 alignment = ti.screenPosition;
     if (ti.align == TextInfo::TextAlignment::Right) {
-        alignment.x -= maxWidth;
+        alignment.x -= layout.size.x;
     } else if (ti.align == TextInfo::TextAlignment::Center) {
-        alignment.x -= (maxWidth / 2.f);
+        alignment.x -= (layout.size.x / 2.f);
     }
 
     alignment.y -= ti.size * 0.2f;
 
     // If we need to, draw the background.
+    glm::vec4 colourBG = glm::vec4(ti.backgroundColour) * (1 / 255.f);
     if (colourBG.a > 0.f) {
+        const auto& ss = layout.glyphSize;
+        // drawColour flushes the text queued so far, keeping it underneath
         renderer.drawColour(
             colourBG, glm::vec4(ti.screenPosition - (ss / 3.f),
-                                glm::vec2(maxWidth, maxHeight) + (ss / 2.f)));
+                                layout.size + (ss / 2.f)));
+    }
+
+    auto& vertices = pending[ti.font];
+    for (const auto& v : layout.vertices) {
+        vertices.emplace_back(v.position + alignment, v.texcoord, v.colour);
     }
+}
 
-    renderer.getRenderer().setUniform(
-        textShader.get(), "proj", renderer.getRenderer().get2DProjection());
-    renderer.getRenderer().setUniformTexture(textShader.get(), "fontTexture", 0);
-    renderer.getRenderer().setUniform(textShader.get(), "alignment", alignment);
+void TextRenderer::flush() {
+    layoutCache.tick();
 
-    gb.uploadVertices(geo);
-    db.addGeometry(&gb);
-    db.setFaceType(GL_TRIANGLES);
+    const bool empty = std::all_of(pending.begin(), pending.end(),
+                                   [](const auto& v) { return v.empty(); });
+    if (empty) {
+        return;
+    }
 
-    Renderer::DrawParameters dp;
-    dp.start = 0;
-    dp.blendMode = BlendMode::BLEND_ALPHA;
-    dp.count = gb.getCount();
-    auto fTexturePtr = renderer.getData().findSlotTexture("fonts", fontMetaData.textureName);
-    dp.textures = {{fTexturePtr->getName()}};
-    dp.depthMode = DepthMode::OFF;
+    auto& r = renderer.getRenderer();
+    r.pushDebugGroup("Text");
+    r.useProgram(textShader.get());
+    r.setUniform(textProj, r.get2DProjection());
+    r.setUniformTexture(textFontTexture, 0);
+    // Queued vertices are already in screen space
+    r.setUniform(textAlignment, glm::vec2(0.f));
+
+    for (font_t font = 0; font < FONTS_COUNT; ++font) {
+        auto& vertices = pending[font];
+        if (vertices.empty()) {
+            continue;
+        }
 
-    renderer.getRenderer().drawArrays(glm::mat4(1.0f), &db, dp);
+        gb[font].uploadVertices(vertices);
+        db[font].addGeometry(&gb[font]);
+        db[font].setFaceType(GL_TRIANGLES);
+
+        Renderer::DrawParameters dp;
+        dp.start = 0;
+        dp.blendMode = BlendMode::BLEND_ALPHA;
+        dp.count = gb[font].getCount();
+        auto fTexturePtr =
+            renderer.getData().findSlotTexture("fonts", fontTextures[font]);
+        dp.textures = {{fTexturePtr->getName()}};
+        dp.depthMode = DepthMode::OFF;
+
+        r.drawArrays(glm::mat4(1.0f), &db[font], dp);
+        vertices.clear();
+    }
 
-    renderer.getRenderer().popDebugGroup();
+    r.popDebugGroup();
 }
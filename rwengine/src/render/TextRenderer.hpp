@@ -2,9 +2,12 @@
 #define _RWENGINE_TEXTRENDERER_HPP_
 
 #include <array>
+#include <cstddef>
+#include <cstdint>
 #include <memory>
 #include <string>
-#include <array>
+#include <unordered_map>
+#include <vector>
 
 #include <gl/DrawBuffer.hpp>
 #include <gl/GeometryBuffer.hpp>
@@ -16,8 +19,9 @@ class GameRenderer;
 /**
  * @brief Handles rendering of bitmap font textures.
  *
- * In future, strings textures might be cached to improve performance, but
- * for now, we just render each glyph on it's own quad
+ * Strings are laid out once and the glyph quads cached, so text that stays
+ * on screen is only copied into the batch for its font each frame. Queued
+ * text is drawn by flush(), with one draw per font.
  */
 class TextRenderer {
 public:
@@ -54,43 +58,160 @@ public:
         float widthFrac;
     };
 
+    /**
+     * The glyph measurements of a font, all that's needed for layout
+     */
+    struct FontMetrics {
+        std::vector<std::uint8_t> glyphWidths;
+        glm::u32vec2 textureSize{};
+        glm::u8vec2 glyphOffset{};
+        std::uint8_t monoWidth{};
+
+        /**
+         * @return The metrics of a font with a texture of the given size
+         */
+        static FontMetrics forFont(font_t font,
+                                   const glm::u32vec2& textureSize);
+    };
+
+    struct TextVertex {
+        glm::vec2 position;
+        glm::vec2 texcoord;
+        glm::vec3 colour;
+
+        TextVertex(glm::vec2 _position, glm::vec2 _texcoord,
+                   glm::vec3 _colour)
+            : position(_position), texcoord(_texcoord), colour(_colour) {
+        }
+
+        TextVertex() = default;
+
+        static const AttributeList vertex_attributes() {
+            return {
+                {ATRS_Position, 2, sizeof(TextVertex), 0ul},
+                {ATRS_TexCoord, 2, sizeof(TextVertex), 0ul + sizeof(glm::vec2)},
+                {ATRS_Colour, 3, sizeof(TextVertex), 0ul + sizeof(glm::vec2) * 2},
+            };
+        }
+    };
+
+    /**
+     * The glyph quads of a string, relative to its origin
+     */
+    struct TextLayout {
+        std::vector<TextVertex> vertices;
+        /// Width and height of the text
+        glm::vec2 size{};
+        /// Size of the last glyph, pads the background
+        glm::vec2 glyphSize{};
+    };
+
+    /**
+     * Parses the markup, wraps the words and positions the glyphs of a
+     * string. This doesn't touch GL, so it works without a context.
+     */
+    static void layoutText(const FontMetrics& font, const TextInfo& ti,
+                           bool forceColour, TextLayout& out);
+
+    /**
+     * Layouts of the strings drawn recently. Once it holds more than
+     * kCapacity layouts, those that weren't used in the last kLifetime ticks
+     * are dropped. TextRenderer ticks it on each flush.
+     */
+    class LayoutCache {
+    public:
+        static constexpr size_t kLifetime = 120;
+        static constexpr size_t kCapacity = 512;
+
+        /**
+         * @return The layout of the string, laid out if it isn't cached.
+         * Valid until the next call to tick() or clear()
+         */
+        const TextLayout& get(const FontMetrics& font, const TextInfo& ti,
+                              bool forceColour);
+
+        void tick();
+
+        void clear() {
+            layouts.clear();
+        }
+
+        size_t size() const {
+            return layouts.size();
+        }
+
+        /// Strings laid out, rather than found in the cache
+        size_t getBuildCount() const {
+            return builds;
+        }
+
+    private:
+        struct Key {
+            GameString text;
+            font_t font;
+            float size;
+            int wrapX;
+            glm::u8vec3 colour;
+            bool forceColour;
+
+            bool operator==(const Key& o) const {
+                return text == o.text && font == o.font && size == o.size &&
+                       wrapX == o.wrapX && colour == o.colour &&
+                       forceColour == o.forceColour;
+            }
+        };
+
+        struct KeyHash {
+            size_t operator()(const Key& key) const;
+        };
+
+        struct Entry {
+            TextLayout layout;
+            /// Value of ticks when the layout was last used
+            size_t lastUsed;
+        };
+
+        std::unordered_map<Key, Entry, KeyHash> layouts;
+        size_t ticks = 0;
+        size_t builds = 0;
+    };
+
     TextRenderer(GameRenderer& renderer);
     ~TextRenderer() = default;
 
     void setFontTexture(font_t font, const std::string& textureName);
 
+    /**
+     * Queues text to be drawn on the next flush. Text with a background
+     * flushes first, so it stays above anything queued before it.
+     */
     void renderText(const TextInfo& ti, bool forceColour = false);
 
+    /**
+     * Draws the queued text, with one draw for each font
+     */
+    void flush();
+
+    size_t getCachedLayoutCount() const {
+        return layoutCache.size();
+    }
+
 private:
-    class FontMetaData {
-    public:
-        FontMetaData() = default;
-        template<size_t N>
-        FontMetaData(const std::string &textureName,
-                     const std::array<std::uint8_t, N> &glyphWidths,
-                     const glm::u32vec2 &textureSize,
-                     const glm::u8vec2 &glyphOffset,
-                     const std::uint8_t monoWidth)
-            : textureName(textureName)
-            , glyphWidths(glyphWidths.cbegin(), glyphWidths.cend())
-            , textureSize(textureSize)
-            , glyphOffset(glyphOffset)
-            , monoWidth(monoWidth)
-        {
-        }
-        std::string textureName;
-        std::vector<std::uint8_t> glyphWidths;
-        glm::u32vec2 textureSize;
-        glm::u8vec2 glyphOffset;
-        std::uint8_t monoWidth;
-    };
+    std::array<FontMetrics, FONTS_COUNT> fonts;
+    std::array<std::string, FONTS_COUNT> fontTextures;
+
+    LayoutCache layoutCache;
 
-    std::array<FontMetaData, FONTS_COUNT> fonts;
+    /// Vertices waiting for flush, for each font
+    std::array<std::vector<TextVertex>, FONTS_COUNT> pending;
 
     GameRenderer& renderer;
     std::unique_ptr<Renderer::ShaderProgram> textShader;
+    Renderer::Uniform textProj;
+    Renderer::Uniform textFontTexture;
+    Renderer::Uniform textAlignment;
 
-    GeometryBuffer gb;
-    DrawBuffer db;
+    std::array<GeometryBuffer, FONTS_COUNT> gb;
+    std::array<DrawBuffer, FONTS_COUNT> db;
 };
 #endif
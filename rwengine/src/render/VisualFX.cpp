@@ -1 +1,49 @@
 #include "render/VisualFX.hpp"
+
+#include <algorithm>
+
+ParticleFX& ParticlePool::create() {
+    if (freeSlots.empty()) {
+        blocks.push_back(std::make_unique<ParticleFX[]>(kBlockSize));
+        auto block = blocks.back().get();
+        // Reversed, so slots are handed out in memory order
+        for (size_t i = kBlockSize; i > 0; --i) {
+            freeSlots.push_back(&block[i - 1]);
+        }
+    }
+
+    auto particle = freeSlots.back();
+    freeSlots.pop_back();
+    *particle = ParticleFX();
+    live.push_back(particle);
+    return *particle;
+}
+
+void ParticlePool::destroy(ParticleFX& particle) {
+    auto it = std::find(live.begin(), live.end(), &particle);
+    if (it != live.end()) {
+        live.erase(it);
+        freeSlots.push_back(&particle);
+    }
+}
+
+size_t ParticlePool::removeExpired(float gameTime) {
+    // Compact the live list in a single pass
+    size_t kept = 0;
+    for (auto particle : live) {
+        if (particle->hasExpired(gameTime)) {
+            freeSlots.push_back(particle);
+        } else {
+            live[kept++] = particle;
+        }
+    }
+    const auto removed = live.size() - kept;
+    live.resize(kept);
+    return removed;
+}
+
+void ParticlePool::clear() {
+    live.clear();
+    freeSlots.clear();
+    blocks.clear();
+}
@@ -7,6 +7,10 @@
 
 #include <gl/TextureData.hpp>
 
+#include <cstddef>
+#include <memory>
+#include <vector>
+
 enum EffectType { Light, Particle, Trail };
 
 /**
@@ -68,6 +72,44 @@ struct ParticleFX final : public VisualFX {
     EffectType getType() const override {
         return Particle;
     }
+
+    bool hasExpired(float gameTime) const {
+        return lifetime >= 0.f && gameTime >= starttime + lifetime;
+    }
+};
+
+/**
+ * Stores particles in fixed size blocks so references to them stay valid,
+ * and keeps the live ones in a packed list for updating and rendering.
+ * Slots of destroyed particles are reused by new ones.
+ */
+class ParticlePool {
+public:
+    ParticleFX& create();
+
+    void destroy(ParticleFX& particle);
+
+    /**
+     * Destroys every particle whose lifetime has run out
+     * @return The number of particles removed
+     */
+    size_t removeExpired(float gameTime);
+
+    void clear();
+
+    /**
+     * @return The live particles, in creation order
+     */
+    const std::vector<ParticleFX*>& getParticles() const {
+        return live;
+    }
+
+private:
+    static constexpr size_t kBlockSize = 256;
+
+    std::vector<std::unique_ptr<ParticleFX[]>> blocks;
+    std::vector<ParticleFX*> freeSlots;
+    std::vector<ParticleFX*> live;
 };
 
 struct TrailFX final : public VisualFX {
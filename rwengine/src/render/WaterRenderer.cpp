@@ -27,6 +27,11 @@ WaterRenderer::WaterRenderer(GameRenderer &renderer) {
     renderer.getRenderer().setProgramBlockBinding(maskProg.get(), "SceneData", 1);
 
     renderer.getRenderer().setUniformTexture(waterProg.get(), "data", 1);
+    waterTime = renderer.getRenderer().getUniform(waterProg.get(), "time");
+    waterWaveParams =
+        renderer.getRenderer().getUniform(waterProg.get(), "waveParams");
+    waterInverseVP =
+        renderer.getRenderer().getUniform(waterProg.get(), "inverseVP");
 
     // Generate grid mesh
     int gridres = 60;
@@ -139,12 +144,11 @@ void WaterRenderer::render(GameRenderer &renderer, GameWorld* world) {
     buffers[0] = GL_COLOR_ATTACHMENT0;
     glDrawBuffers(1, buffers);
 
-    r.setUniform(waterProg.get(), "time", world->getGameTime());
-    r.setUniform(waterProg.get(), "waveParams",
-                  glm::vec2(WATER_SCALE, WATER_HEIGHT));
+    r.setUniform(waterTime, world->getGameTime());
+    r.setUniform(waterWaveParams, glm::vec2(WATER_SCALE, WATER_HEIGHT));
     auto ivp =
         glm::inverse(r.getSceneData().projection * r.getSceneData().view);
-    r.setUniform(waterProg.get(), "inverseVP", ivp);
+    r.setUniform(waterInverseVP, ivp);
 
     wdp.count = gridGeom.getCount();
     wdp.textures = {{waterTexPtr->getName(), dataTexture}};
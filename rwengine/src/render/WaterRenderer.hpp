@@ -42,6 +42,9 @@ public:
 private:
     std::unique_ptr<Renderer::ShaderProgram> waterProg = nullptr;
     std::unique_ptr<Renderer::ShaderProgram> maskProg = nullptr;
+    Renderer::Uniform waterTime;
+    Renderer::Uniform waterWaveParams;
+    Renderer::Uniform waterInverseVP;
 
     DrawBuffer maskDraw{};
     GeometryBuffer maskGeom{};
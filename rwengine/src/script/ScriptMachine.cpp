@@ -86,9 +86,8 @@ void ScriptMachine::executeThread(SCMThread& t, int msPassed) {
                         globalData.data() + v;  //* SCM_VARIABLE_SIZE;
                     if (v >= file.getGlobalsSize()) {
                         state->world->logger->error(
-                            "SCM", "Global Out of bounds! " +
-                                       std::to_string(v) + " " +
-                                       std::to_string(file.getGlobalsSize()));
+                            "SCM", "Global Out of bounds! ", v, " ",
+                            file.getGlobalsSize());
                     }
                     pc += sizeof(SCMByte) * 2;
                 } break;
@@ -5,6 +5,8 @@
 
 #include <rw/debug.hpp>
 
+#include "core/FrameArena.hpp"
+
 #include <glm/gtc/type_precision.hpp>
 #include <glm/vec2.hpp>
 #include <glm/vec3.hpp>
@@ -238,7 +240,8 @@ struct SCMOpcodeParameter {
     }
 };
 
-typedef std::vector<SCMOpcodeParameter> SCMParams;
+/// Read for each instruction, so they live in the frame arena
+typedef FrameVector<SCMOpcodeParameter> SCMParams;
 
 class ScriptArguments {
     const SCMParams* parameters;
@@ -6488,18 +6488,15 @@ void opcode_023c(const ScriptArguments& args, const ScriptInt arg1, const Script
     @arg arg1 
 */
 bool opcode_023d(const ScriptArguments& args, const ScriptInt arg1) {
-    /// @todo re-implement this when streaming is added
-    return true;
-    RW_UNUSED(args);
-    RW_UNUSED(arg1);
-#if 0
-    auto model = args.getState()->specialCharacters[arg1];
-    auto modelfind = args.getWorld()->data->models.find(model);
-    if( modelfind != args.getWorld()->data->models.end() && modelfind->second->resource != nullptr ) {
-    	return true;
+    // Special actors are read in the background by load_special_actor
+    const auto& specials = args.getState()->specialCharacters;
+    auto it = specials.find(static_cast<unsigned short>(arg1));
+    if (it == specials.end()) {
+        return true;
     }
-    return false;
-#endif
+    auto data = args.getWorld()->data;
+    return data->isFileReady(it->second + ".dff") &&
+           data->isFileReady(it->second + ".txd");
 }
 
 /**
@@ -7890,17 +7887,12 @@ void opcode_02e6(const ScriptArguments& args, const ScriptObject object,
     RW_UNUSED(object);
     RW_UNUSED(arg2);
     /// @todo make animation data-driven rather than oop
-    auto cutscene = args.getObject<CutsceneObject>(0);
+    auto cutscene =
+        static_cast<CutsceneObject*>(args.getObject<CutsceneObject>(0));
     std::string animName = arg2;
     std::transform(animName.begin(), animName.end(), animName.begin(),
                    ::tolower);
-    auto anim = args.getWorld()->data->animationsCutscene.at(animName);
-    if (anim) {
-        cutscene->animator->playAnimation(AnimIndexMovement, anim, 1.f, false);
-    } else {
-        args.getWorld()->logger->error(
-            "SCM", "Failed to load cutscene anim: " + animName);
-    }
+    args.getWorld()->setCutsceneAnimation(cutscene, animName);
 }
 
 /**
@@ -8108,7 +8100,7 @@ void opcode_02f5(const ScriptArguments& args, const ScriptObject object, const S
     	head->animator->playAnimation(AnimIndexMovement, anim, 1.f, false);
     }
     else {
-    	args.getWorld()->logger->error("SCM", "Failed to load cutscene anim: " + animName);
+    	args.getWorld()->logger->error("SCM", "Failed to load cutscene anim: ", animName);
     }
 }
 
@@ -9625,21 +9617,15 @@ void opcode_0362(const ScriptArguments& args, const ScriptCharacter character,
     @arg visible Boolean true/false
 */
 void opcode_0363(const ScriptArguments& args, ScriptVec3 coord, const ScriptFloat radius, const ScriptModel model, const ScriptBoolean visible) {
-    auto& models = args.getVM()->getFile().getModels();
-    auto& modelName = models[-model];
+    std::vector<InstanceObject*> candidates;
+    args.getWorld()->modelInstances.findNear(script::getModel(args, model),
+                                             glm::vec2(coord), radius,
+                                             candidates);
 
     // Attempt to find the closest object
     InstanceObject* closestObject = nullptr;
     float closestDistance = radius;
-    for(auto& i : args.getWorld()->instancePool.objects) {
-        InstanceObject* object = static_cast<InstanceObject*>(i.second.get());
-
-    	// Check if this instance has the correct model id, early out if it isn't
-    	auto modelinfo = object->getModelInfo<BaseModelInfo>();
-    	if (!boost::iequals(modelinfo->name, modelName)) {
-    		continue;
-    	}
-
+    for(auto object : candidates) {
     	// Calculate distance and check if this is the new closest object
     	// @todo will this somehow respect the objects centre of mass / bounding box or something?
     	float distance = glm::length(object->position - coord);
@@ -10405,7 +10391,7 @@ void opcode_0394(const ScriptArguments& args, const ScriptInt arg1) {
     // TODO play anything other than Miscom.wav
     if (! gw->data->loadAudioClip( name, name + ".wav" ))
     {
-    	args.getWorld()->logger->error("SCM", "Error loading audio " + name);
+    	args.getWorld()->logger->error("SCM", "Error loading audio ", name);
     	return;
     }
     else if (args.getWorld()->missionAudio.length() > 0)
@@ -10897,14 +10883,16 @@ void opcode_03b6(const ScriptArguments& args, ScriptVec3 coord, const ScriptFloa
 
     auto newobjectid = args.getWorld()->data->findModelObject(newmodel);
     auto nobj = args.getWorld()->data->findModelInfo<SimpleModelInfo>(newobjectid);
-
-    for(auto& p : args.getWorld()->instancePool.objects) {
-        auto o = p.second.get();
-    	if( !o->getClump() ) continue;
-    	if( o->getModelInfo<BaseModelInfo>()->name != oldmodel ) continue;
-    	float d = glm::distance(coord, o->getPosition());
+    auto oldobjectid = args.getWorld()->data->findModelObject(oldmodel);
+
+    // Changing the model moves the instance to another list, so copy it
+    std::vector<InstanceObject*> candidates;
+    args.getWorld()->modelInstances.findNear(oldobjectid, glm::vec2(coord),
+                                             radius, candidates);
+    for(auto inst : candidates) {
+    	if( !inst->getClump() ) continue;
+    	float d = glm::distance(coord, inst->getPosition());
     	if( d < radius ) {
-    		InstanceObject* inst = static_cast<InstanceObject*>(o);
     		inst->changeModel(nobj);
     	}
     }
@@ -11233,7 +11221,7 @@ void opcode_03cf(const ScriptArguments& args, const ScriptString soundID) {
     std::transform(name.begin(), name.end(), name.begin(), ::tolower);
     if (! args.getWorld()->data->loadAudioClip(name, name + ".wav")) {
     	if (! args.getWorld()->data->loadAudioClip(name, name + ".mp3")) {
-    		args.getWorld()->logger->error("SCM", "Failed to load audio: " + name);
+    		args.getWorld()->logger->error("SCM", "Failed to load audio: ", name);
     	}
     }
 }
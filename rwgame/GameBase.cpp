@@ -15,7 +15,7 @@ const std::string kWindowTitle = "RWGame";
 GameBase::GameBase(Logger &inlog, const std::optional<RWArgConfigLayer> &args) :
         log(inlog),
         config(buildConfig(args)) {
-    log.info("Game", "Build: " + kBuildStr);
+    log.info("Game", "Build: ", kBuildStr);
 
     bool fullscreen = config.fullscreen();
     size_t w = config.width(), h = config.height();
@@ -49,7 +49,7 @@ RWConfig GameBase::buildConfig(const std::optional<RWArgConfigLayer> &args) {
         auto [configLayer, parseResult] = configParser.loadFile(configPath);
 
         if (!parseResult.isValid()) {
-            log.error("Config", "Could not read configuation file at " + configPath.string());
+            log.error("Config", "Could not read configuation file at ", configPath.string());
             throw std::runtime_error(parseResult.what());
         }
         config.unknown = parseResult.getUnknownData();
@@ -66,7 +66,7 @@ RWConfig GameBase::buildConfig(const std::optional<RWArgConfigLayer> &args) {
         defaultLayer.gamedataPath = "/path/to/gta3/data";
         RWConfigParser configParser{};
         auto [default_ini_string, parseResult] = configParser.layerToString(defaultLayer);
-        log.error("Config", "Configuration is incomplete. INI file at \"" + configPath.string() + "\"");
+        log.error("Config", "Configuration is incomplete. INI file at \"", configPath.string(), "\"");
         if (parseResult.isValid()) {
             log.error("Config", "Adapt the following default INI to your configuration.");
             log.error("Config", default_ini_string);
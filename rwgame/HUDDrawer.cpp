@@ -70,6 +70,8 @@ void HUDDrawer::drawMap(ViewCamera& currentView, ai::PlayerController* player,
         map.screenPosition = (mapTop + mapBottom) / 2.f;
         map.screenSize = hudParameters.uiMapSize * 0.95f;
 
+        // Text queued so far belongs underneath the map
+        render.text.flush();
         render.map.draw(world, map);
     }
 }
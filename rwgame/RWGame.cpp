@@ -11,7 +11,10 @@
 #include "states/LoadingState.hpp"
 #include "states/MenuState.hpp"
 
+#include <core/FrameArena.hpp>
+#include <core/HeapCounter.hpp>
 #include <core/Profiler.hpp>
+#include <core/Telemetry.hpp>
 
 #include <engine/Payphone.hpp>
 #include <engine/SaveGame.hpp>
@@ -26,6 +29,8 @@
 #include <objects/VehicleObject.hpp>
 
 #include <boost/algorithm/string/predicate.hpp>
+#include <chrono>
+#include <fstream>
 #include <functional>
 #include <iomanip>
 #include <iostream>
@@ -47,6 +52,12 @@ static constexpr std::array<
                     {GameRenderer::Arrow, "arrow.dff", ""}}};
 
 constexpr float kMaxPhysicsSubSteps = 2;
+
+/// Linked shaders are kept next to the configuration
+rwfs::path getShaderCacheDirectory() {
+    const auto configPath = RWConfigParser::getDefaultConfigPath();
+    return configPath.empty() ? configPath : configPath / "shaders";
+}
 }  // namespace
 
 #define MOUSE_SENSITIVITY_SCALE 2.5f
@@ -54,7 +65,7 @@ constexpr float kMaxPhysicsSubSteps = 2;
 RWGame::RWGame(Logger& log, const std::optional<RWArgConfigLayer> &args)
     : GameBase(log, args)
     , data(&log, config.gamedataPath())
-    , renderer(&log, &data)
+    , renderer(&log, &data, getShaderCacheDirectory())
     , imgui(*this) {
     RW_PROFILE_THREAD("Main");
     RW_TIMELINE_ENTER("Startup", MP_YELLOW);
@@ -70,7 +81,7 @@ RWGame::RWGame(Logger& log, const std::optional<RWArgConfigLayer> &args)
         benchFile = args->benchmarkPath;
     }
 
-    log.info("Game", "Game directory: " + config.gamedataPath());
+    log.info("Game", "Game directory: ", config.gamedataPath());
 
     if (!GameData::isValidGameDirectory(config.gamedataPath())) {
         throw std::runtime_error("Invalid game directory path: " +
@@ -79,6 +90,12 @@ RWGame::RWGame(Logger& log, const std::optional<RWArgConfigLayer> &args)
 
     imgui.init();
 
+    if (!config.textureCachePath().empty()) {
+        log.info("Game", "Texture cache: ", config.textureCachePath());
+        data.textureLoader.setCache(
+            std::make_unique<TextureCache>(config.textureCachePath()));
+    }
+
     data.load();
 
     for (const auto& [specialModel, fileName, name] : kSpecialModels) {
@@ -112,6 +129,7 @@ RWGame::RWGame(Logger& log, const std::optional<RWArgConfigLayer> &args)
         oss << "radar" << std::setw(2) << std::setfill('0') << m << ".txd";
         data.loadTXD(oss.str());
     }
+    getRenderer().map.loadRadarAtlas();
 
     stateManager.enter<LoadingState>(this, [=]() {
         if (benchFile.has_value()) {
@@ -138,10 +156,13 @@ RWGame::~RWGame() {
 void RWGame::newGame() {
     // Get a fresh state
     state = GameState();
+    missionSnapshot.clear();
+    wasOnMission = false;
 
     // Destroy the current world and start over
-    world = std::make_unique<GameWorld>(&log, &data);
+    world = std::make_unique<GameWorld>(&log, &data, config.threadedPhysics());
     world->dynamicsWorld->setDebugDrawer(&debug);
+    world->simulationLODDistance = config.simulationLODDistance();
 
     // Associate the new world with the new state and vice versa
     state.world = world.get();
@@ -190,7 +211,7 @@ void RWGame::saveGame(const std::string& savename) {
 void RWGame::loadGame(const std::string& savename) {
     delete state.script;
 
-    log.info("Game", "Loading game " + savename);
+    log.info("Game", "Loading game ", savename);
 
     newGame();
 
@@ -204,13 +225,24 @@ void RWGame::loadGame(const std::string& savename) {
     state.world->data->loadSplash("SPLASH1");
 }
 
+bool RWGame::retryMission() {
+    const auto start = std::chrono::steady_clock::now();
+    if (!missionSnapshot.restore(state)) {
+        return false;
+    }
+    const auto time = std::chrono::duration<double, std::milli>(
+        std::chrono::steady_clock::now() - start);
+    log.info("Game", "Restored mission start in ", time.count(), " ms");
+    return true;
+}
+
 void RWGame::startScript(const std::string& name) {
     script = data.loadSCM(name);
     if (script) {
         vm = std::make_unique<ScriptMachine>(&state, script, &opcodes);
         state.script = vm.get();
     } else {
-        log.error("Game", "Failed to load SCM: " + name);
+        log.error("Game", "Failed to load SCM: ", name);
     }
 }
 
@@ -228,7 +260,7 @@ void RWGame::handleCheatInput(char symbol) {
         RW_CHECK(cheatInputWindow.length() >= cheat.length(), "Cheat too long");
         size_t offset = cheatInputWindow.length() - cheat.length();
         if (cheat == cheatInputWindow.substr(offset)) {
-            log.info("Game", "Cheat triggered: '" + cheat + "'");
+            log.info("Game", "Cheat triggered: '", cheat, "'");
             if (action) {
                 action();
             }
@@ -414,12 +446,14 @@ int RWGame::run() {
     auto lastFrame = chrono::steady_clock::now();
     const float deltaTime = GAME_TIMESTEP;
     float accumulatedTime = 0.0f;
+    size_t heapAllocations = HeapCounter::getAllocationCount();
 
     // Loop until we run out of states.
     bool running = true;
     while (stateManager.currentState() && running) {
         RW_PROFILE_FRAME_BOUNDARY();
         RW_PROFILE_SCOPE("Main Loop");
+        Telemetry::get().beginFrame();
 
         running = updateInput();
 
@@ -445,6 +479,16 @@ int RWGame::run() {
 
         // Make sure the topmost state is the correct state
         stateManager.updateStack();
+
+        // Everything from the frame arena has been freed by now
+        auto& arena = FrameArena::forThread();
+        RW_TELEMETRY_COUNTER_SET(FrameAllocations, arena.getAllocationCount());
+        arena.reset();
+
+        const auto totalAllocations = HeapCounter::getAllocationCount();
+        RW_TELEMETRY_COUNTER_SET(HeapAllocations,
+                                 totalAllocations - heapAllocations);
+        heapAllocations = totalAllocations;
     }
 
     stateManager.clear();
@@ -464,6 +508,7 @@ float RWGame::tickWorld(const float deltaTime, float accumulatedTime) {
 
         {
             RW_PROFILE_SCOPEC("stepSimulation", MP_DARKORANGE1);
+            RW_TELEMETRY_SCOPE(Physics);
             world->dynamicsWorld->stepSimulation(
                     deltaTimeWithTimeScale, kMaxPhysicsSubSteps, deltaTime);
         }
@@ -575,11 +620,26 @@ void RWGame::tick(float dt) {
             }
         }
 
+        // Picks up the files of a loading cutscene once they have been read
+        world->finishLoadingCutscene();
+
         tickObjects(dt);
 
         state.text.tick(dt);
 
         if (vm) {
+            RW_TELEMETRY_SCOPE(Script);
+
+            // Go back to the start of the mission before the script sees
+            // that it has been failed
+            auto player = world->getPlayer();
+            if (config.retryMissions() && wasOnMission && player &&
+                (player->isWasted() || player->isBusted()) &&
+                retryMission()) {
+                state.setFadeColour(glm::i32vec3(0x00, 0x00, 0x00));
+                state.fade(1.f, true);
+            }
+
             try {
                 vm->execute(dt);
             } catch (SCMException& ex) {
@@ -587,6 +647,15 @@ void RWGame::tick(float dt) {
                 log.error("Script", ex.what());
                 throw;
             }
+
+            // Capture the world between frames as a mission starts, so that
+            // retrying it is consistent with the script
+            const bool onMission =
+                state.scriptOnMissionFlag && *state.scriptOnMissionFlag != 0;
+            if (onMission && !wasOnMission) {
+                missionSnapshot.capture(state);
+            }
+            wasOnMission = onMission;
         }
 
         /// @todo this doesn't make sense as the condition
@@ -595,6 +664,7 @@ void RWGame::tick(float dt) {
                                       currentCam.getView());
             // Use the current camera position to spawn pedestrians.
             world->cleanupTraffic(currentCam);
+            world->updateSimulationLOD(currentCam);
             // Only create new traffic outside cutscenes
             if (!state.currentCutscene) {
                 world->createTraffic(currentCam);
@@ -608,11 +678,10 @@ void RWGame::tickObjects(float dt) const {
     world->updateEffects();
 
     {
-        RW_PROFILE_SCOPEC("allObjects", MP_HOTPINK1);
+        RW_PROFILE_SCOPEC("objects", MP_HOTPINK1);
         RW_PROFILE_COUNTER_SET("tickObjects/allObjects", world->allObjects.size());
-        for (auto &object : world->allObjects) {
-            object->tick(dt);
-        }
+        RW_TELEMETRY_COUNTER_SET(Objects, world->allObjects.size());
+        world->tickObjects(dt);
     }
 
     {
@@ -629,11 +698,14 @@ void RWGame::tickObjects(float dt) const {
         }
     }
 
+    world->applyAreaDamage();
+
     world->destroyQueuedObjects();
 }
 
 void RWGame::render(float alpha, float time) {
     RW_PROFILE_SCOPEC(__func__, MP_CORNFLOWERBLUE);
+    RW_TELEMETRY_SCOPE(Draw);
     RW_UNUSED(time);
 
     lastDraws = getRenderer().getRenderer().getDrawCount();
@@ -658,7 +730,10 @@ void RWGame::render(float alpha, float time) {
         viewCam.frustum.fov *= viewCam.frustum.aspectRatio;
     }
 
-    world->sound.updateListenerTransform(viewCam);
+    {
+        RW_TELEMETRY_SCOPE(Audio);
+        world->sound.updateListenerTransform(viewCam);
+    }
 
     glEnable(GL_DEPTH_TEST);
     glClear(GL_DEPTH_BUFFER_BIT | GL_COLOR_BUFFER_BIT);
@@ -678,7 +753,15 @@ void RWGame::render(float alpha, float time) {
         stateManager.draw(renderer);
     }
 
+    renderer.text.flush();
+
     imgui.endFrame(viewCam);
+
+    auto& r = renderer.getRenderer();
+    RW_TELEMETRY_COUNTER_SET(Draws, r.getDrawCount());
+    RW_TELEMETRY_COUNTER_SET(Instances, r.getInstanceCount());
+    RW_TELEMETRY_COUNTER_SET(Culled, renderer.getCulledCount());
+    RW_TELEMETRY_COUNTER_SET(Occluded, renderer.getOccludedCount());
 }
 
 void RWGame::renderDebugView() {
@@ -800,6 +883,22 @@ void RWGame::renderDebugPaths() {
     debug.flush(renderer);
 }
 
+void RWGame::dumpTelemetry() {
+    const auto& telemetry = Telemetry::get();
+
+    std::ofstream csv("telemetry.csv");
+    telemetry.writeCSV(csv);
+    std::ofstream trace("telemetry.json");
+    telemetry.writeChromeTrace(trace);
+
+    if (!csv || !trace) {
+        log.error("Game", "Failed to write telemetry");
+        return;
+    }
+    log.info("Game", "Wrote ", telemetry.getFrameCount(),
+             " frames of telemetry");
+}
+
 void RWGame::globalKeyEvent(const SDL_Event& event) {
     const auto toggle_debug = [&](DebugViewMode m) {
         debugview_ = debugview_ == m ? DebugViewMode::Disabled : m;
@@ -830,6 +929,12 @@ void RWGame::globalKeyEvent(const SDL_Event& event) {
         case SDLK_F4:
             toggle_debug(DebugViewMode::Objects);
             break;
+        case SDLK_F5:
+            toggle_debug(DebugViewMode::Telemetry);
+            break;
+        case SDLK_F6:
+            dumpTelemetry();
+            break;
         default:
             break;
     }
@@ -11,6 +11,7 @@
 #include <engine/GameData.hpp>
 #include <engine/GameState.hpp>
 #include <engine/GameWorld.hpp>
+#include <engine/WorldSnapshot.hpp>
 #include <render/DebugDraw.hpp>
 #include <render/GameRenderer.hpp>
 #include <script/SCMFile.hpp>
@@ -28,7 +29,8 @@ public:
         General,
         Physics,
         Navigation,
-        Objects
+        Objects,
+        Telemetry
     };
 
 private:
@@ -45,6 +47,10 @@ private:
     std::unique_ptr<ScriptMachine> vm;
     SCMFile script;
 
+    /// Taken when the script goes on a mission, see retryMission
+    WorldSnapshot missionSnapshot;
+    bool wasOnMission = false;
+
     StateManager stateManager;
 
     bool inFocus = true;
@@ -98,6 +104,12 @@ public:
         return debugview_;
     }
 
+    /**
+     * Writes the recorded frame telemetry to telemetry.csv and to
+     * telemetry.json as a Chrome trace, in the working directory
+     */
+    void dumpTelemetry();
+
     bool hitWorldRay(glm::vec3& hit, glm::vec3& normal,
                      GameObject** object = nullptr);
 
@@ -114,6 +126,18 @@ public:
     void saveGame(const std::string& savename);
     void loadGame(const std::string& savename);
 
+    /**
+     * Returns the game to the moment the last mission started, without
+     * reloading the world or the script
+     *
+     * @return false if no mission has been started
+     */
+    bool retryMission();
+
+    bool canRetryMission() const {
+        return missionSnapshot.isCaptured();
+    }
+
 private:
     void tick(float dt);
     void render(float alpha, float dt);
@@ -1,6 +1,7 @@
 #include "RWImGui.hpp"
 
 #include <ai/CharacterController.hpp>
+#include <core/Telemetry.hpp>
 #include <objects/CharacterObject.hpp>
 #include <objects/VehicleObject.hpp>
 
@@ -15,6 +16,9 @@
 #include <gl/gl_core_3_3.h>
 #include <glm/gtx/norm.hpp>
 
+#include <array>
+#include <cstdint>
+
 namespace {
 void WindowDebugStats(RWGame& game) {
     auto& io = ImGui::GetIO();
@@ -53,11 +57,17 @@ void WindowDebugStats(RWGame& game) {
                 time_max);
     ImGui::Text("Timescale %.2f",
                 static_cast<double>(world->state->basic.timeScale));
-    ImGui::Text("%i Drawn %lu Culled", renderer.getRenderer().getDrawCount(),
-                renderer.getCulledCount());
-    ImGui::Text("%i Textures %i Buffers",
+    ImGui::Text("%i Drawn (%i Instances) %lu Culled (%lu Occluded)",
+                renderer.getRenderer().getDrawCount(),
+                renderer.getRenderer().getInstanceCount(),
+                renderer.getCulledCount(), renderer.getOccludedCount());
+    ImGui::Text("%i Textures %i Buffers %i Uploads",
                 renderer.getRenderer().getTextureCount(),
-                renderer.getRenderer().getBufferCount());
+                renderer.getRenderer().getBufferCount(),
+                renderer.getRenderer().getUploadCount());
+    ImGui::Text("%zu / %zu Instances physics active",
+                world->physicsInstances.size(),
+                world->instancePool.objects.size());
     ImGui::End();
 }
 
@@ -128,6 +138,79 @@ void WindowDebugObjects(RWGame& game, const ViewCamera& camera) {
         showdata(c, ss);
     }
 }
+
+void WindowTelemetry(RWGame& game) {
+    const auto& telemetry = Telemetry::get();
+    const auto frameCount = telemetry.getFrameCount();
+    const auto toMs = [](std::int64_t ns) {
+        return static_cast<float>(static_cast<double>(ns) / 1000000.0);
+    };
+
+    ImGui::SetNextWindowPos({20.f, 20.f}, ImGuiCond_FirstUseEver);
+    ImGui::Begin("Telemetry", nullptr,
+                 ImGuiWindowFlags_AlwaysAutoResize |
+                     ImGuiWindowFlags_NoSavedSettings);
+    if (frameCount == 0) {
+        ImGui::Text("No frames recorded");
+        ImGui::End();
+        return;
+    }
+
+    // Oldest first, so the graph scrolls to the left
+    static std::array<float, Telemetry::kFrameCapacity> frameTimes;
+    float maxFrameTime = 0.f;
+    for (size_t i = 0; i < frameCount; ++i) {
+        frameTimes[i] = toMs(telemetry.getFrame(frameCount - 1 - i).duration);
+        maxFrameTime = std::max(maxFrameTime, frameTimes[i]);
+    }
+    ImGui::PlotLines("##frames", frameTimes.data(),
+                     static_cast<int>(frameCount), 0, "Frame ms", 0.f,
+                     maxFrameTime, {480.f, 80.f});
+
+    ImGui::Columns(4, "scopes");
+    ImGui::Text("Scope");
+    ImGui::NextColumn();
+    ImGui::Text("Last ms");
+    ImGui::NextColumn();
+    ImGui::Text("Average ms");
+    ImGui::NextColumn();
+    ImGui::Text("Max ms");
+    ImGui::NextColumn();
+    ImGui::Separator();
+    for (size_t s = 0; s < Telemetry::ScopeCount; ++s) {
+        float total = 0.f;
+        float max = 0.f;
+        for (size_t i = 0; i < frameCount; ++i) {
+            const auto time = toMs(telemetry.getFrame(i).scopeTime[s]);
+            total += time;
+            max = std::max(max, time);
+        }
+        ImGui::Text("%s", Telemetry::getScopeName(static_cast<Telemetry::Scope>(s)));
+        ImGui::NextColumn();
+        ImGui::Text("%.3f", static_cast<double>(
+                                toMs(telemetry.getFrame(0).scopeTime[s])));
+        ImGui::NextColumn();
+        ImGui::Text("%.3f", static_cast<double>(
+                                total / static_cast<float>(frameCount)));
+        ImGui::NextColumn();
+        ImGui::Text("%.3f", static_cast<double>(max));
+        ImGui::NextColumn();
+    }
+    ImGui::Columns(1);
+    ImGui::Separator();
+
+    for (size_t c = 0; c < Telemetry::CounterCount; ++c) {
+        ImGui::Text("%s: %lld",
+                    Telemetry::getCounterName(static_cast<Telemetry::Counter>(c)),
+                    static_cast<long long>(
+                        telemetry.getFrame(0).counters[c]));
+    }
+
+    if (ImGui::Button("Dump CSV and trace (F6)")) {
+        game.dumpTelemetry();
+    }
+    ImGui::End();
+}
 }  // namespace
 
 RWImGui::RWImGui(RWGame &game)
@@ -190,6 +273,9 @@ void RWImGui::endFrame(const ViewCamera& camera) {
         case RWGame::DebugViewMode::Objects:
             WindowDebugObjects(_game, camera);
             break;
+        case RWGame::DebugViewMode::Telemetry:
+            WindowTelemetry(_game);
+            break;
         default:
             break;
     }
@@ -40,6 +40,7 @@ int main(int argc, const char* argv[]) {
         static constexpr char const* kErrorTitle = "Fatal Error";
 
         logger.error("exception", ex.what());
+        logger.flush();
 
         if (SDL_ShowSimpleMessageBox(SDL_MESSAGEBOX_ERROR, kErrorTitle,
                                      ex.what(), nullptr) < 0) {
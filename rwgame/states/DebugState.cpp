@@ -71,6 +71,12 @@ void DebugState::drawDebugMenu() {
             game->getRenderer().setCullOverride(true, _debugCam);
         }
 
+        auto& renderer = game->getRenderer();
+        if (ImGui::MenuItem("Occlusion Culling", nullptr,
+                            renderer.isOcclusionCulling())) {
+            renderer.setOcclusionCulling(!renderer.isOcclusionCulling());
+        }
+
         ImGui::EndMenu();
     }
 
@@ -246,6 +252,12 @@ void DebugState::drawWeatherMenu() {
 }
 
 void DebugState::drawMissionsMenu() {
+    if (ImGui::MenuItem("Retry Mission", nullptr, false,
+                        game->canRetryMission())) {
+        game->retryMission();
+    }
+    ImGui::Separator();
+
     static constexpr std::array<char const*, 80> w{{
         "Intro Movie",
         "Hospital Info Scene",
@@ -44,4 +44,33 @@ BOOST_AUTO_TEST_CASE(test_matrix) {
     }
 }
 
+BOOST_AUTO_TEST_CASE(test_keyframe_lookup) {
+    std::vector<AnimationKeyframe> frames;
+    for (int i = 0; i < 5; ++i) {
+        const auto t = static_cast<float>(i);
+        frames.emplace_back(glm::quat{1.0f, 0.0f, 0.0f, 0.0f},
+                            glm::vec3(0.f, t, 0.f), glm::vec3(1.f), t, i);
+    }
+    AnimationBone bone("bone", 0, 0, 4.f, AnimationBone::RT0, frames);
+
+    BOOST_CHECK_EQUAL(bone.findKeyframe(0.f), 0u);
+    BOOST_CHECK_EQUAL(bone.findKeyframe(0.5f), 1u);
+    BOOST_CHECK_EQUAL(bone.findKeyframe(3.f), 3u);
+    BOOST_CHECK_EQUAL(bone.findKeyframe(4.5f), 5u);
+
+    // A stale cursor from either direction still finds the right keyframe
+    BOOST_CHECK_EQUAL(bone.findKeyframe(1.5f, 4), 2u);
+    BOOST_CHECK_EQUAL(bone.findKeyframe(3.5f, 1), 4u);
+
+    size_t cursor = 0;
+    for (float t = 0.25f; t < 4.f; t += 0.5f) {
+        auto kf = bone.getInterpolatedKeyframe(t, cursor);
+        BOOST_CHECK_CLOSE(kf.position.y, t, 0.001f);
+        BOOST_CHECK_EQUAL(cursor, bone.findKeyframe(t));
+    }
+
+    BOOST_CHECK_EQUAL(bone.getKeyframe(2.5f).id, 2);
+    BOOST_CHECK_EQUAL(bone.getKeyframe(10.f).id, 4);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,180 @@
+#include <boost/test/unit_test.hpp>
+#include <gl/BlockCompression.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+namespace {
+std::vector<std::uint8_t> gradient(int width, int height, bool alpha) {
+    std::vector<std::uint8_t> rgba(static_cast<size_t>(width) * height * 4);
+    for (int y = 0; y < height; ++y) {
+        for (int x = 0; x < width; ++x) {
+            auto p = &rgba[(static_cast<size_t>(y) * width + x) * 4];
+            p[0] = static_cast<std::uint8_t>(x * 255 / width);
+            p[1] = static_cast<std::uint8_t>(y * 255 / height);
+            p[2] = static_cast<std::uint8_t>((x + y) * 255 / (width + height));
+            p[3] = alpha ? static_cast<std::uint8_t>(255 - x * 255 / width)
+                         : 255;
+        }
+    }
+    return rgba;
+}
+
+std::vector<std::uint8_t> noise(int width, int height) {
+    std::mt19937 random(1234);
+    std::uniform_int_distribution<int> channel(0, 255);
+    std::vector<std::uint8_t> rgba(static_cast<size_t>(width) * height * 4);
+    for (size_t i = 0; i < rgba.size(); ++i) {
+        rgba[i] = (i % 4 == 3) ? 255 : static_cast<std::uint8_t>(channel(random));
+    }
+    return rgba;
+}
+
+/// Peak signal to noise ratio of one channel range, in decibels
+double psnr(const std::vector<std::uint8_t>& a,
+            const std::vector<std::uint8_t>& b, size_t firstChannel,
+            size_t channels) {
+    double error = 0.;
+    size_t count = 0;
+    for (size_t i = 0; i < a.size(); i += 4) {
+        for (size_t c = firstChannel; c < firstChannel + channels; ++c) {
+            const double diff = a[i + c] - b[i + c];
+            error += diff * diff;
+            count++;
+        }
+    }
+    const double mse = error / static_cast<double>(count);
+    if (mse == 0.) {
+        return 100.;
+    }
+    return 10. * std::log10(255. * 255. / mse);
+}
+}  // namespace
+
+BOOST_AUTO_TEST_SUITE(BlockCompressionTests)
+
+using BlockCompression::Format;
+
+BOOST_AUTO_TEST_CASE(test_sizes) {
+    BOOST_CHECK_EQUAL(BlockCompression::getCompressedSize(Format::BC1, 64, 32),
+                      16u * 8u * 8u);
+    BOOST_CHECK_EQUAL(BlockCompression::getCompressedSize(Format::BC3, 64, 32),
+                      16u * 8u * 16u);
+    // Partial blocks are stored whole
+    BOOST_CHECK_EQUAL(BlockCompression::getCompressedSize(Format::BC1, 1, 1),
+                      8u);
+    BOOST_CHECK_EQUAL(BlockCompression::getCompressedSize(Format::BC3, 6, 5),
+                      4u * 16u);
+}
+
+BOOST_AUTO_TEST_CASE(test_bc1_quality) {
+    const auto smooth = gradient(64, 64, false);
+    const auto encoded =
+        BlockCompression::encode(Format::BC1, smooth.data(), 64, 64);
+    const auto decoded =
+        BlockCompression::decode(Format::BC1, encoded.data(), 64, 64);
+    BOOST_CHECK_GT(psnr(smooth, decoded, 0, 3), 38.);
+    BOOST_CHECK_EQUAL(psnr(smooth, decoded, 3, 1), 100.);
+
+    // Noise is the worst case, it only needs to stay recognisable
+    const auto random = noise(64, 64);
+    const auto noisy = BlockCompression::decode(
+        Format::BC1,
+        BlockCompression::encode(Format::BC1, random.data(), 64, 64).data(),
+        64, 64);
+    BOOST_CHECK_GT(psnr(random, noisy, 0, 3), 12.);
+}
+
+BOOST_AUTO_TEST_CASE(test_bc3_quality) {
+    const auto image = gradient(64, 64, true);
+    const auto encoded =
+        BlockCompression::encode(Format::BC3, image.data(), 64, 64);
+    const auto decoded =
+        BlockCompression::decode(Format::BC3, encoded.data(), 64, 64);
+    BOOST_CHECK_GT(psnr(image, decoded, 0, 3), 38.);
+    BOOST_CHECK_GT(psnr(image, decoded, 3, 1), 45.);
+}
+
+BOOST_AUTO_TEST_CASE(test_solid_colour) {
+    std::vector<std::uint8_t> image(8 * 8 * 4);
+    for (size_t i = 0; i < image.size(); i += 4) {
+        image[i] = 255;
+        image[i + 1] = 0;
+        image[i + 2] = 255;
+        image[i + 3] = 128;
+    }
+    const auto decoded = BlockCompression::decode(
+        Format::BC3,
+        BlockCompression::encode(Format::BC3, image.data(), 8, 8).data(), 8,
+        8);
+    BOOST_CHECK(decoded == image);
+}
+
+BOOST_AUTO_TEST_CASE(test_odd_sizes) {
+    const auto image = gradient(7, 3, false);
+    const auto encoded =
+        BlockCompression::encode(Format::BC1, image.data(), 7, 3);
+    BOOST_CHECK_EQUAL(encoded.size(),
+                      BlockCompression::getCompressedSize(Format::BC1, 7, 3));
+    const auto decoded =
+        BlockCompression::decode(Format::BC1, encoded.data(), 7, 3);
+    BOOST_REQUIRE_EQUAL(decoded.size(), image.size());
+
+    // Same as compressing the image padded with its last row and column
+    std::vector<std::uint8_t> padded(8 * 4 * 4);
+    for (int y = 0; y < 4; ++y) {
+        for (int x = 0; x < 8; ++x) {
+            const auto src = (std::min(y, 2) * 7 + std::min(x, 6)) * 4;
+            std::copy_n(&image[src], 4, &padded[(y * 8 + x) * 4]);
+        }
+    }
+    const auto paddedDecoded = BlockCompression::decode(
+        Format::BC1,
+        BlockCompression::encode(Format::BC1, padded.data(), 8, 4).data(), 8,
+        4);
+    for (int y = 0; y < 3; ++y) {
+        for (int x = 0; x < 7; ++x) {
+            for (int c = 0; c < 4; ++c) {
+                BOOST_CHECK_EQUAL(decoded[(y * 7 + x) * 4 + c],
+                                  paddedDecoded[(y * 8 + x) * 4 + c]);
+            }
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE(test_mip_chain) {
+    const auto image = gradient(32, 8, true);
+    const auto levels =
+        BlockCompression::encodeMipChain(Format::BC3, image.data(), 32, 8);
+    BOOST_REQUIRE_EQUAL(levels.size(), 6u);
+    int width = 32;
+    int height = 8;
+    for (const auto& level : levels) {
+        BOOST_CHECK_EQUAL(level.width, width);
+        BOOST_CHECK_EQUAL(level.height, height);
+        BOOST_CHECK_EQUAL(
+            level.data.size(),
+            BlockCompression::getCompressedSize(Format::BC3, width, height));
+        width = std::max(width / 2, 1);
+        height = std::max(height / 2, 1);
+    }
+
+    // The smallest level is the average of the whole image
+    const auto last = BlockCompression::decode(
+        Format::BC3, levels.back().data.data(), 1, 1);
+    BOOST_CHECK_LT(std::abs(last[3] - 128), 8);
+}
+
+BOOST_AUTO_TEST_CASE(test_choose_format) {
+    const auto opaque = gradient(8, 8, false);
+    BOOST_CHECK(BlockCompression::chooseFormat(opaque.data(), 8, 8) ==
+                Format::BC1);
+    const auto transparent = gradient(8, 8, true);
+    BOOST_CHECK(BlockCompression::chooseFormat(transparent.data(), 8, 8) ==
+                Format::BC3);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -1,8 +1,14 @@
 #include <ai/DefaultAIController.hpp>
 #include <boost/test/unit_test.hpp>
+#include <LinearMath/btThreads.h>
+#include <btBulletDynamicsCommon.h>
+#include <chrono>
+#include <engine/GameState.hpp>
+#include <engine/GameWorld.hpp>
 #include <engine/Animator.hpp>
 #include <objects/CharacterObject.hpp>
 #include <objects/VehicleObject.hpp>
+#include <vector>
 #include "test_Globals.hpp"
 
 BOOST_AUTO_TEST_SUITE(CharacterTests, DATA_TEST_PREDICATE)
@@ -164,4 +170,129 @@ BOOST_AUTO_TEST_CASE(test_cycle_animating) {
     }
 }
 
+namespace {
+constexpr float kCharacterStep = 1.f / 60.f;
+
+void spawnCharacters(GameWorld& world, int count) {
+    world.setRandomSeed(1234);
+    for (int i = 0; i < count; ++i) {
+        glm::vec3 position(static_cast<float>(i % 25) * 4.f,
+                           static_cast<float>(i / 25) * 4.f, 0.f);
+        auto character = world.createPedestrian(1, position);
+        BOOST_REQUIRE(character);
+        character->setMovement(glm::vec3(0.f, 0.f, (i % 3) * 0.5f));
+        character->setRunning(i % 2 == 0);
+    }
+}
+
+void stepCharacters(GameWorld& world, int frames) {
+    for (int frame = 0; frame < frames; ++frame) {
+        world.dynamicsWorld->stepSimulation(kCharacterStep, 1,
+                                            kCharacterStep);
+        world.tickObjects(kCharacterStep);
+    }
+}
+
+std::vector<glm::vec3> characterPositions(const GameWorld& world) {
+    std::vector<glm::vec3> positions;
+    for (auto object : world.pedestrianPool.updateList) {
+        positions.push_back(object->getPosition());
+    }
+    return positions;
+}
+}  // namespace
+
+BOOST_AUTO_TEST_CASE(test_character_update_threaded) {
+    auto& global = Global::get();
+
+    // The first threaded world sets up the worker pool
+    { GameWorld threaded(&global.log, global.d, true); }
+    auto scheduler = btGetTaskScheduler();
+    const int maxThreads = scheduler->getNumThreads();
+
+    // Only the number of threads changes between the runs, so the results
+    // must be identical
+    std::vector<glm::vec3> reference;
+    for (int threads = 1; threads <= maxThreads; ++threads) {
+        scheduler->setNumThreads(threads);
+        WorldFixture fixture(true);
+        spawnCharacters(fixture.world, 200);
+        stepCharacters(fixture.world, 60);
+        const auto positions = characterPositions(fixture.world);
+
+        if (threads == 1) {
+            reference = positions;
+            continue;
+        }
+        BOOST_TEST_CONTEXT(threads << " threads") {
+            BOOST_CHECK_EQUAL_COLLECTIONS(positions.begin(), positions.end(),
+                                          reference.begin(), reference.end());
+        }
+    }
+    scheduler->setNumThreads(maxThreads);
+}
+
+BOOST_AUTO_TEST_CASE(test_character_update_scaling) {
+    constexpr int kCharacters = 500;
+    constexpr int kFrames = 120;
+    auto& global = Global::get();
+
+    // Only reports the times, test_character_update_threaded checks the
+    // results
+    auto run = [&](bool threaded) {
+        WorldFixture fixture(threaded);
+        spawnCharacters(fixture.world, kCharacters);
+        const auto start = std::chrono::steady_clock::now();
+        stepCharacters(fixture.world, kFrames);
+        return std::chrono::duration<double, std::milli>(
+                   std::chrono::steady_clock::now() - start)
+            .count();
+    };
+
+    BOOST_TEST_MESSAGE("Serial: " << kCharacters << " characters, "
+                                  << kFrames << " frames in " << run(false)
+                                  << " ms");
+
+    { GameWorld threaded(&global.log, global.d, true); }
+    auto scheduler = btGetTaskScheduler();
+    const int maxThreads = scheduler->getNumThreads();
+    for (int threads = 1; threads <= maxThreads; ++threads) {
+        scheduler->setNumThreads(threads);
+        BOOST_TEST_MESSAGE(threads << " threads: " << run(true) << " ms");
+    }
+    scheduler->setNumThreads(maxThreads);
+}
+
+BOOST_FIXTURE_TEST_CASE(test_kinematic_ground, WorldFixture) {
+    btStaticPlaneShape groundShape(btVector3(0.f, 0.f, 1.f), 0.f);
+    btCollisionObject ground;
+    ground.setCollisionShape(&groundShape);
+    world.dynamicsWorld->addCollisionObject(
+        &ground, btBroadphaseProxy::StaticFilter, btBroadphaseProxy::AllFilter);
+
+    auto character = world.createPedestrian(1, {0.f, 0.f, 2.f});
+    BOOST_REQUIRE(character && character->physObject);
+    character->setKinematic(true);
+    const auto feet = character->physShape->getHalfHeight() +
+                      character->physShape->getRadius();
+    auto& transform = character->physObject->getWorldTransform();
+
+    // Kinematic characters step down onto the ground
+    character->tickPhysics(1.f / 60.f);
+    BOOST_CHECK_SMALL(transform.getOrigin().z() - feet, 0.01f);
+
+    // And up onto it
+    transform.setOrigin(btVector3(0.f, 0.f, feet - 0.5f));
+    character->tickPhysics(1.f / 60.f);
+    BOOST_CHECK_SMALL(transform.getOrigin().z() - feet, 0.01f);
+
+    // Ground that is too far below is left alone
+    transform.setOrigin(btVector3(0.f, 0.f, 10.f));
+    character->tickPhysics(1.f / 60.f);
+    BOOST_CHECK_CLOSE(transform.getOrigin().z(), 10.f, 0.01f);
+
+    world.destroyObject(character);
+    world.dynamicsWorld->removeCollisionObject(&ground);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -1,6 +1,12 @@
 #include <boost/test/unit_test.hpp>
 #include <data/CutsceneData.hpp>
+#include <engine/GameData.hpp>
+#include <engine/GameState.hpp>
+#include <engine/GameWorld.hpp>
 #include <loaders/LoaderCutsceneDAT.hpp>
+#include <loaders/LoaderIFP.hpp>
+#include <objects/CharacterObject.hpp>
+#include <objects/CutsceneObject.hpp>
 #include <platform/FileHandle.hpp>
 #include "test_Globals.hpp"
 
@@ -29,4 +35,102 @@ BOOST_AUTO_TEST_CASE(test_load) {
     }
 }
 
+BOOST_AUTO_TEST_CASE(test_prefetch_file) {
+    auto data = Global::get().e->data;
+    auto expected = data->index.openFile("intro.dat");
+
+    data->prefetchFile("INTRO.DAT");
+    auto file = data->openFile("intro.dat");
+    BOOST_REQUIRE(file.data);
+    BOOST_CHECK_EQUAL(file.length, expected.length);
+    BOOST_CHECK(data->prefetchedFiles.empty());
+
+    // Files that weren't prefetched are always ready
+    BOOST_CHECK(data->isFileReady("intro.ifp"));
+}
+
+BOOST_AUTO_TEST_CASE(test_prefetch_cutscene) {
+    auto world = Global::get().e;
+    BOOST_CHECK(!world->isCutsceneReady("intro"));
+
+    world->prefetchCutscene("intro");
+    world->loadCutscene("intro");
+    BOOST_CHECK(world->finishLoadingCutscene(true));
+
+    BOOST_REQUIRE(world->state->currentCutscene);
+    BOOST_CHECK_EQUAL(world->state->currentCutscene->tracks.duration, 64.8f);
+    BOOST_CHECK(!world->data->animationsCutscene.empty());
+    BOOST_CHECK(!world->isCutsceneReady("intro"));
+
+    world->clearCutscene();
+    BOOST_CHECK(!world->state->currentCutscene);
+    BOOST_CHECK(world->data->animationsCutscene.empty());
+}
+
+BOOST_AUTO_TEST_CASE(test_prefetch_replaced) {
+    auto world = Global::get().e;
+
+    // Replaced prefetches are kept until they finish, not waited on
+    world->prefetchCutscene("intro");
+    world->prefetchCutscene("nocut");
+    BOOST_CHECK_LE(world->abandonedPrefetches.size(), 1u);
+    BOOST_CHECK(!world->isCutsceneReady("intro"));
+
+    world->loadCutscene("intro");
+    BOOST_CHECK(world->finishLoadingCutscene(true));
+    BOOST_REQUIRE(world->state->currentCutscene);
+    BOOST_CHECK_EQUAL(world->state->currentCutscene->tracks.duration, 64.8f);
+    BOOST_CHECK_LE(world->abandonedPrefetches.size(), 2u);
+
+    for (auto& prefetch : world->abandonedPrefetches) {
+        prefetch.wait();
+    }
+    world->prefetchCutscene("intro");
+    BOOST_CHECK(world->abandonedPrefetches.empty());
+    world->loadCutscene("intro");
+    world->clearCutscene();
+}
+
+BOOST_AUTO_TEST_CASE(test_load_without_waiting) {
+    auto world = Global::get().e;
+
+    LoaderIFP ifp;
+    auto file = world->data->index.openFile("intro.ifp");
+    BOOST_REQUIRE(file.data && ifp.loadFromMemory(file.data.get()));
+    BOOST_REQUIRE(!ifp.animations.empty());
+    const auto animation = ifp.animations.begin()->first;
+
+    // A deferred worker only reads the files once something waits for
+    // them, so loading has to return with nothing read
+    world->cutscenePrefetchLaunch = std::launch::deferred;
+    world->loadCutscene("intro");
+
+    BOOST_REQUIRE(world->state->currentCutscene);
+    BOOST_CHECK_EQUAL(world->state->currentCutscene->meta.name, "intro");
+    BOOST_CHECK_EQUAL(world->state->currentCutscene->tracks.duration, 0.f);
+    BOOST_CHECK(world->data->animationsCutscene.empty());
+    BOOST_CHECK(!world->isCutsceneReady("intro"));
+    BOOST_CHECK(!world->isCutsceneDone());
+
+    // Neither does the per-frame check, the script can still set up objects
+    BOOST_CHECK(!world->finishLoadingCutscene());
+    auto object = world->createCutsceneObject(
+        1, world->state->currentCutscene->meta.sceneOffset);
+    BOOST_REQUIRE(object);
+    world->setCutsceneAnimation(object, animation);
+    BOOST_CHECK(!object->animator->getAnimation(AnimIndexMovement));
+
+    // Starting the cutscene is what finally waits for the files
+    world->startCutscene();
+    BOOST_CHECK_EQUAL(world->state->currentCutscene->tracks.duration, 64.8f);
+    BOOST_CHECK(!world->data->animationsCutscene.empty());
+    BOOST_CHECK(object->animator->getAnimation(AnimIndexMovement) ==
+                world->data->animationsCutscene.at(animation));
+    BOOST_CHECK(!world->isCutsceneDone());
+
+    world->cutscenePrefetchLaunch = std::launch::async;
+    world->clearCutscene();
+    world->destroyQueuedObjects();
+}
+
 BOOST_AUTO_TEST_SUITE_END()
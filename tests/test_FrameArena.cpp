@@ -0,0 +1,158 @@
+#include <boost/test/unit_test.hpp>
+#include <core/FrameArena.hpp>
+#include <core/HeapCounter.hpp>
+
+#include <cstdint>
+#include <new>
+#include <thread>
+
+BOOST_AUTO_TEST_SUITE(FrameArenaTests)
+
+BOOST_AUTO_TEST_CASE(test_alignment) {
+    FrameArena arena(256);
+
+    auto a = arena.allocate(1, 1);
+    auto b = arena.allocate(8, 8);
+    auto c = arena.allocate(16, 16);
+    BOOST_CHECK_EQUAL(reinterpret_cast<std::uintptr_t>(b) % 8, 0u);
+    BOOST_CHECK_EQUAL(reinterpret_cast<std::uintptr_t>(c) % 16, 0u);
+    BOOST_CHECK_EQUAL(arena.getLiveCount(), 3u);
+
+    arena.deallocate(a, 1);
+    arena.deallocate(b, 8);
+    arena.deallocate(c, 16);
+    BOOST_CHECK_EQUAL(arena.getLiveCount(), 0u);
+}
+
+BOOST_AUTO_TEST_CASE(test_rewind) {
+    FrameArena arena(256);
+
+    auto a = arena.allocate(32, 4);
+    auto b = arena.allocate(32, 4);
+    BOOST_CHECK_EQUAL(arena.getBytesUsed(), 64u);
+
+    // Memory is only reused once everything has been freed
+    arena.deallocate(a, 32);
+    BOOST_CHECK_EQUAL(arena.getBytesUsed(), 64u);
+    arena.deallocate(b, 32);
+    BOOST_CHECK_EQUAL(arena.getBytesUsed(), 0u);
+
+    BOOST_CHECK_EQUAL(arena.allocate(32, 4), a);
+}
+
+BOOST_AUTO_TEST_CASE(test_blocks_merge) {
+    FrameArena arena(64);
+
+    auto a = arena.allocate(48, 4);
+    auto b = arena.allocate(48, 4);
+    auto c = arena.allocate(200, 4);
+    BOOST_CHECK_EQUAL(arena.getHeapAllocationCount(), 3u);
+    BOOST_CHECK_GE(arena.getCapacity(), 328u);
+
+    arena.deallocate(a, 48);
+    arena.deallocate(b, 48);
+    arena.deallocate(c, 200);
+
+    // The same allocations fit into the merged block
+    const auto capacity = arena.getCapacity();
+    arena.reset();
+    a = arena.allocate(48, 4);
+    b = arena.allocate(48, 4);
+    c = arena.allocate(200, 4);
+    BOOST_CHECK_EQUAL(arena.getHeapAllocationCount(), 0u);
+    BOOST_CHECK_EQUAL(arena.getCapacity(), capacity);
+    arena.deallocate(a, 48);
+    arena.deallocate(b, 48);
+    arena.deallocate(c, 200);
+}
+
+BOOST_AUTO_TEST_CASE(test_vector) {
+    FrameArena arena(1024);
+    {
+        FrameVector<int> v{FrameAllocator<int>(arena)};
+        for (int i = 0; i < 1000; ++i) {
+            v.push_back(i);
+        }
+        BOOST_CHECK_EQUAL(v[999], 999);
+
+        FrameVector<int> moved = std::move(v);
+        BOOST_CHECK_EQUAL(moved.size(), 1000u);
+        BOOST_CHECK(moved.get_allocator().getArena() == &arena);
+        BOOST_CHECK_GT(arena.getLiveCount(), 0u);
+    }
+    BOOST_CHECK_EQUAL(arena.getLiveCount(), 0u);
+}
+
+BOOST_AUTO_TEST_CASE(test_frames_avoid_heap) {
+    FrameArena arena;
+
+    struct Item {
+        float values[16];
+    };
+
+    // A frame of short lived containers, like render lists and script
+    // parameters
+    const auto frame = [&] {
+        FrameVector<Item> list{FrameAllocator<Item>(arena)};
+        list.reserve(500);
+        for (int i = 0; i < 2000; ++i) {
+            list.push_back({});
+        }
+        for (int i = 0; i < 5000; ++i) {
+            FrameVector<int> params{FrameAllocator<int>(arena)};
+            params.push_back(i);
+            params.push_back(i);
+        }
+    };
+
+    // The first frame grows the arena
+    frame();
+    BOOST_CHECK_GT(arena.getHeapAllocationCount(), 0u);
+    arena.reset();
+
+    size_t heapAllocations = 0;
+    size_t allocations = 0;
+    const auto start = HeapCounter::getAllocationCount();
+    for (int i = 0; i < 10; ++i) {
+        frame();
+        heapAllocations += arena.getHeapAllocationCount();
+        allocations += arena.getAllocationCount();
+        arena.reset();
+    }
+    const auto mallocs = HeapCounter::getAllocationCount() - start;
+
+    BOOST_TEST_MESSAGE(allocations << " allocations served with " << mallocs
+                                   << " heap allocations in 10 frames");
+    BOOST_CHECK_EQUAL(heapAllocations, 0u);
+    BOOST_CHECK_EQUAL(mallocs, 0u);
+    BOOST_CHECK_GT(allocations, 10u * 5000u);
+}
+
+BOOST_AUTO_TEST_CASE(test_heap_counter) {
+    const auto start = HeapCounter::getAllocationCount();
+    auto a = ::operator new(16);
+    auto b = ::operator new[](16);
+    auto c = ::operator new(16, std::nothrow);
+    auto d = ::operator new[](16, std::nothrow);
+    BOOST_CHECK_EQUAL(HeapCounter::getAllocationCount() - start, 4u);
+    ::operator delete(a);
+    ::operator delete[](b);
+    ::operator delete(c, std::nothrow);
+    ::operator delete[](d, std::nothrow);
+}
+
+BOOST_AUTO_TEST_CASE(test_per_thread) {
+    FrameArena* mainArena = &FrameArena::forThread();
+    FrameArena* otherArena = nullptr;
+    std::thread thread([&] { otherArena = &FrameArena::forThread(); });
+    thread.join();
+
+    BOOST_CHECK(mainArena == &FrameArena::forThread());
+    BOOST_CHECK(otherArena != nullptr);
+    BOOST_CHECK(otherArena != mainArena);
+
+    FrameVector<int> v;
+    BOOST_CHECK(v.get_allocator().getArena() == mainArena);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -1,7 +1,16 @@
 #include <boost/test/unit_test.hpp>
+#include <algorithm>
+#include <chrono>
+#include <memory>
+#include <vector>
+#include <data/ModelData.hpp>
 #include <engine/GameData.hpp>
 #include <engine/GameWorld.hpp>
+#include <engine/GameState.hpp>
+#include <objects/CharacterObject.hpp>
 #include <objects/InstanceObject.hpp>
+#include <objects/ProjectileObject.hpp>
+#include <objects/VehicleObject.hpp>
 #include "test_Globals.hpp"
 
 BOOST_AUTO_TEST_SUITE(GameWorldTests, DATA_TEST_PREDICATE)
@@ -15,6 +24,233 @@ BOOST_AUTO_TEST_CASE(test_gameobject_id) {
     BOOST_CHECK_NE(object1->getGameObjectID(), object2->getGameObjectID());
 }
 
+BOOST_AUTO_TEST_CASE(test_physics_active_set) {
+    auto& gw = *Global::get().e;
+    auto& active = gw.physicsInstances;
+
+    auto object = gw.createInstance(1337, glm::vec3(100.f, 0.f, 0.f));
+    BOOST_REQUIRE(object);
+    BOOST_CHECK(!object->isPhysicsActive());
+
+    // Objects with nothing to do drop out after one step
+    gw.activatePhysics(object);
+    BOOST_CHECK(object->isPhysicsActive());
+    BOOST_CHECK(std::find(active.begin(), active.end(), object) !=
+                active.end());
+
+    gw.dynamicsWorld->stepSimulation(1.f / 60.f, 1, 1.f / 60.f);
+    BOOST_CHECK(!object->isPhysicsActive());
+    BOOST_CHECK(std::find(active.begin(), active.end(), object) ==
+                active.end());
+
+    // Destroyed objects are removed straight away
+    gw.activatePhysics(object);
+    gw.destroyObject(object);
+    BOOST_CHECK(std::find(active.begin(), active.end(), object) ==
+                active.end());
+}
+
+BOOST_AUTO_TEST_CASE(test_update_lists) {
+    auto& gw = *Global::get().e;
+
+    auto instance = gw.createInstance(1337, glm::vec3(100.f, 0.f, 0.f));
+    auto vehicle = gw.createVehicle(90u, glm::vec3(100.f, 10.f, 0.f));
+    auto character = gw.createPedestrian(1, glm::vec3(100.f, 20.f, 0.f));
+    BOOST_REQUIRE(instance && vehicle && character);
+
+    auto contains = [](const GameWorld::ObjectPool& pool, GameObject* object) {
+        const auto& list = pool.updateList;
+        return std::find(list.begin(), list.end(), object) != list.end();
+    };
+
+    // Instances and vehicles have no per-frame work outside of physics
+    BOOST_CHECK(!contains(gw.instancePool, instance));
+    BOOST_CHECK(!contains(gw.vehiclePool, vehicle));
+    BOOST_CHECK(contains(gw.pedestrianPool, character));
+
+    gw.destroyObject(character);
+    BOOST_CHECK(!contains(gw.pedestrianPool, character));
+
+    gw.destroyObject(vehicle);
+    gw.destroyObject(instance);
+}
+
+BOOST_FIXTURE_TEST_CASE(test_tick_objects_update_lists, WorldFixture) {
+    constexpr int kObjects = 1000;
+    constexpr float kStep = 1.f / 60.f;
+    auto grenade = &Global::get().d->weaponData.at(5);
+
+    // Roughly the mix of a busy street: mostly static instances
+    std::vector<GameObject*> characters;
+    std::vector<GameObject*> grenades;
+    for (int i = 0; i < kObjects; ++i) {
+        glm::vec3 position(static_cast<float>(i % 100) * 10.f,
+                           static_cast<float>(i / 100) * 10.f, 0.f);
+        if (i % 20 == 0) {
+            characters.push_back(world.createPedestrian(1, position));
+            BOOST_REQUIRE(characters.back());
+        } else if (i % 50 == 5) {
+            auto projectile = std::make_unique<ProjectileObject>(
+                &world, position,
+                ProjectileObject::ProjectileInfo{ProjectileObject::Grenade,
+                                                 {0.f, 0.f, -1.f}, 0.f, kStep,
+                                                 grenade});
+            grenades.push_back(projectile.get());
+            world.allObjects.push_back(projectile.get());
+            world.projectilePool.insert(std::move(projectile));
+        } else if (i % 10 == 0) {
+            BOOST_REQUIRE(world.createVehicle(90u, position));
+        } else {
+            BOOST_REQUIRE(world.createInstance(1337, position));
+        }
+    }
+
+    // Only the objects with per-frame work are listed, in creation order
+    BOOST_CHECK(world.pedestrianPool.updateList == characters);
+    BOOST_CHECK(world.projectilePool.updateList == grenades);
+    BOOST_CHECK(world.instancePool.updateList.empty());
+    BOOST_CHECK(world.vehiclePool.updateList.empty());
+    BOOST_CHECK(world.physicsInstances.empty());
+
+    // Not in a pool, so tickObjects doesn't see it even though it's in
+    // allObjects
+    ProjectileObject loose(
+        &world, glm::vec3(0.f, 0.f, 100.f),
+        {ProjectileObject::Grenade, {0.f, 0.f, -1.f}, 0.f, kStep, grenade});
+    world.allObjects.push_back(&loose);
+
+    world.tickObjects(kStep);
+
+    // Every listed grenade went off, the loose one didn't
+    BOOST_CHECK_EQUAL(world.areaDamage.getQueuedCount(), grenades.size());
+    world.areaDamage.clear();
+    world.allObjects.erase(
+        std::remove(world.allObjects.begin(), world.allObjects.end(), &loose),
+        world.allObjects.end());
+
+    world.destroyQueuedObjects();
+    BOOST_CHECK(world.projectilePool.updateList.empty());
+    BOOST_CHECK(world.pedestrianPool.updateList == characters);
+
+    // Static instances stay asleep
+    BOOST_CHECK(world.physicsInstances.empty());
+}
+
+BOOST_FIXTURE_TEST_CASE(test_tick_objects_benchmark, WorldFixture) {
+    constexpr int kObjects = 10000;
+    constexpr int kFrames = 100;
+    constexpr float kStep = 1.f / 60.f;
+
+    // Roughly the mix of a busy street: mostly static instances
+    for (int i = 0; i < kObjects; ++i) {
+        glm::vec3 position(static_cast<float>(i % 100) * 10.f,
+                           static_cast<float>(i / 100) * 10.f, 0.f);
+        if (i % 20 == 0) {
+            BOOST_REQUIRE(world.createPedestrian(1, position));
+        } else if (i % 10 == 0) {
+            BOOST_REQUIRE(world.createVehicle(90u, position));
+        } else {
+            BOOST_REQUIRE(world.createInstance(1337, position));
+        }
+    }
+
+    // Only reports the times, test_tick_objects_update_lists checks what
+    // gets ticked
+    using Clock = std::chrono::steady_clock;
+    auto start = Clock::now();
+    for (int frame = 0; frame < kFrames; ++frame) {
+        for (auto& object : world.allObjects) {
+            object->tick(kStep);
+        }
+    }
+    auto allObjects =
+        std::chrono::duration<double, std::milli>(Clock::now() - start);
+
+    start = Clock::now();
+    for (int frame = 0; frame < kFrames; ++frame) {
+        world.tickObjects(kStep);
+    }
+    auto updateLists =
+        std::chrono::duration<double, std::milli>(Clock::now() - start);
+
+    BOOST_TEST_MESSAGE(kObjects << " objects, " << kFrames << " frames: "
+                       << "allObjects " << allObjects.count() << " ms, "
+                       << "update lists " << updateLists.count() << " ms");
+}
+
+BOOST_FIXTURE_TEST_CASE(test_model_instance_index, WorldFixture) {
+    auto& index = world.modelInstances;
+    std::vector<InstanceObject*> found;
+
+    auto nearby = world.createInstance(1337, glm::vec3(10.f, 10.f, 0.f));
+    auto distant = world.createInstance(1337, glm::vec3(1000.f, 10.f, 0.f));
+    auto other = world.createInstance(1100, glm::vec3(12.f, 10.f, 0.f));
+    BOOST_REQUIRE(nearby && distant && other);
+    BOOST_CHECK_EQUAL(index.getInstanceCount(1337), 2);
+
+    index.findNear(1337, glm::vec2(0.f, 0.f), 50.f, found);
+    BOOST_REQUIRE_EQUAL(found.size(), 1);
+    BOOST_CHECK_EQUAL(found[0], nearby);
+
+    // Moving to another cell keeps it findable
+    nearby->setPosition(glm::vec3(990.f, 10.f, 0.f));
+    index.findNear(1337, glm::vec2(1000.f, 10.f), 50.f, found);
+    BOOST_REQUIRE_EQUAL(found.size(), 2);
+    BOOST_CHECK_EQUAL(found[0], nearby);
+    BOOST_CHECK_EQUAL(found[1], distant);
+    index.findNear(1337, glm::vec2(0.f, 0.f), 50.f, found);
+    BOOST_CHECK(found.empty());
+
+    // Changing the model moves it to the other model's list
+    auto model = world.data->findModelInfo<SimpleModelInfo>(1100);
+    distant->changeModel(model);
+    BOOST_CHECK_EQUAL(index.getInstanceCount(1337), 1);
+    BOOST_CHECK_EQUAL(index.getInstanceCount(1100), 2);
+
+    world.destroyObject(nearby);
+    BOOST_CHECK_EQUAL(index.getInstanceCount(1337), 0);
+}
+
+BOOST_FIXTURE_TEST_CASE(test_model_instance_index_search, WorldFixture) {
+    constexpr int kObjects = 10000;
+    constexpr int kSearches = 200;
+    constexpr float kRadius = 40.f;
+
+    for (int i = 0; i < kObjects; ++i) {
+        glm::vec3 position(static_cast<float>(i % 100) * 20.f - 1000.f,
+                           static_cast<float>(i / 100) * 20.f - 1000.f, 0.f);
+        BOOST_REQUIRE(world.createInstance(i % 7 == 0 ? 1100 : 1337, position));
+    }
+
+    const auto& modelName =
+        world.data->findModelInfo<BaseModelInfo>(1100)->name;
+    auto scan = [&](const glm::vec2& centre) {
+        // What the searches did before the index
+        std::vector<InstanceObject*> out;
+        for (const auto& p : world.instancePool.objects) {
+            auto object = static_cast<InstanceObject*>(p.second.get());
+            if (object->getModelInfo<BaseModelInfo>()->name != modelName) {
+                continue;
+            }
+            if (glm::distance(centre, glm::vec2(object->getPosition())) <=
+                kRadius) {
+                out.push_back(object);
+            }
+        }
+        return out;
+    };
+    auto centreFor = [](int i) {
+        return glm::vec2(static_cast<float>((i * 37) % 2000) - 1000.f,
+                         static_cast<float>((i * 91) % 2000) - 1000.f);
+    };
+
+    std::vector<InstanceObject*> found;
+    for (int i = 0; i < kSearches; ++i) {
+        world.modelInstances.findNear(1100, centreFor(i), kRadius, found);
+        BOOST_CHECK(found == scan(centreFor(i)));
+    }
+}
+
 BOOST_AUTO_TEST_CASE(test_offsetgametime) {
     auto& gw = *Global::get().e;
     gw.state = new GameState();
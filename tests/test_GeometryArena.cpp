@@ -0,0 +1,58 @@
+#include <boost/test/unit_test.hpp>
+#include <gl/GeometryArena.hpp>
+
+BOOST_AUTO_TEST_SUITE(GeometryArenaTests)
+
+BOOST_AUTO_TEST_CASE(test_allocate) {
+    ArenaAllocator allocator(100);
+
+    BOOST_CHECK_EQUAL(allocator.allocate(10), 0u);
+    BOOST_CHECK_EQUAL(allocator.allocate(20), 10u);
+    BOOST_CHECK_EQUAL(allocator.getUsed(), 30u);
+
+    BOOST_CHECK_EQUAL(allocator.allocate(71), ArenaAllocator::npos);
+    BOOST_CHECK_EQUAL(allocator.allocate(0), ArenaAllocator::npos);
+    BOOST_CHECK_EQUAL(allocator.allocate(70), 30u);
+    BOOST_CHECK_EQUAL(allocator.allocate(1), ArenaAllocator::npos);
+}
+
+BOOST_AUTO_TEST_CASE(test_free_reuse) {
+    ArenaAllocator allocator(100);
+
+    auto a = allocator.allocate(10);
+    auto b = allocator.allocate(10);
+    allocator.allocate(10);
+
+    allocator.free(a, 10);
+    BOOST_CHECK_EQUAL(allocator.getUsed(), 20u);
+
+    // Too large for the hole, placed after the used ranges
+    BOOST_CHECK_EQUAL(allocator.allocate(15), 30u);
+    // Fits in the hole left by a
+    BOOST_CHECK_EQUAL(allocator.allocate(5), a);
+
+    // b joins what is left of the hole
+    allocator.free(b, 10);
+    BOOST_CHECK_EQUAL(allocator.allocate(15), a + 5);
+}
+
+BOOST_AUTO_TEST_CASE(test_free_merge) {
+    ArenaAllocator allocator(30);
+
+    auto a = allocator.allocate(10);
+    auto b = allocator.allocate(10);
+    auto c = allocator.allocate(10);
+    BOOST_CHECK_EQUAL(allocator.getFreeRangeCount(), 0u);
+
+    allocator.free(a, 10);
+    allocator.free(c, 10);
+    BOOST_CHECK_EQUAL(allocator.getFreeRangeCount(), 2u);
+
+    // Freeing the middle joins all three ranges
+    allocator.free(b, 10);
+    BOOST_CHECK_EQUAL(allocator.getFreeRangeCount(), 1u);
+    BOOST_CHECK_EQUAL(allocator.getUsed(), 0u);
+    BOOST_CHECK_EQUAL(allocator.allocate(30), 0u);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
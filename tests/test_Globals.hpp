@@ -132,4 +132,24 @@ public:
     }
 };
 
+/**
+ * A world of its own, for tests that fill one up or need a clean one
+ *
+ * Creating a world points the game data at it, so the global world is put
+ * back afterwards. Worlds the test creates itself are covered as well.
+ */
+struct WorldFixture {
+    GameState state;
+    GameWorld world;
+
+    explicit WorldFixture(bool threaded = false)
+        : world(&Global::get().log, Global::get().d, threaded) {
+        world.state = &state;
+    }
+
+    ~WorldFixture() {
+        Global::get().d->engine = Global::get().e;
+    }
+};
+
 #endif
@@ -65,4 +65,36 @@ BOOST_AUTO_TEST_CASE(test_clump_clone) {
     }
 }
 
+BOOST_AUTO_TEST_CASE(test_frame_world_transform) {
+    {
+        auto root = std::make_shared<ModelFrame>(0);
+        auto child = std::make_shared<ModelFrame>(1);
+        auto grandchild = std::make_shared<ModelFrame>(2);
+        root->addChild(child);
+        child->addChild(grandchild);
+
+        root->setTranslation(glm::vec3(1.f, 0.f, 0.f));
+        child->setTranslation(glm::vec3(0.f, 2.f, 0.f));
+        grandchild->setTranslation(glm::vec3(0.f, 0.f, 3.f));
+
+        BOOST_CHECK(glm::vec3(grandchild->getWorldTransform()[3]) ==
+                    glm::vec3(1.f, 2.f, 3.f));
+
+        // Moving a parent after its children were read updates them too
+        root->setTranslation(glm::vec3(5.f, 0.f, 0.f));
+        BOOST_CHECK(glm::vec3(child->getWorldTransform()[3]) ==
+                    glm::vec3(5.f, 2.f, 0.f));
+        BOOST_CHECK(glm::vec3(grandchild->getWorldTransform()[3]) ==
+                    glm::vec3(5.f, 2.f, 3.f));
+
+        // Reparenting picks up the new parent's transform
+        auto other = std::make_shared<ModelFrame>(3);
+        other->setTranslation(glm::vec3(0.f, 0.f, 10.f));
+        other->addChild(child);
+        BOOST_CHECK(glm::vec3(grandchild->getWorldTransform()[3]) ==
+                    glm::vec3(0.f, 2.f, 13.f));
+        BOOST_CHECK(root->getChildren().empty());
+    }
+}
+
 BOOST_AUTO_TEST_SUITE_END()
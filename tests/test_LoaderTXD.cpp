@@ -0,0 +1,197 @@
+#include <boost/test/unit_test.hpp>
+#include <gl/gl_core_3_3.h>
+#include <loaders/LoaderTXD.hpp>
+#include <loaders/RWBinaryStream.hpp>
+#include <platform/FileHandle.hpp>
+#include <render/OpenGLRenderer.hpp>
+#include "test_Globals.hpp"
+
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+namespace {
+struct CacheDirectory {
+    rwfs::path path;
+
+    CacheDirectory()
+        : path(rwfs::temp_directory_path() / "openrw_loadertxd_test") {
+        rwfs::remove_all(path);
+    }
+
+    ~CacheDirectory() {
+        rwfs::error_code ec;
+        rwfs::remove_all(path, ec);
+    }
+};
+
+constexpr uint16_t kSize = 4;
+constexpr uint8_t kRed = 200, kGreen = 100, kBlue = 40, kAlpha = 128;
+
+template <class T>
+void write(std::vector<char>& data, size_t offset, const T& value) {
+    if (data.size() < offset + sizeof(T)) {
+        data.resize(offset + sizeof(T));
+    }
+    std::memcpy(data.data() + offset, &value, sizeof(T));
+}
+
+/**
+ * A single colour raster, with the pixels where the loader reads them
+ */
+std::vector<char> makeTexture(const std::string& name, uint32_t format) {
+    const size_t raw = sizeof(RW::BSSectionHeader);
+    const size_t pixels = kSize * kSize;
+
+    std::vector<char> section;
+    RW::BSTextureNative texNative{};
+    texNative.platform = 8;
+    texNative.filterflags = RW::BSTextureNative::FILTER_LINEAR;
+    texNative.wrapU = texNative.wrapV = RW::BSTextureNative::WRAP_WRAP;
+    std::strncpy(texNative.diffuseName, name.c_str(),
+                 sizeof(texNative.diffuseName) - 1);
+    texNative.rasterformat = format;
+    texNative.width = texNative.height = kSize;
+    write(section, raw + sizeof(RW::BSSectionHeader), texNative);
+
+    auto coldata = raw + sizeof(RW::BSTextureNative) + sizeof(uint32_t);
+    if (format & RW::BSTextureNative::FORMAT_EXT_PAL8) {
+        const auto palette = raw + sizeof(RW::BSSectionHeader) +
+                             sizeof(RW::BSTextureNative) - 4;
+        const uint8_t entry[] = {kRed, kGreen, kBlue, kAlpha};
+        write(section, palette + 3 * 4, entry);
+        write(section, palette + 1024, static_cast<uint32_t>(pixels));
+        for (size_t i = 0; i < pixels; ++i) {
+            write(section, palette + 1028 + i, uint8_t{3});
+        }
+    } else if (format == RW::BSTextureNative::FORMAT_1555) {
+        const auto value = static_cast<uint16_t>(
+            (kRed >> 3) | ((kGreen >> 3) << 5) | ((kBlue >> 3) << 10) |
+            0x8000);
+        for (size_t i = 0; i < pixels; ++i) {
+            write(section, coldata + i * 2, value);
+        }
+    } else {
+        if (format == RW::BSTextureNative::FORMAT_8888) {
+            coldata += 8;
+        }
+        const uint8_t alpha =
+            format == RW::BSTextureNative::FORMAT_8888 ? kAlpha : 255;
+        const uint8_t bgra[] = {kBlue, kGreen, kRed, alpha};
+        for (size_t i = 0; i < pixels; ++i) {
+            write(section, coldata + i * 4, bgra);
+        }
+    }
+
+    const auto size = static_cast<uint32_t>(section.size() - raw);
+    write(section, 0, RW::BSSectionHeader{RW::SID_TextureNative, size, 0});
+    write(section, raw,
+          RW::BSSectionHeader{RW::SID_Struct,
+                              static_cast<uint32_t>(sizeof(texNative)), 0});
+    return section;
+}
+
+FileContentsInfo makeArchive(const std::vector<uint32_t>& formats) {
+    std::vector<char> body;
+    write(body, 0,
+          RW::BSSectionHeader{RW::SID_Struct,
+                              sizeof(RW::BSTextureDictionary), 0});
+    write(body, sizeof(RW::BSSectionHeader),
+          RW::BSTextureDictionary{static_cast<uint16_t>(formats.size()), 0});
+    for (size_t i = 0; i < formats.size(); ++i) {
+        const auto texture =
+            makeTexture("texture" + std::to_string(i), formats[i]);
+        body.insert(body.end(), texture.begin(), texture.end());
+    }
+
+    std::vector<char> data;
+    write(data, 0,
+          RW::BSSectionHeader{RW::SID_TextureDictionary,
+                              static_cast<uint32_t>(body.size()), 0});
+    data.insert(data.end(), body.begin(), body.end());
+
+    auto memory = std::make_unique<char[]>(data.size());
+    std::memcpy(memory.get(), data.data(), data.size());
+    return {std::move(memory), data.size()};
+}
+
+std::vector<uint8_t> readTexture(const TextureData& texture) {
+    std::vector<uint8_t> rgba(kSize * kSize * 4);
+    glBindTexture(GL_TEXTURE_2D, texture.getName());
+    glGetTexImage(GL_TEXTURE_2D, 0, GL_RGBA, GL_UNSIGNED_BYTE, rgba.data());
+    return rgba;
+}
+
+const std::vector<uint32_t> kFormats = {
+    RW::BSTextureNative::FORMAT_1555,
+    RW::BSTextureNative::FORMAT_888,
+    RW::BSTextureNative::FORMAT_8888,
+    RW::BSTextureNative::FORMAT_EXT_PAL8 | RW::BSTextureNative::FORMAT_8888,
+};
+}  // namespace
+
+BOOST_AUTO_TEST_SUITE(LoaderTXDTests)
+
+BOOST_AUTO_TEST_CASE(test_compressed_channels) {
+    // The textures need the test context
+    Global::get();
+    OpenGLRenderer renderer;
+    if (!ogl_ext_EXT_texture_compression_s3tc) {
+        BOOST_TEST_MESSAGE("S3TC isn't supported, skipping");
+        return;
+    }
+
+    TextureArchive uncompressed;
+    BOOST_REQUIRE(TextureLoader().loadFromMemory(makeArchive(kFormats),
+                                                 uncompressed, "channels"));
+
+    CacheDirectory directory;
+    TextureLoader loader;
+    loader.setCache(std::make_unique<TextureCache>(directory.path));
+    TextureArchive compressed;
+    BOOST_REQUIRE(
+        loader.loadFromMemory(makeArchive(kFormats), compressed, "channels"));
+
+    // Each format decodes to the colours it is uploaded as, give or take
+    // the block compression
+    BOOST_REQUIRE_EQUAL(compressed.size(), kFormats.size());
+    for (size_t i = 0; i < kFormats.size(); ++i) {
+        const auto name = "texture" + std::to_string(i);
+        BOOST_TEST_CONTEXT("Raster format " << std::hex << kFormats[i]) {
+            BOOST_REQUIRE(uncompressed[name] && compressed[name]);
+            const auto expected = readTexture(*uncompressed[name]);
+            const auto actual = readTexture(*compressed[name]);
+            for (size_t c = 0; c < expected.size(); ++c) {
+                BOOST_CHECK_LE(std::abs(expected[c] - actual[c]), 8);
+            }
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE(test_unsupported_not_cached) {
+    Global::get();
+    OpenGLRenderer renderer;
+    if (!ogl_ext_EXT_texture_compression_s3tc) {
+        BOOST_TEST_MESSAGE("S3TC isn't supported, skipping");
+        return;
+    }
+
+    CacheDirectory directory;
+    TextureLoader loader;
+    loader.setCache(std::make_unique<TextureCache>(directory.path));
+
+    // 565 isn't handled by the encoder, so the archive is uploaded as it is
+    auto file = makeArchive(
+        {RW::BSTextureNative::FORMAT_888, RW::BSTextureNative::FORMAT_565});
+    const auto hash = TextureCache::hash(file.data.get(), file.length);
+    TextureArchive textures;
+    BOOST_REQUIRE(loader.loadFromMemory(file, textures, "unsupported"));
+    BOOST_CHECK_EQUAL(textures.size(), 2u);
+
+    TextureCache::Archive archive;
+    BOOST_CHECK(!loader.getCache()->load("unsupported", hash, archive));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
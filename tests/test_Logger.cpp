@@ -1,5 +1,8 @@
 #include <boost/test/unit_test.hpp>
 #include <core/Logger.hpp>
+#include <string>
+#include <thread>
+#include <vector>
 
 class CallbackReceiver : public Logger::MessageReceiver {
 public:
@@ -27,10 +30,65 @@ BOOST_AUTO_TEST_CASE(test_receiver) {
     log.addReceiver(&receiver);
 
     log.info("Tests", "Test");
+    log.flush();
 
     BOOST_CHECK_EQUAL(lastMessage.component, "Tests");
     BOOST_CHECK_EQUAL(lastMessage.severity, Logger::Info);
     BOOST_CHECK_EQUAL(lastMessage.message, "Test");
 }
 
+BOOST_AUTO_TEST_CASE(test_formatting) {
+    Logger log;
+    std::vector<std::string> messages;
+    CallbackReceiver receiver(
+        [&](const Logger::LogMessage& m) { messages.push_back(m.message); });
+    log.addReceiver(&receiver);
+
+    const std::string name = "model";
+    log.error("Tests", "Failed to load ", name, " id ", 1337, ' ', -2, " at ",
+              0.5f, ' ', true);
+    log.error("Tests", std::string(1000, 'a'));
+    log.flush();
+
+    BOOST_REQUIRE_EQUAL(messages.size(), 2);
+    BOOST_CHECK_EQUAL(messages[0], "Failed to load model id 1337 -2 at 0.5 true");
+    BOOST_CHECK_EQUAL(messages[1].size(), Logger::kMaxMessageLength);
+    BOOST_CHECK_EQUAL(messages[1].substr(messages[1].size() - 3), "...");
+}
+
+BOOST_AUTO_TEST_CASE(test_many_threads) {
+    constexpr int kThreads = 4;
+    constexpr int kMessages = 2000;
+    std::vector<int> next(kThreads, 0);
+    bool ordered = true;
+    size_t received = 0;
+
+    // Larger than the queue, so writers have to wait for space
+    CallbackReceiver receiver([&](const Logger::LogMessage& m) {
+        const auto thread = std::stoi(m.component);
+        ordered &= std::stoi(m.message) == next[thread]++;
+        received++;
+    });
+    {
+        Logger log{&receiver};
+
+        std::vector<std::thread> threads;
+        for (int t = 0; t < kThreads; ++t) {
+            threads.emplace_back([&log, t] {
+                const auto component = std::to_string(t);
+                for (int i = 0; i < kMessages; ++i) {
+                    log.info(component, i);
+                }
+            });
+        }
+        for (auto& thread : threads) {
+            thread.join();
+        }
+        // Remaining messages are delivered when the logger is destroyed
+    }
+
+    BOOST_CHECK_EQUAL(received, kThreads * kMessages);
+    BOOST_CHECK(ordered);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,104 @@
+#include <boost/test/unit_test.hpp>
+#include <data/CollisionModel.hpp>
+#include <glm/gtc/matrix_transform.hpp>
+#include <render/OcclusionBuffer.hpp>
+#include <render/ViewCamera.hpp>
+
+namespace {
+// Looks down the x axis from the origin
+struct BufferFixture {
+    ViewCamera camera;
+    OcclusionBuffer buffer;
+
+    BufferFixture() {
+        camera.frustum.near = 0.1f;
+        camera.frustum.far = 1000.f;
+        buffer.clear(camera.frustum.projection() * camera.getView());
+    }
+
+    // A wall 10 units away, covering less than the view
+    void drawWall() {
+        drawWall(buffer);
+    }
+
+    static void drawWall(OcclusionBuffer& target) {
+        target.drawBox(glm::mat4(1.f), {10.f, -2.f, -2.f}, {11.f, 2.f, 2.f});
+    }
+};
+}  // namespace
+
+BOOST_AUTO_TEST_SUITE(OcclusionBufferTests)
+
+BOOST_FIXTURE_TEST_CASE(test_empty, BufferFixture) {
+    BOOST_CHECK(buffer.isVisible({50.f, 0.f, 0.f}, 1.f));
+    BOOST_CHECK_EQUAL(buffer.getTriangleCount(), 0u);
+}
+
+BOOST_FIXTURE_TEST_CASE(test_occluded, BufferFixture) {
+    drawWall();
+    BOOST_CHECK_GT(buffer.getTriangleCount(), 0u);
+
+    BOOST_CHECK(!buffer.isVisible({50.f, 0.f, 0.f}, 1.f));
+    // In front of the wall
+    BOOST_CHECK(buffer.isVisible({5.f, 0.f, 0.f}, 1.f));
+    // Beside the wall
+    BOOST_CHECK(buffer.isVisible({50.f, 0.f, 15.f}, 1.f));
+    // Only partly behind the wall
+    BOOST_CHECK(buffer.isVisible({50.f, 0.f, 10.f}, 1.f));
+    // Around the wall
+    BOOST_CHECK(buffer.isVisible({10.5f, 0.f, 0.f}, 3.f));
+}
+
+BOOST_FIXTURE_TEST_CASE(test_near_plane, BufferFixture) {
+    // A ceiling that starts behind the camera
+    buffer.drawBox(glm::mat4(1.f), {-5.f, -5.f, 1.f}, {12.f, 5.f, 30.f});
+    BOOST_CHECK_GT(buffer.getTriangleCount(), 0u);
+
+    BOOST_CHECK(!buffer.isVisible({50.f, 0.f, 15.f}, 1.f));
+    BOOST_CHECK(buffer.isVisible({50.f, 0.f, 0.f}, 1.f));
+    // Objects crossing the near plane are never occluded
+    BOOST_CHECK(buffer.isVisible({0.f, 0.f, 2.f}, 1.f));
+}
+
+BOOST_FIXTURE_TEST_CASE(test_collision, BufferFixture) {
+    CollisionModel collision;
+    collision.vertices = {
+        {0.f, -2.f, -2.f}, {0.f, 2.f, -2.f}, {0.f, 2.f, 2.f}, {0.f, -2.f, 2.f}};
+    collision.faces = {{{0, 1, 2}, {}}, {{0, 2, 3}, {}}, {{0, 3, 7}, {}}};
+
+    buffer.drawCollision(glm::translate(glm::mat4(1.f), {10.f, 0.f, 0.f}),
+                         collision);
+    // The face with a missing vertex is skipped
+    BOOST_CHECK_EQUAL(buffer.getTriangleCount(), 2u);
+    BOOST_CHECK(!buffer.isVisible({50.f, 0.f, 0.f}, 1.f));
+    BOOST_CHECK(buffer.isVisible({50.f, 0.f, 15.f}, 1.f));
+}
+
+BOOST_FIXTURE_TEST_CASE(test_deterministic, BufferFixture) {
+    drawWall();
+    buffer.drawBox(glm::mat4(1.f), {-5.f, -5.f, 1.f}, {12.f, 5.f, 30.f});
+
+    OcclusionBuffer other;
+    other.clear(camera.frustum.projection() * camera.getView());
+    // The same boxes in the other order
+    other.drawBox(glm::mat4(1.f), {-5.f, -5.f, 1.f}, {12.f, 5.f, 30.f});
+    drawWall(other);
+    BOOST_CHECK_EQUAL(buffer.getTriangleCount(), other.getTriangleCount());
+
+    bool same = true;
+    for (int y = 0; y < buffer.getHeight(); ++y) {
+        for (int x = 0; x < buffer.getWidth(); ++x) {
+            same = same && buffer.getDepth(x, y) == other.getDepth(x, y);
+        }
+    }
+    BOOST_CHECK(same);
+}
+
+BOOST_FIXTURE_TEST_CASE(test_clear, BufferFixture) {
+    drawWall();
+    buffer.clear(camera.frustum.projection() * camera.getView());
+    BOOST_CHECK(buffer.isVisible({50.f, 0.f, 0.f}, 1.f));
+    BOOST_CHECK_EQUAL(buffer.getTriangleCount(), 0u);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -1,5 +1,10 @@
 #include <boost/test/unit_test.hpp>
+#include <engine/GameData.hpp>
+#include <gl/TextureData.hpp>
 #include <render/GameRenderer.hpp>
+#include <render/GameShaders.hpp>
+#include <render/MapRenderer.hpp>
+#include "test_Globals.hpp"
 
 BOOST_AUTO_TEST_SUITE(RendererTests)
 
@@ -23,4 +28,127 @@ BOOST_AUTO_TEST_CASE(frustum_test_visible) {
     }
 }
 
+BOOST_AUTO_TEST_CASE(test_batched_object_uploads) {
+    // The renderer needs the test context
+    Global::get();
+    OpenGLRenderer renderer;
+
+    GeometryBuffer gbuff;
+    gbuff.uploadVertices<VertexP3>(
+        {{0.f, 0.f, 0.f}, {1.f, 0.f, 0.f}, {0.f, 1.f, 0.f}});
+    DrawBuffer dbuff;
+    dbuff.addGeometry(&gbuff);
+    dbuff.setFaceType(GL_TRIANGLES);
+
+    GLuint ibo;
+    const GLuint indices[] = {0, 1, 2};
+    glGenBuffers(1, &ibo);
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, ibo);
+    glBufferData(GL_ELEMENT_ARRAY_BUFFER, sizeof(indices), indices,
+                 GL_STATIC_DRAW);
+
+    Renderer::DrawParameters dp;
+    dp.count = 3;
+
+    RenderList list;
+    for (int i = 0; i < 100; ++i) {
+        list.emplace_back(0, glm::mat4(1.f), &dbuff, dp);
+    }
+
+    for (int frame = 0; frame < 5; ++frame) {
+        renderer.swap();
+        renderer.drawBatched(list);
+
+        // Identical instructions are instanced
+        const auto maxInstances = Renderer::kMaxInstances;
+        BOOST_CHECK_EQUAL(renderer.getDrawCount(),
+                          (100 + maxInstances - 1) / maxInstances);
+        BOOST_CHECK_EQUAL(renderer.getInstanceCount(), 100);
+        BOOST_CHECK_EQUAL(renderer.getUploadCount(), 1);
+    }
+
+    // Instructions with different state aren't
+    for (int i = 0; i < 100; i += 2) {
+        list[i].drawInfo.blendMode = BlendMode::BLEND_ALPHA;
+    }
+    renderer.swap();
+    renderer.drawBatched(list);
+    BOOST_CHECK_EQUAL(renderer.getDrawCount(), 100);
+    BOOST_CHECK_EQUAL(renderer.getInstanceCount(), 100);
+
+    glDeleteBuffers(1, &ibo);
+}
+
+BOOST_AUTO_TEST_CASE(test_uniform_handles) {
+    // The renderer needs the test context
+    Global::get();
+    OpenGLRenderer renderer;
+
+    auto program = renderer.createShader(
+        GameShaders::ScreenSpaceRect::VertexShader,
+        GameShaders::ScreenSpaceRect::FragmentShader);
+    auto colour = renderer.getUniform(program.get(), "colour");
+    auto size = renderer.getUniform(program.get(), "size");
+    BOOST_CHECK_GE(colour.slot, 0);
+    BOOST_CHECK_GE(size.slot, 0);
+    BOOST_CHECK_EQUAL(renderer.getUniform(program.get(), "missing").slot, -1);
+
+    // Name based calls look the uniform up every time
+    renderer.swap();
+    for (int i = 0; i < 10; ++i) {
+        renderer.setUniform(program.get(), "colour", glm::vec4(i));
+    }
+    BOOST_CHECK_EQUAL(renderer.getUniformLookupCount(), 10);
+
+    // Handles don't, and only changed values reach GL
+    for (int frame = 0; frame < 3; ++frame) {
+        renderer.swap();
+        for (int i = 0; i < 10; ++i) {
+            renderer.setUniform(colour, glm::vec4(frame));
+            renderer.setUniform(size, glm::vec2(1.f));
+        }
+        BOOST_CHECK_EQUAL(renderer.getUniformLookupCount(), 0);
+        BOOST_CHECK_EQUAL(renderer.getUniformCount(), frame == 0 ? 2 : 1);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(test_blip_sprites) {
+    // The map needs the test context
+    Global::get();
+    OpenGLRenderer renderer;
+    GameData data(&Global::get().log, "");
+    auto addTexture = [&](const std::string& name, int size) {
+        GLuint texture;
+        glGenTextures(1, &texture);
+        glBindTexture(GL_TEXTURE_2D, texture);
+        glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, size, size, 0, GL_RGBA,
+                     GL_UNSIGNED_BYTE, nullptr);
+        data.textureSlots["hud"][name] =
+            TextureData::create(texture, glm::ivec2(size), false);
+    };
+    addTexture("radar_north", 16);
+    addTexture("radar_centre", 8);
+    addTexture("radardisc", 32);
+
+    MapRenderer map(renderer, &data);
+    const auto untextured = map.getSpriteRect("");
+    BOOST_CHECK(map.getSpriteRect("radar_north") == untextured);
+
+    map.loadSprites();
+    const auto north = map.getSpriteRect("radar_north");
+    const auto centre = map.getSpriteRect("radar_centre");
+    BOOST_CHECK(north != untextured);
+    BOOST_CHECK(centre != untextured);
+    BOOST_CHECK(north != centre);
+    BOOST_CHECK_GT(north.z, centre.z);
+
+    // Only radar_ textures are blip sprites
+    BOOST_CHECK(map.getSpriteRect("radardisc") == untextured);
+    BOOST_CHECK(map.getSpriteRect("radar_missing") == untextured);
+
+    // The atlas is only built once
+    map.loadSprites();
+    BOOST_CHECK(map.getSpriteRect("radar_north") == north);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,118 @@
+#include <boost/test/unit_test.hpp>
+#include <render/GameShaders.hpp>
+#include <render/OpenGLRenderer.hpp>
+#include <render/ShaderCache.hpp>
+#include "test_Globals.hpp"
+
+namespace {
+struct CacheDirectory {
+    rwfs::path path;
+
+    CacheDirectory()
+        : path(rwfs::temp_directory_path() / "openrw_shadercache_test") {
+        rwfs::remove_all(path);
+    }
+
+    ~CacheDirectory() {
+        rwfs::error_code ec;
+        rwfs::remove_all(path, ec);
+    }
+};
+
+const std::string kVertex = GameShaders::ScreenSpaceRect::VertexShader;
+const std::string kFragment = GameShaders::ScreenSpaceRect::FragmentShader;
+}  // namespace
+
+BOOST_AUTO_TEST_SUITE(ShaderCacheTests)
+
+BOOST_AUTO_TEST_CASE(test_driver_id) {
+    // The test context, Mesa's llvmpipe on the CI machines
+    Global::get();
+    const auto id = ShaderCache::getDriverID();
+    BOOST_TEST_MESSAGE("Shader cache driver: " << id);
+    BOOST_CHECK(id.find(reinterpret_cast<const char*>(
+                    glGetString(GL_RENDERER))) != std::string::npos);
+    BOOST_CHECK_EQUAL(id, ShaderCache::getDriverID());
+}
+
+BOOST_AUTO_TEST_CASE(test_round_trip) {
+    Global::get();
+    OpenGLRenderer renderer;
+    if (!ShaderCache::isSupported()) {
+        BOOST_TEST_MESSAGE("Program binaries aren't supported, skipping");
+        return;
+    }
+
+    CacheDirectory directory;
+    ShaderCache cache(directory.path);
+    BOOST_CHECK_EQUAL(cache.load(kVertex, kFragment), 0u);
+    BOOST_CHECK_EQUAL(cache.getMissCount(), 1u);
+
+    const auto compiled = compileProgram(kVertex.c_str(), kFragment.c_str());
+    BOOST_REQUIRE(cache.store(kVertex, kFragment, compiled));
+    glDeleteProgram(compiled);
+
+    // A new cache reads the binary written by the first
+    ShaderCache other(directory.path);
+    const auto program = other.load(kVertex, kFragment);
+    BOOST_REQUIRE_NE(program, 0u);
+    BOOST_CHECK_EQUAL(other.getHitCount(), 1u);
+    GLint status = GL_FALSE;
+    glGetProgramiv(program, GL_LINK_STATUS, &status);
+    BOOST_CHECK_EQUAL(status, GL_TRUE);
+    BOOST_CHECK_GE(glGetUniformLocation(program, "colour"), 0);
+    glDeleteProgram(program);
+
+    // Changed sources are a miss
+    BOOST_CHECK_EQUAL(other.load(kVertex, kFragment + "\n"), 0u);
+    BOOST_CHECK_EQUAL(other.getMissCount(), 1u);
+}
+
+BOOST_AUTO_TEST_CASE(test_renderer_uses_cache) {
+    Global::get();
+    CacheDirectory directory;
+    {
+        OpenGLRenderer renderer(directory.path);
+        if (!renderer.getShaderCache()) {
+            BOOST_TEST_MESSAGE("Program binaries aren't supported, skipping");
+            return;
+        }
+        renderer.createShader(kVertex, kFragment);
+        BOOST_CHECK_EQUAL(renderer.getShaderCache()->getMissCount(), 1u);
+    }
+
+    OpenGLRenderer renderer(directory.path);
+    auto program = renderer.createShader(kVertex, kFragment);
+    BOOST_CHECK_EQUAL(renderer.getShaderCache()->getHitCount(), 1u);
+    BOOST_CHECK_EQUAL(renderer.getShaderCache()->getMissCount(), 0u);
+    BOOST_CHECK_GE(renderer.getUniform(program.get(), "colour").slot, 0);
+}
+
+BOOST_AUTO_TEST_CASE(test_damaged_binary) {
+    Global::get();
+    CacheDirectory directory;
+    {
+        OpenGLRenderer renderer(directory.path);
+        if (!renderer.getShaderCache()) {
+            BOOST_TEST_MESSAGE("Program binaries aren't supported, skipping");
+            return;
+        }
+        renderer.createShader(kVertex, kFragment);
+    }
+
+    const auto path =
+        ShaderCache(directory.path).getPath(kVertex, kFragment);
+    BOOST_REQUIRE(rwfs::exists(path));
+    rwfs::resize_file(path, rwfs::file_size(path) / 2);
+
+    // Compiled again and the file replaced
+    OpenGLRenderer renderer(directory.path);
+    auto program = renderer.createShader(kVertex, kFragment);
+    BOOST_CHECK_EQUAL(renderer.getShaderCache()->getMissCount(), 1u);
+    BOOST_CHECK_GE(renderer.getUniform(program.get(), "colour").slot, 0);
+    const auto reloaded = ShaderCache(directory.path).load(kVertex, kFragment);
+    BOOST_CHECK_NE(reloaded, 0u);
+    glDeleteProgram(reloaded);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
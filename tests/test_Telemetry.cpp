@@ -0,0 +1,87 @@
+#include <boost/test/unit_test.hpp>
+#include <core/Telemetry.hpp>
+
+#include <sstream>
+#include <string>
+
+BOOST_AUTO_TEST_SUITE(TelemetryTests)
+
+BOOST_AUTO_TEST_CASE(test_scope_samples) {
+    Telemetry telemetry;
+    const auto start = Telemetry::Clock::now();
+
+    telemetry.beginFrame();
+    telemetry.addSample(Telemetry::Physics, start,
+                        start + std::chrono::milliseconds(2));
+    telemetry.addSample(Telemetry::Physics, start + std::chrono::milliseconds(5),
+                        start + std::chrono::milliseconds(6));
+    telemetry.setCounter(Telemetry::Objects, 42);
+    BOOST_CHECK_EQUAL(telemetry.getFrameCount(), 0);
+
+    telemetry.beginFrame();
+    BOOST_REQUIRE_EQUAL(telemetry.getFrameCount(), 1);
+
+    const auto& frame = telemetry.getFrame(0);
+    BOOST_CHECK_EQUAL(frame.scopeTime[Telemetry::Physics], 3000000);
+    BOOST_CHECK_EQUAL(frame.scopeTime[Telemetry::Script], 0);
+    BOOST_CHECK_EQUAL(frame.counters[Telemetry::Objects], 42);
+    BOOST_CHECK_GE(frame.duration, 0);
+}
+
+BOOST_AUTO_TEST_CASE(test_ring_buffer) {
+    Telemetry telemetry;
+
+    for (size_t i = 0; i < Telemetry::kFrameCapacity * 2; ++i) {
+        telemetry.beginFrame();
+        telemetry.setCounter(Telemetry::Draws, static_cast<std::int64_t>(i));
+    }
+    telemetry.beginFrame();
+
+    // One slot holds the frame being recorded
+    BOOST_REQUIRE_EQUAL(telemetry.getFrameCount(),
+                        Telemetry::kFrameCapacity - 1);
+    const auto newest = Telemetry::kFrameCapacity * 2 - 1;
+    BOOST_CHECK_EQUAL(telemetry.getFrame(0).counters[Telemetry::Draws],
+                      newest);
+    BOOST_CHECK_EQUAL(
+        telemetry.getFrame(telemetry.getFrameCount() - 1)
+            .counters[Telemetry::Draws],
+        newest - (Telemetry::kFrameCapacity - 2));
+
+    telemetry.clear();
+    BOOST_CHECK_EQUAL(telemetry.getFrameCount(), 0);
+}
+
+BOOST_AUTO_TEST_CASE(test_dump) {
+    Telemetry telemetry;
+    const auto start = Telemetry::Clock::now();
+
+    for (int i = 0; i < 3; ++i) {
+        telemetry.beginFrame();
+        telemetry.addSample(Telemetry::Draw, start,
+                            start + std::chrono::microseconds(500));
+    }
+    telemetry.beginFrame();
+
+    std::ostringstream csv;
+    telemetry.writeCSV(csv);
+    std::istringstream lines(csv.str());
+    std::string line;
+    std::getline(lines, line);
+    BOOST_CHECK_EQUAL(line.find("frame,start_ms,frame_ms,Physics_ms"), 0);
+    int rows = 0;
+    while (std::getline(lines, line)) {
+        rows++;
+    }
+    BOOST_CHECK_EQUAL(rows, 3);
+
+    std::ostringstream trace;
+    telemetry.writeChromeTrace(trace);
+    const auto json = trace.str();
+    BOOST_CHECK_EQUAL(json.find("{\"traceEvents\":["), 0);
+    BOOST_CHECK_NE(json.find("\"name\":\"Draw\",\"ph\":\"X\""),
+                   std::string::npos);
+    BOOST_CHECK_NE(json.find("\"dur\":500.000"), std::string::npos);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -3,9 +3,13 @@
 #include <fonts/GameTexts.hpp>
 #include <loaders/LoaderGXT.hpp>
 #include <platform/FileHandle.hpp>
+#include <render/TextRenderer.hpp>
+#include <chrono>
+#include <string>
 #include "test_Globals.hpp"
 
 #define T(x) GameStringUtil::fromString(x, FONT_PRICEDOWN)
+#define P(x) GameStringUtil::fromString(x, FONT_PAGER)
 
 BOOST_AUTO_TEST_SUITE(TextTests)
 
@@ -141,4 +145,148 @@ BOOST_AUTO_TEST_CASE(format_remove) {
     BOOST_CHECK_EQUAL(1, st.getText<ScreenTextType::Big>().size());
 }
 
+BOOST_AUTO_TEST_CASE(layout_test) {
+    const auto font =
+        TextRenderer::FontMetrics::forFont(FONT_PAGER, {256u, 256u});
+    TextRenderer::TextInfo ti;
+    ti.font = FONT_PAGER;
+    ti.size = 10.f;
+    ti.baseColour = {255, 255, 255};
+    TextRenderer::TextLayout layout;
+
+    {
+        ti.text = P("Hello");
+        TextRenderer::layoutText(font, ti, false, layout);
+        BOOST_CHECK_EQUAL(layout.vertices.size(), 5 * 6);
+        BOOST_CHECK_EQUAL(layout.size.y, ti.size);
+        BOOST_CHECK_GT(layout.size.x, 0.f);
+    }
+    {
+        // Markup is removed and changes the colour
+        ti.text = P("~r~AB");
+        TextRenderer::layoutText(font, ti, false, layout);
+        BOOST_REQUIRE_EQUAL(layout.vertices.size(), 2 * 6);
+        BOOST_CHECK_CLOSE(layout.vertices[0].colour.r, 113.f / 255.f, 0.1f);
+
+        TextRenderer::layoutText(font, ti, true, layout);
+        BOOST_CHECK_EQUAL(layout.vertices[0].colour.r, 1.f);
+    }
+    {
+        ti.text = P("A\nB");
+        TextRenderer::layoutText(font, ti, false, layout);
+        BOOST_CHECK_EQUAL(layout.vertices.size(), 2 * 6);
+        BOOST_CHECK_EQUAL(layout.size.y, ti.size * 2.f);
+    }
+    {
+        ti.text = P("AAAA BBBB CC");
+        TextRenderer::layoutText(font, ti, false, layout);
+        BOOST_CHECK_EQUAL(layout.size.y, ti.size);
+
+        ti.wrapX = 6;
+        TextRenderer::layoutText(font, ti, false, layout);
+        BOOST_CHECK_EQUAL(layout.size.y, ti.size * 2.f);
+        ti.wrapX = 0;
+    }
+}
+
+BOOST_AUTO_TEST_CASE(layout_cache) {
+    const auto font =
+        TextRenderer::FontMetrics::forFont(FONT_PRICEDOWN, {512u, 512u});
+    TextRenderer::TextInfo ti;
+    ti.font = FONT_PRICEDOWN;
+    ti.size = 20.f;
+    ti.wrapX = 40;
+    ti.text = T("~w~Take the car to the ~y~garage~w~ and get it resprayed "
+                "before the cops catch up with you.");
+    TextRenderer::LayoutCache cache;
+
+    // Text that stays on screen is laid out once
+    const auto& layout = cache.get(font, ti, false);
+    for (int i = 0; i < 10; ++i) {
+        BOOST_CHECK_EQUAL(&cache.get(font, ti, false), &layout);
+        cache.tick();
+    }
+    BOOST_CHECK_EQUAL(cache.getBuildCount(), 1u);
+
+    TextRenderer::TextLayout expected;
+    TextRenderer::layoutText(font, ti, false, expected);
+    BOOST_CHECK_EQUAL(layout.vertices.size(), expected.vertices.size());
+    BOOST_CHECK(layout.size == expected.size);
+
+    // Anything that changes the layout is a new entry
+    ti.baseColour = {255, 0, 0};
+    cache.get(font, ti, false);
+    cache.get(font, ti, true);
+    BOOST_CHECK_EQUAL(cache.getBuildCount(), 3u);
+    BOOST_CHECK_EQUAL(cache.size(), 3u);
+
+    // Layouts are relative to the screen position
+    ti.screenPosition = {100.f, 100.f};
+    cache.get(font, ti, true);
+    BOOST_CHECK_EQUAL(cache.getBuildCount(), 3u);
+}
+
+BOOST_AUTO_TEST_CASE(layout_cache_trim) {
+    const auto font =
+        TextRenderer::FontMetrics::forFont(FONT_PAGER, {512u, 512u});
+    TextRenderer::TextInfo ti;
+    ti.font = FONT_PAGER;
+    ti.size = 10.f;
+    TextRenderer::LayoutCache cache;
+
+    for (size_t i = 0; i <= TextRenderer::LayoutCache::kCapacity; ++i) {
+        ti.text = P(std::to_string(i));
+        cache.get(font, ti, false);
+    }
+
+    // Only the text still on screen survives once the cache is full
+    ti.text = P("0");
+    for (size_t i = 0; i <= TextRenderer::LayoutCache::kLifetime; ++i) {
+        cache.get(font, ti, false);
+        cache.tick();
+    }
+    BOOST_CHECK_EQUAL(cache.size(), 1u);
+    const auto builds = cache.getBuildCount();
+    cache.get(font, ti, false);
+    BOOST_CHECK_EQUAL(cache.getBuildCount(), builds);
+}
+
+BOOST_AUTO_TEST_CASE(layout_benchmark) {
+    constexpr int kIterations = 10000;
+    const auto font =
+        TextRenderer::FontMetrics::forFont(FONT_PRICEDOWN, {512u, 512u});
+    TextRenderer::TextInfo ti;
+    ti.font = FONT_PRICEDOWN;
+    ti.size = 20.f;
+    ti.wrapX = 40;
+    ti.text = T("~w~Take the car to the ~y~garage~w~ and get it resprayed "
+                "before the cops catch up with you.");
+
+    using Clock = std::chrono::steady_clock;
+    using Milliseconds = std::chrono::duration<double, std::milli>;
+
+    // Only reports the times
+    TextRenderer::TextLayout layout;
+    size_t glyphs = 0;
+    auto start = Clock::now();
+    for (int i = 0; i < kIterations; ++i) {
+        TextRenderer::layoutText(font, ti, false, layout);
+        glyphs += layout.vertices.size() / 6;
+    }
+    const Milliseconds uncached = Clock::now() - start;
+
+    TextRenderer::LayoutCache cache;
+    start = Clock::now();
+    for (int i = 0; i < kIterations; ++i) {
+        cache.get(font, ti, false);
+        cache.tick();
+    }
+    const Milliseconds cached = Clock::now() - start;
+
+    BOOST_TEST_MESSAGE("Text layout: " << kIterations << " strings, "
+                                       << glyphs << " glyphs in "
+                                       << uncached.count() << "ms, "
+                                       << cached.count() << "ms cached");
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,109 @@
+#include <boost/test/unit_test.hpp>
+#include <loaders/TextureCache.hpp>
+
+#include <fstream>
+#include <string>
+
+namespace {
+struct CacheDirectory {
+    rwfs::path path;
+
+    CacheDirectory()
+        : path(rwfs::temp_directory_path() / "openrw_texturecache_test") {
+        rwfs::remove_all(path);
+    }
+
+    ~CacheDirectory() {
+        rwfs::error_code ec;
+        rwfs::remove_all(path, ec);
+    }
+};
+
+TextureCache::Archive makeArchive() {
+    std::vector<std::uint8_t> rgba(8 * 4 * 4, 200);
+    TextureCache::Texture texture;
+    texture.name = "wheel";
+    texture.format = BlockCompression::Format::BC3;
+    texture.transparent = true;
+    texture.magFilter = 0x2601;
+    texture.wrapS = 0x2901;
+    texture.wrapT = 0x812F;
+    texture.levels = BlockCompression::encodeMipChain(
+        texture.format, rgba.data(), 8, 4);
+    return {texture};
+}
+}  // namespace
+
+BOOST_AUTO_TEST_SUITE(TextureCacheTests)
+
+BOOST_AUTO_TEST_CASE(test_hash) {
+    const std::string a = "texture data";
+    const std::string b = "texture date";
+    BOOST_CHECK_EQUAL(TextureCache::hash(a.data(), a.size()),
+                      TextureCache::hash(a.data(), a.size()));
+    BOOST_CHECK_NE(TextureCache::hash(a.data(), a.size()),
+                   TextureCache::hash(b.data(), b.size()));
+}
+
+BOOST_AUTO_TEST_CASE(test_round_trip) {
+    CacheDirectory directory;
+    TextureCache cache(directory.path);
+    const auto archive = makeArchive();
+
+    TextureCache::Archive loaded;
+    BOOST_CHECK(!cache.load("Generic", 1234, loaded));
+    BOOST_REQUIRE(cache.store("Generic", 1234, archive));
+    BOOST_REQUIRE(cache.load("Generic", 1234, loaded));
+
+    BOOST_REQUIRE_EQUAL(loaded.size(), 1u);
+    const auto& texture = loaded[0];
+    BOOST_CHECK_EQUAL(texture.name, "wheel");
+    BOOST_CHECK(texture.format == BlockCompression::Format::BC3);
+    BOOST_CHECK(texture.transparent);
+    BOOST_CHECK_EQUAL(texture.magFilter, 0x2601u);
+    BOOST_CHECK_EQUAL(texture.wrapS, 0x2901u);
+    BOOST_CHECK_EQUAL(texture.wrapT, 0x812Fu);
+    BOOST_REQUIRE_EQUAL(texture.levels.size(), archive[0].levels.size());
+    for (size_t i = 0; i < texture.levels.size(); ++i) {
+        BOOST_CHECK_EQUAL(texture.levels[i].width, archive[0].levels[i].width);
+        BOOST_CHECK_EQUAL(texture.levels[i].height,
+                          archive[0].levels[i].height);
+        BOOST_CHECK(texture.levels[i].data == archive[0].levels[i].data);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(test_changed_contents) {
+    CacheDirectory directory;
+    TextureCache cache(directory.path);
+    BOOST_REQUIRE(cache.store("generic", 1, makeArchive()));
+
+    TextureCache::Archive loaded;
+    BOOST_CHECK(!cache.load("generic", 2, loaded));
+
+    // Storing the new contents removes the old file
+    BOOST_REQUIRE(cache.store("generic", 2, makeArchive()));
+    BOOST_CHECK(cache.load("generic", 2, loaded));
+    BOOST_CHECK(!rwfs::exists(cache.getPath("generic", 1)));
+}
+
+BOOST_AUTO_TEST_CASE(test_damaged_file) {
+    CacheDirectory directory;
+    TextureCache cache(directory.path);
+    BOOST_REQUIRE(cache.store("generic", 1, makeArchive()));
+
+    // Cut the file short
+    const auto path = cache.getPath("generic", 1);
+    rwfs::resize_file(path, rwfs::file_size(path) - 10);
+
+    TextureCache::Archive loaded;
+    BOOST_CHECK(!cache.load("generic", 1, loaded));
+    BOOST_CHECK(loaded.empty());
+
+    {
+        std::ofstream out(path.string(), std::ios::binary);
+        out << "not a texture cache";
+    }
+    BOOST_CHECK(!cache.load("generic", 1, loaded));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -1,6 +1,13 @@
 #include <boost/test/unit_test.hpp>
+#include <BulletCollision/CollisionDispatch/btCollisionDispatcherMt.h>
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
+#include <glm/gtc/constants.hpp>
 #include <data/Clump.hpp>
 #include <objects/VehicleObject.hpp>
+#include <render/ViewCamera.hpp>
 #include "test_Globals.hpp"
 
 BOOST_AUTO_TEST_SUITE(VehicleTests, DATA_TEST_PREDICATE)
@@ -130,4 +137,214 @@ BOOST_AUTO_TEST_CASE(test_open_part) {
     Global::get().e->destroyObject(vehicle);
 }
 
+BOOST_AUTO_TEST_CASE(test_kinematic_vehicle) {
+    VehicleObject* vehicle = Global::get().e->createVehicle(
+        90u, glm::vec3(10.f, 0.f, 5.f), glm::quat{1.0f, 0.0f, 0.0f, 0.0f});
+    BOOST_REQUIRE(vehicle);
+
+    vehicle->setKinematic(true);
+    BOOST_CHECK(vehicle->isKinematic());
+
+    // Drive along +X at 5 m/s, keeping the height above the target
+    vehicle->setKinematicTarget(glm::vec3(30.f, 0.f, 0.f), 5.f);
+    vehicle->tickPhysics(1.f);
+    BOOST_CHECK_CLOSE(vehicle->getPosition().x, 15.f, 0.1f);
+    BOOST_CHECK_CLOSE(vehicle->getPosition().z, 5.f, 0.1f);
+    BOOST_CHECK_GT(vehicle->isInFront(glm::vec3(30.f, 0.f, 5.f)), 0.f);
+    BOOST_CHECK_CLOSE(vehicle->getVelocity(), 5.f, 0.1f);
+
+    // Stops at the target
+    vehicle->tickPhysics(10.f);
+    BOOST_CHECK_CLOSE(vehicle->getPosition().x, 30.f, 0.1f);
+
+    vehicle->setKinematic(false);
+    BOOST_CHECK(!vehicle->isKinematic());
+
+    Global::get().e->destroyObject(vehicle);
+}
+
+namespace {
+/**
+ * A ground plane, so that there is something to land on
+ */
+struct Ground {
+    GameWorld& world;
+    btStaticPlaneShape shape{btVector3(0.f, 0.f, 1.f), 0.f};
+    btCollisionObject object;
+
+    explicit Ground(GameWorld& world) : world(world) {
+        object.setCollisionShape(&shape);
+        world.dynamicsWorld->addCollisionObject(
+            &object, btBroadphaseProxy::StaticFilter,
+            btBroadphaseProxy::AllFilter);
+    }
+
+    ~Ground() {
+        world.dynamicsWorld->removeCollisionObject(&object);
+    }
+};
+
+/**
+ * Two layers of vehicles. The top one is upside down and drops onto the
+ * bottom one, so the bodies hit each other rather than the wheels.
+ */
+void spawnVehicleStack(GameWorld& world, int count) {
+    constexpr int kGridSize = 10;
+    const int layer = count / 2;
+    const auto upsideDown =
+        glm::angleAxis(glm::pi<float>(), glm::vec3(1.f, 0.f, 0.f));
+    for (int i = 0; i < count; ++i) {
+        const int cell = i % layer;
+        glm::vec3 position(static_cast<float>(cell % kGridSize) * 6.f,
+                           static_cast<float>(cell / kGridSize) * 8.f,
+                           i < layer ? 1.5f : 5.f);
+        BOOST_REQUIRE(i < layer
+                          ? world.createVehicle(90u, position)
+                          : world.createVehicle(90u, position, upsideDown));
+    }
+}
+
+std::atomic<int> contactCallbacks{0};
+
+bool countContact(btManifoldPoint& mp, void* body0, void* body1) {
+    ++contactCallbacks;
+    return GameWorld::ContactProcessedCallback(mp, body0, body1);
+}
+
+std::vector<std::thread::id> tickThreads;
+size_t queuedDamage = 0;
+
+void recordTick(btDynamicsWorld* physWorld, btScalar timeStep) {
+    auto world = static_cast<GameWorld*>(physWorld->getWorldUserInfo());
+    tickThreads.push_back(std::this_thread::get_id());
+    queuedDamage += world->contactDamage.size();
+    GameWorld::PhysicsTickCallback(physWorld, timeStep);
+}
+}  // namespace
+
+BOOST_AUTO_TEST_CASE(test_vehicle_stress) {
+    constexpr int kVehicles = 200;
+    constexpr int kSteps = 300;
+
+    // Only reports the times
+    for (bool threaded : {false, true}) {
+        WorldFixture fixture(threaded);
+        auto& world = fixture.world;
+        Ground ground(world);
+        spawnVehicleStack(world, kVehicles);
+
+        const auto start = std::chrono::steady_clock::now();
+        for (int step = 0; step < kSteps; ++step) {
+            world.dynamicsWorld->stepSimulation(1.f / 60.f, 1, 1.f / 60.f);
+        }
+        const auto duration = std::chrono::duration<double, std::milli>(
+            std::chrono::steady_clock::now() - start);
+
+        BOOST_TEST_MESSAGE((world.isThreaded() ? "Threaded: "
+                                               : "Single threaded: ")
+                           << kVehicles << " vehicles, " << kSteps
+                           << " steps, " << duration.count() / kSteps
+                           << " ms per step");
+    }
+}
+
+BOOST_AUTO_TEST_CASE(test_threaded_contact_callbacks) {
+    WorldFixture fixture(true);
+    auto& world = fixture.world;
+    if (!world.isThreaded()) {
+        BOOST_TEST_MESSAGE("Bullet was built without threading, skipping");
+        return;
+    }
+    BOOST_CHECK(dynamic_cast<btCollisionDispatcherMt*>(
+        world.collisionDispatcher.get()));
+
+    Ground ground(world);
+    spawnVehicleStack(world, 40);
+
+    contactCallbacks = 0;
+    tickThreads.clear();
+    queuedDamage = 0;
+    gContactProcessedCallback = countContact;
+    world.dynamicsWorld->setInternalTickCallback(recordTick, &world);
+
+    bool drained = true;
+    for (int step = 0; step < 120; ++step) {
+        world.dynamicsWorld->stepSimulation(1.f / 60.f, 1, 1.f / 60.f);
+        drained = drained && world.contactDamage.empty();
+    }
+    gContactProcessedCallback = GameWorld::ContactProcessedCallback;
+
+    // Contacts found by the dispatcher's workers queue their damage, the
+    // tick callback applies it on this thread after every substep
+    BOOST_CHECK_GT(contactCallbacks.load(), 0);
+    BOOST_CHECK_GT(queuedDamage, 0u);
+    BOOST_CHECK(drained);
+    BOOST_REQUIRE_EQUAL(tickThreads.size(), 120u);
+    for (const auto& thread : tickThreads) {
+        BOOST_CHECK(thread == std::this_thread::get_id());
+    }
+}
+
+namespace {
+void testSimulationLOD(GameWorld& world) {
+    constexpr int kVehicles = 20;
+    constexpr float kSpacing = 10.f;
+    world.simulationLODDistance = 80.f;
+
+    // A line of traffic along X, and a mission vehicle at the far end
+    std::vector<VehicleObject*> traffic;
+    for (int i = 0; i < kVehicles; ++i) {
+        auto vehicle = world.createVehicle(
+            90u, glm::vec3(static_cast<float>(i) * kSpacing, 0.f, 2.f));
+        BOOST_REQUIRE(vehicle);
+        vehicle->setLifetime(GameObject::TrafficLifetime);
+        traffic.push_back(vehicle);
+    }
+    auto mission = world.createVehicle(90u, glm::vec3(0.f, 200.f, 2.f));
+    BOOST_REQUIRE(mission);
+
+    // The default frustum contains everything, only the distance matters
+    ViewCamera focus(glm::vec3(0.f, 0.f, 2.f));
+    world.updateSimulationLOD(focus);
+    for (int i = 0; i < kVehicles; ++i) {
+        BOOST_CHECK_EQUAL(traffic[i]->isKinematic(), i * kSpacing > 80.f);
+    }
+    BOOST_CHECK(!mission->isKinematic());
+
+    for (int step = 0; step < 60; ++step) {
+        world.dynamicsWorld->stepSimulation(1.f / 60.f, 1, 1.f / 60.f);
+    }
+
+    // From the other end, vehicles switch back once they are inside the
+    // distance by the margin
+    focus.position = glm::vec3(190.f, 0.f, 2.f);
+    world.updateSimulationLOD(focus);
+    for (int i = 0; i <= 10; ++i) {
+        BOOST_CHECK(traffic[i]->isKinematic());
+    }
+    // Exactly at the distance, but not inside it by the margin yet
+    BOOST_CHECK(traffic[11]->isKinematic());
+    for (int i = 12; i < kVehicles; ++i) {
+        BOOST_CHECK(!traffic[i]->isKinematic());
+    }
+    BOOST_CHECK(!mission->isKinematic());
+
+    for (int step = 0; step < 60; ++step) {
+        world.dynamicsWorld->stepSimulation(1.f / 60.f, 1, 1.f / 60.f);
+    }
+    BOOST_CHECK_EQUAL(world.vehiclePool.objects.size(),
+                      static_cast<size_t>(kVehicles + 1));
+}
+}  // namespace
+
+BOOST_FIXTURE_TEST_CASE(test_simulation_lod, WorldFixture) {
+    testSimulationLOD(world);
+
+    // The same with the physics stepped on several threads
+    GameState threadedState;
+    GameWorld threaded(&Global::get().log, Global::get().d, true);
+    threaded.state = &threadedState;
+    testSimulationLOD(threaded);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
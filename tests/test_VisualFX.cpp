@@ -9,4 +9,36 @@ BOOST_AUTO_TEST_CASE(test_light_data) {
     BOOST_CHECK_EQUAL(fx->getType(), Light);
 }
 
+BOOST_AUTO_TEST_CASE(test_particle_pool) {
+    ParticlePool pool;
+
+    auto& forever = pool.create();
+    auto& shortLived = pool.create();
+    shortLived.starttime = 1.f;
+    shortLived.lifetime = 2.f;
+    auto& longLived = pool.create();
+    longLived.starttime = 1.f;
+    longLived.lifetime = 10.f;
+
+    BOOST_CHECK_EQUAL(pool.getParticles().size(), 3u);
+    BOOST_CHECK_EQUAL(pool.removeExpired(2.f), 0u);
+    BOOST_CHECK_EQUAL(pool.removeExpired(3.f), 1u);
+
+    // The survivors keep their order
+    const auto& live = pool.getParticles();
+    BOOST_REQUIRE_EQUAL(live.size(), 2u);
+    BOOST_CHECK_EQUAL(live[0], &forever);
+    BOOST_CHECK_EQUAL(live[1], &longLived);
+
+    // Freed slots are reused, and come back reset
+    auto& reused = pool.create();
+    BOOST_CHECK_EQUAL(&reused, &shortLived);
+    BOOST_CHECK_EQUAL(reused.lifetime, -1.f);
+
+    pool.destroy(forever);
+    BOOST_CHECK_EQUAL(pool.getParticles().size(), 2u);
+    BOOST_CHECK_EQUAL(pool.removeExpired(100.f), 1u);
+    BOOST_CHECK_EQUAL(pool.getParticles().size(), 1u);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -1,8 +1,12 @@
 #include <boost/test/unit_test.hpp>
 #include <data/WeaponData.hpp>
+#include <dynamics/AreaDamage.hpp>
+#include <dynamics/CollisionInstance.hpp>
+#include <engine/GameWorld.hpp>
 #include <items/Weapon.hpp>
 #include <objects/CharacterObject.hpp>
 #include <objects/ProjectileObject.hpp>
+#include <objects/VehicleObject.hpp>
 #include "test_Globals.hpp"
 
 auto& operator<<(std::ostream& s, const ScanType& type) {
@@ -52,6 +56,96 @@ BOOST_AUTO_TEST_CASE(TestDoWeaponScan, DATA_TEST_PREDICATE) {
     }
 }
 
+BOOST_AUTO_TEST_CASE(TestAreaDamage, DATA_TEST_PREDICATE) {
+    {
+        auto world = Global::get().e;
+        auto source = world->createPedestrian(1, {50.f, 0.f, 0.f});
+        auto inside = world->createPedestrian(1, {52.f, 0.f, 0.f});
+        auto outside = world->createPedestrian(1, {59.f, 0.f, 0.f});
+        BOOST_REQUIRE(source && inside && outside);
+
+        // The last ped is only in range of the second explosion
+        AreaDamage::Request request{
+            GameObject::DamageInfo::DamageType::Explosion,
+            {50.f, 0.f, 0.f}, 5.f, 10.f, source};
+        request.falloff = true;
+        world->areaDamage.queue(request);
+        request.center = {55.f, 0.f, 0.f};
+        world->areaDamage.queue(request);
+        BOOST_CHECK_EQUAL(world->areaDamage.getQueuedCount(), 2);
+
+        // Nothing is damaged until the queue is applied
+        BOOST_CHECK_EQUAL(inside->getCurrentState().health, 100.f);
+
+        BOOST_CHECK_EQUAL(world->areaDamage.apply(
+                              *world->dynamicsWorld,
+                              world->pedestrianPool.updateList),
+                          3);
+        BOOST_CHECK_EQUAL(world->areaDamage.getQueuedCount(), 0);
+
+        BOOST_CHECK_EQUAL(source->getCurrentState().health, 100.f);
+        BOOST_CHECK_LT(inside->getCurrentState().health, 100.f);
+        BOOST_CHECK_LT(outside->getCurrentState().health, 100.f);
+
+        world->destroyObject(source);
+        world->destroyObject(inside);
+        world->destroyObject(outside);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(TestAreaDamageWithoutBody, DATA_TEST_PREDICATE) {
+    {
+        // e.g. characters sitting in a vehicle
+        auto world = Global::get().e;
+        auto character = world->createPedestrian(1, {50.f, 0.f, 0.f});
+        BOOST_REQUIRE(character != nullptr);
+        character->destroyActor();
+        BOOST_REQUIRE(character->physObject == nullptr);
+
+        world->areaDamage.queue({GameObject::DamageInfo::DamageType::Melee,
+                                 {50.5f, 0.f, 0.f}, 1.f, 10.f, nullptr});
+        world->applyAreaDamage();
+        BOOST_CHECK_LT(character->getCurrentState().health, 100.f);
+
+        world->destroyObject(character);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(TestAreaDamageSphere, DATA_TEST_PREDICATE) {
+    {
+        auto world = Global::get().e;
+        auto vehicle = world->createVehicle(90u, {50.f, 0.f, 0.f});
+        BOOST_REQUIRE(vehicle != nullptr);
+
+        btVector3 min, max;
+        vehicle->collision->getBulletBody()->getAabb(min, max);
+        const float radius = 1.f;
+        const float z = (min.z() + max.z()) / 2.f;
+
+        // The query box overlaps the vehicle's, but the sphere doesn't reach
+        // the corner
+        const glm::vec3 corner{max.x() + radius * 0.8f,
+                               max.y() + radius * 0.8f, z};
+        world->areaDamage.queue({GameObject::DamageInfo::DamageType::Melee,
+                                 corner, radius, 0.f, nullptr});
+        BOOST_CHECK_EQUAL(world->areaDamage.apply(
+                              *world->dynamicsWorld,
+                              world->pedestrianPool.updateList),
+                          0);
+
+        const glm::vec3 side{max.x() + radius * 0.5f, (min.y() + max.y()) / 2.f,
+                             z};
+        world->areaDamage.queue({GameObject::DamageInfo::DamageType::Melee,
+                                 side, radius, 0.f, nullptr});
+        BOOST_CHECK_EQUAL(world->areaDamage.apply(
+                              *world->dynamicsWorld,
+                              world->pedestrianPool.updateList),
+                          1);
+
+        world->destroyObject(vehicle);
+    }
+}
+
 BOOST_AUTO_TEST_CASE(TestProjectile, DATA_TEST_PREDICATE) {
     {
         auto character = Global::get().e->createPedestrian(1, {25.f, 0.f, 0.f});
@@ -71,6 +165,7 @@ BOOST_AUTO_TEST_CASE(TestProjectile, DATA_TEST_PREDICATE) {
             Global::get().e->dynamicsWorld->stepSimulation(0.016f, 0, 0);
             projectile->tick(0.016f);
         }
+        Global::get().e->applyAreaDamage();
 
         BOOST_CHECK_LT(
             glm::distance(character->getPosition(), projectile->getPosition()),
@@ -104,6 +199,7 @@ BOOST_AUTO_TEST_CASE(TestProjectile, DATA_TEST_PREDICATE) {
             Global::get().e->dynamicsWorld->stepSimulation(0.016f, 0, 0);
             projectile->tick(0.016f);
         }
+        Global::get().e->applyAreaDamage();
 
         BOOST_CHECK(projectile->getPosition().z < 10.f);
         BOOST_CHECK(projectile->getPosition().z > 0.f);
@@ -131,6 +227,7 @@ BOOST_AUTO_TEST_CASE(TestProjectile, DATA_TEST_PREDICATE) {
             Global::get().e->dynamicsWorld->stepSimulation(0.016f, 0, 0);
             projectile->tick(0.016f);
         }
+        Global::get().e->applyAreaDamage();
 
         BOOST_CHECK(projectile->getPosition().z < 10.f);
 
@@ -0,0 +1,105 @@
+#include <boost/test/unit_test.hpp>
+#include <engine/GameState.hpp>
+#include <engine/GameWorld.hpp>
+#include <engine/WorldSnapshot.hpp>
+#include <objects/CharacterObject.hpp>
+#include <objects/InstanceObject.hpp>
+#include <objects/VehicleObject.hpp>
+#include <script/SCMFile.hpp>
+#include <script/ScriptMachine.hpp>
+#include "test_Globals.hpp"
+
+namespace {
+SCMByte scmData[] = {
+    0x02, 0x00, 0x01, 0x08, 0x00, 0x00, 0x00, 0x00, 0x02, 0x00, 0x01, 0x18,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x02, 0x00, 0x01, 0x28, 0x00, 0x00, 0x00, 0x00, 0x08, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00};
+}
+
+BOOST_AUTO_TEST_SUITE(WorldSnapshotTests, DATA_TEST_PREDICATE)
+
+BOOST_FIXTURE_TEST_CASE(test_restore, WorldFixture) {
+    SCMFile file;
+    file.loadFile(scmData, sizeof(scmData));
+    ScriptMachine machine(&state, file, nullptr);
+    state.world = &world;
+    state.script = &machine;
+
+    auto& globals = machine.getGlobalData();
+    BOOST_REQUIRE(!globals.empty());
+    globals[0] = 1;
+    machine.startThread(0);
+    state.playerInfo.money = 100;
+    state.scriptOnMissionFlag = reinterpret_cast<ScriptInt*>(globals.data());
+    state.scriptTimerVariable = reinterpret_cast<ScriptInt*>(
+        machine.getThreads().front().locals.data() + 4);
+
+    auto player = world.createPlayer(glm::vec3(10.f, 10.f, 0.f));
+    BOOST_REQUIRE(player);
+    state.playerObject = player->getGameObjectID();
+    auto vehicle = world.createVehicle(90, glm::vec3(20.f, 0.f, 0.f));
+    auto traffic = world.createVehicle(90, glm::vec3(40.f, 0.f, 0.f));
+    auto instance = world.createInstance(1337, glm::vec3(100.f, 0.f, 0.f));
+    BOOST_REQUIRE(vehicle && traffic && instance);
+    vehicle->setLifetime(GameObject::MissionLifetime);
+    traffic->setLifetime(GameObject::TrafficLifetime);
+    BOOST_REQUIRE(player->enterVehicle(vehicle, 0));
+    state.missionObjects.push_back(vehicle);
+
+    const auto vehicleID = vehicle->getGameObjectID();
+    const auto trafficID = traffic->getGameObjectID();
+
+    WorldSnapshot snapshot;
+    BOOST_CHECK(!snapshot.restore(state));
+    snapshot.capture(state);
+    BOOST_CHECK(snapshot.isCaptured());
+
+    // Fail the mission
+    globals[0] = 2;
+    machine.startThread(0, true);
+    machine.getThreads().pop_front();
+    state.playerInfo.money = 0;
+    vehicle->setOccupant(0, nullptr);
+    player->setCurrentVehicle(nullptr, 0);
+    player->SetDead();
+    world.destroyObject(vehicle);
+    instance->setPosition(glm::vec3(0.f, 0.f, 0.f));
+    auto extra = world.createInstance(1100, glm::vec3(0.f, 0.f, 0.f));
+    BOOST_REQUIRE(extra);
+    const auto extraID = extra->getGameObjectID();
+
+    BOOST_REQUIRE(snapshot.restore(state));
+
+    BOOST_CHECK(state.world == &world);
+    BOOST_CHECK(state.script == &machine);
+    BOOST_CHECK_EQUAL(state.playerInfo.money, 100);
+    BOOST_CHECK_EQUAL(globals[0], 1);
+    BOOST_CHECK_EQUAL(machine.getThreads().size(), 1);
+
+    // Script variables point into the restored memory, not the old thread
+    BOOST_CHECK_EQUAL(static_cast<void*>(state.scriptOnMissionFlag),
+                      static_cast<void*>(globals.data()));
+    BOOST_CHECK_EQUAL(static_cast<void*>(state.scriptTimerVariable),
+                      static_cast<void*>(
+                          machine.getThreads().front().locals.data() + 4));
+
+    // The mission vehicle comes back under the same ID, traffic doesn't
+    auto restored =
+        static_cast<VehicleObject*>(world.vehiclePool.find(vehicleID));
+    BOOST_REQUIRE(restored);
+    BOOST_CHECK_EQUAL(restored->getPosition(), glm::vec3(20.f, 0.f, 0.f));
+    BOOST_CHECK(world.vehiclePool.find(trafficID) == nullptr);
+    BOOST_REQUIRE_EQUAL(state.missionObjects.size(), 1);
+    BOOST_CHECK_EQUAL(state.missionObjects[0], restored);
+
+    BOOST_CHECK(player->isAlive());
+    BOOST_CHECK_EQUAL(player->getCurrentVehicle(), restored);
+    BOOST_CHECK_EQUAL(restored->getOccupant(0), player);
+
+    BOOST_CHECK_EQUAL(instance->getPosition(),
+                      glm::vec3(100.f, 0.f, 0.f));
+    BOOST_CHECK(world.instancePool.find(extraID) == nullptr);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
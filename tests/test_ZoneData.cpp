@@ -1,5 +1,8 @@
 #include <boost/test/unit_test.hpp>
 #include <data/ZoneData.hpp>
+#include <data/ZoneGrid.hpp>
+#include <engine/GameData.hpp>
+#include <random>
 #include "test_Globals.hpp"
 
 BOOST_AUTO_TEST_SUITE(ZoneDataTests)
@@ -30,4 +33,112 @@ BOOST_AUTO_TEST_CASE(test_hierarchy) {
     BOOST_CHECK_EQUAL(zone.findLeafAtPoint({ 5.f, 5.f, 0.f}), &leaf);
 
 }
+
+namespace {
+ZoneDataList makeZones(size_t count, unsigned int seed) {
+    std::mt19937 rng(seed);
+    std::uniform_real_distribution<float> position(-1000.f, 900.f);
+    std::uniform_real_distribution<float> size(10.f, 400.f);
+    std::uniform_real_distribution<float> height(-50.f, 50.f);
+
+    ZoneDataList zones;
+    zones.reserve(count + 1);
+    zones.emplace_back("ROOT", 0, glm::vec3(-1000.f, -1000.f, -100.f),
+                       glm::vec3(1000.f, 1000.f, 100.f), 0, 0, 0);
+    for (size_t i = 0; i < count; ++i) {
+        glm::vec3 min(position(rng), position(rng), height(rng));
+        glm::vec3 max = min + glm::vec3(size(rng), size(rng), 40.f);
+        zones.emplace_back("ZONE", 0, min, glm::min(max, zones[0].max), 0, 0,
+                           0);
+    }
+    return zones;
+}
+
+void insertZones(ZoneDataList& zones, size_t first) {
+    for (size_t i = first; i < zones.size(); ++i) {
+        zones[0].insertZone(zones[i]);
+    }
+}
+
+void checkMatchesTree(ZoneData& root, const ZoneGrid& grid) {
+    size_t mismatches = 0;
+    for (float x = -1010.f; x <= 1010.f; x += 7.3f) {
+        for (float y = -1010.f; y <= 1010.f; y += 7.3f) {
+            for (float z : {-60.f, 0.f, 30.f}) {
+                const glm::vec3 point(x, y, z);
+                if (grid.findLeafAtPoint(point) !=
+                    root.findLeafAtPoint(point)) {
+                    mismatches++;
+                }
+            }
+        }
+    }
+    BOOST_CHECK_EQUAL(mismatches, 0);
+}
+}  // namespace
+
+BOOST_AUTO_TEST_CASE(test_grid_matches_tree) {
+    auto zones = makeZones(200, 1);
+    insertZones(zones, 1);
+
+    ZoneGrid grid;
+    grid.build(zones[0]);
+    checkMatchesTree(zones[0], grid);
+
+    // Zone edges are inclusive, like containsPoint
+    BOOST_CHECK_EQUAL(grid.findLeafAtPoint(zones[0].max), &zones[0]);
+    BOOST_CHECK(grid.findLeafAtPoint({2000.f, 0.f, 0.f}) == nullptr);
+}
+
+BOOST_AUTO_TEST_CASE(test_grid_update) {
+    auto zones = makeZones(200, 2);
+    const size_t loaded = 150;
+    // Keep the zones in place so the grid can be updated
+    auto added = ZoneDataList(zones.begin() + loaded, zones.end());
+    zones.resize(loaded);
+    insertZones(zones, 1);
+
+    ZoneGrid grid;
+    grid.build(zones[0]);
+
+    glm::vec2 min(added[0].min);
+    glm::vec2 max(added[0].max);
+    for (const auto& zone : added) {
+        BOOST_REQUIRE_LT(zones.size(), zones.capacity());
+        zones.push_back(zone);
+        min = glm::min(min, glm::vec2(zone.min));
+        max = glm::max(max, glm::vec2(zone.max));
+    }
+    insertZones(zones, loaded);
+    grid.update(min, max);
+
+    checkMatchesTree(zones[0], grid);
+}
+
+BOOST_AUTO_TEST_CASE(test_grid_matches_game_zones, DATA_TEST_PREDICATE) {
+    auto data = Global::get().e->data;
+    auto& root = data->gamezones[0];
+    BOOST_REQUIRE_EQUAL(data->zoneGrid.getRoot(), &root);
+
+    size_t mismatches = 0;
+    size_t candidates = 0;
+    size_t samples = 0;
+    for (float x = -4000.f; x <= 4000.f; x += 25.f) {
+        for (float y = -4000.f; y <= 4000.f; y += 25.f) {
+            for (float z : {-10.f, 10.f, 60.f}) {
+                const glm::vec3 point(x, y, z);
+                if (data->findZoneAt(point) != root.findLeafAtPoint(point)) {
+                    mismatches++;
+                }
+                candidates += data->zoneGrid.getCandidateCount(point);
+                samples++;
+            }
+        }
+    }
+    BOOST_CHECK_EQUAL(mismatches, 0);
+    BOOST_TEST_MESSAGE("Zones per lookup: "
+                       << static_cast<float>(candidates) / samples << " of "
+                       << data->gamezones.size());
+}
+
 BOOST_AUTO_TEST_SUITE_END()